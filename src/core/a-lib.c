@@ -981,6 +981,7 @@ RL_API int RL_Set_Value(REBSER *series, u32 index, RXIARG val, int type)
 		Append_Val(series, &value);
 		return TRUE;
 	}
+	GC_BARRIER(series);
 	*BLK_SKIP(series, index) = value;
 	return FALSE;
 }
@@ -1047,6 +1048,7 @@ RL_API int RL_Set_Field(REBSER *obj, u32 word, RXIARG val, int type)
 	//REBVAL value = {0};
 	if (!(word = Find_Word_Index(obj, word, FALSE))) return 0;
 	if (VAL_PROTECTED(FRM_WORDS(obj)+word)) return 0; //	Trap1(RE_LOCKED_WORD, word);
+	GC_BARRIER(obj);
 	RXI_To_Value(FRM_VALUES(obj)+word, val, type);
 	return type;
 }
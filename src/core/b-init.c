@@ -359,6 +359,7 @@ extern const REBYTE Str_Banner[];
 	REBVAL *spec = D_ARG(1);
 
 	SET_OBJECT(ds, Make_Object(0, VAL_BLK(spec)));
+	GC_BARRIER(VAL_SERIES(spec));
 	Bind_Block(VAL_OBJ_FRAME(ds), VAL_BLK(spec), D_REF(2)?BIND_ONLY:BIND_DEEP); // not deep
 	Do_Blk(VAL_SERIES(spec), 0); // result ignored
 	return R_RET;
@@ -778,6 +779,9 @@ extern const REBYTE Str_Banner[];
 #ifdef INCLUDE_WAV_CODEC
 	Init_WAV_Codec();
 #endif
+#ifdef INCLUDE_JSON_CODEC
+	Init_JSON_Codec();
+#endif
 #ifdef INCLUDE_REBIN_CODEC
 	Init_REBIN_Codec();
 #endif
@@ -959,11 +963,14 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 	// Thread locals:
 	Trace_Level = 0;
 	Saved_State = 0;
+	Halt_State = 0;
 
 	Eval_Cycles = 0;
 	Eval_Dose = EVAL_DOSE;
-	Eval_Signals = 0;
-	Eval_Sigmask = ALL_BITS;
+	Eval_Limit = 0;
+	// Eval_Signals are shared, escape is handled by the main task only:
+	Eval_Sigmask = ALL_BITS & ~FLAGIT(SIG_ESCAPE);
+	Task_Signals = 0;
 
 	// errors? problem with PG_Boot_Phase shared?
 
@@ -977,6 +984,22 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 	Init_Mold(MIN_COMMON/4);
 	Init_Frame();
 	//Inspect_Series(0);
+	GC_Active = TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	void Dispose_Task(void)
+/*
+**		Release all memory of an ended task. Its pool segments
+**		are handed back to be reused by other tasks.
+**
+***********************************************************************/
+{
+	Dispose_Sampler();
+	Dispose_Memory();
+	Release_Pools();
 }
 
 
@@ -1026,6 +1049,7 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 	Eval_Dose = EVAL_DOSE;
 	Eval_Limit = 0;
 	Eval_Signals = 0;
+	Task_Signals = 0;
 	Eval_Sigmask = ALL_BITS; /// dups Init_Task
 
 	Init_StdIO();
@@ -1035,6 +1059,9 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 
 	DOUT("Level 0");
 	Init_Memory(0);			// Memory allocator
+#ifdef INCLUDE_TASK
+	PG_Task_Lock = OS_Make_Lock(); // Guards data shared with sub-tasks
+#endif
 	Init_Root_Context();	// Special REBOL values per program
 	Init_Task_Context();	// Special REBOL values per task
 
@@ -1122,6 +1149,11 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 	if(!Task_Series)
 		return; // can happen when close button, shutdown, etc.
 
+	// Sub-tasks use the shared state, so it is released only after they ended:
+	if (!Stop_Tasks(5000)) return;
+
+	Dispose_Sampler(); // stop the sampling timer before anything is released
+
 #ifdef DEBUG
 	// Turn off watching memory (not possible after releasing output buffers)
 	Reb_Opts->watch_alloc = 0;
@@ -1168,6 +1200,10 @@ static void Set_Option_File(REBCNT field, REBYTE* src, REBOOL dir )
 	}
 	Dispose_StdIO();
 	Dispose_Pools();
+#ifdef INCLUDE_TASK
+	OS_Free_Lock(PG_Task_Lock);
+	PG_Task_Lock = 0;
+#endif
 	Free_Mem(PG_Reb_Stats, sizeof(*PG_Reb_Stats));
 	Free_Mem(Reb_Opts, sizeof(*Reb_Opts));
 #if defined(DEBUG) || defined(_DEBUG)
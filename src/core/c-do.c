@@ -38,6 +38,16 @@
 REBNATIVE(do);  // Forward declaration for detection and special cases
 #define IS_DO(v) (IS_NATIVE(v) && (VAL_FUNC_CODE(v) == &N_do))
 
+// Natives which only evaluate their block args (see Only_Evaluates):
+REBNATIVE(if); REBNATIVE(either); REBNATIVE(unless); REBNATIVE(case); REBNATIVE(switch);
+REBNATIVE(any); REBNATIVE(all); REBNATIVE(attempt); REBNATIVE(try); REBNATIVE(catch);
+REBNATIVE(loop); REBNATIVE(while); REBNATIVE(until); REBNATIVE(forever);
+
+// Value of a shared closure body which is copied or rebound when used (see Do_Closure):
+#define IS_RELATIVE(v) ((ANY_WORD(v) && VAL_WORD_INDEX(v) < 0) \
+		|| (TYPESET(VAL_TYPE(v)) & TS_DEEP_COPIED))
+#define SPECIFY_VALUE(b, v) if (SERIES_GET_FLAG(b, SER_REL) && IS_RELATIVE(v)) Specify_Closure_Value(v)
+
 enum Eval_Types {
 	ET_INVALID,		// not valid to evaluate
 	ET_WORD,
@@ -71,6 +81,21 @@ void Do_Rebcode(REBVAL *v) {;}
 #define PUSH_FUNC(v, w, s)
 #define PUSH_BLOCK(b)
 
+/***********************************************************************
+**
+*/	static void Path_Barrier(REBVAL *value)
+/*
+**		GC write barrier for a value set into an object or block
+**		by a SET-PATH (the value is the path's parent).
+**
+***********************************************************************/
+{
+#ifdef USE_GENERATIONAL_GC
+	if (ANY_OBJECT(value)) GC_BARRIER(VAL_OBJ_FRAME(value));
+	else if (ANY_BLOCK(value) || IS_MAP(value)) GC_BARRIER(VAL_SERIES(value));
+#endif
+}
+
 static REBVAL *Func_Word(REBINT dsf)
 {
 	return DSF_WORD(dsf);
@@ -373,6 +398,7 @@ void Trace_Arg(REBINT num, REBVAL *arg, REBVAL *path)
 ***********************************************************************/
 {
 	REBVAL *path;
+	REBVAL *parent;
 	REBPEF func;
 
 	// Path must have dispatcher, else return:
@@ -418,11 +444,13 @@ void Trace_Arg(REBINT num, REBVAL *arg, REBVAL *path)
 		}
 	}
 #endif
+	parent = pvs->value; // for the GC write barrier
 	switch (func(pvs)) {
 	case PE_OK:
 		break;
 	case PE_SET: // only sets if end of path
 		if (pvs->setval && IS_END(pvs->path+1)) {
+			Path_Barrier(parent);
 			*pvs->value = *pvs->setval;
 			pvs->setval = 0;
 		}
@@ -553,7 +581,10 @@ thrown:
 	case PE_OK:
 		break;
 	case PE_SET: // only sets if end of path
-		if (pvs.setval) *pvs.value = *pvs.setval;
+		if (pvs.setval) {
+			Path_Barrier(value);
+			*pvs.value = *pvs.setval;
+		}
 		break;
 	case PE_NONE:
 		SET_NONE(pvs.store);
@@ -645,6 +676,27 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 #endif
 
 
+/***********************************************************************
+**
+*/	REBFLG Only_Evaluates(REBVAL *func)
+/*
+**		Returns TRUE for natives which just evaluate their block args
+**		(without refinements). Blocks of a shared closure body may be
+**		passed to them as they are, without a copy.
+**
+***********************************************************************/
+{
+	REBFUN code;
+
+	if (!IS_NATIVE(func)) return FALSE;
+	code = VAL_FUNC_CODE(func);
+	return code == &N_if || code == &N_either || code == &N_unless
+		|| code == &N_case || code == &N_switch || code == &N_any || code == &N_all
+		|| code == &N_attempt || code == &N_try || code == &N_catch
+		|| code == &N_loop || code == &N_while || code == &N_until || code == &N_forever;
+}
+
+
 /***********************************************************************
 **
 */	static REBINT Do_Args(REBCNT func_offset, REBVAL *path, REBSER *block, REBCNT index)
@@ -669,6 +721,7 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 	REBVAL *tos;
 	REBVAL *func;
 	REBOOL useArgs = TRUE;  // can be used by get-word function refinements to ignore values
+	REBFLG raw_blocks;		// closure body blocks are passed without a copy
 
 	if ((dsp + 100) > (REBINT)SERIES_REST(DS_Series)) {
 		Expand_Stack(STACK_MIN);
@@ -683,6 +736,7 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 	args = BLK_SKIP(words, 1);
 	ds = SERIES_TAIL(words)-1;	// length of stack fill below
 	//Debug_Fmt("Args: %z", VAL_FUNC_ARGS(func));
+	raw_blocks = SERIES_GET_FLAG(block, SER_REL) && (!path || IS_END(path)) && Only_Evaluates(func);
 
 	// If func is operator, first arg is already on stack:
 	if (IS_OP(func)) {
@@ -714,6 +768,17 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 		switch (VAL_TYPE(args)) {
 
 		case REB_WORD:		// WORD - Evaluate next value
+			if (raw_blocks && index < BLK_LEN(block)) {
+				value = BLK_SKIP(block, index);
+				// Unless the block is an operator's arg:
+				if (IS_BLOCK(value) && SERIES_GET_FLAG(VAL_SERIES(value), SER_REL)
+					&& !(IS_WORD(value+1) && VAL_WORD_FRAME(value+1) && IS_OP(Get_Var(value+1)))
+				) {
+					index++;
+					if (useArgs) DS_Base[ds] = *value;
+					break;
+				}
+			}
 			index = Do_Next(block, index, IS_OP(func));
 			// THROWN is handled after the switch.
 			if (index == END_FLAG) Trap2(RE_NO_ARG, Func_Word(dsf), args);
@@ -730,7 +795,10 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 				}
 				else {
 					index++;
-					if (useArgs) DS_Base[ds] = *value;
+					if (useArgs) {
+						DS_Base[ds] = *value;
+						SPECIFY_VALUE(block, DS_VALUE(ds));
+					}
 				}
 			} else
 				SET_UNSET(DS_VALUE(ds)); // allowed to be none
@@ -738,7 +806,10 @@ x*/	static REBINT Do_Args_Light(REBVAL *func, REBVAL *path, REBSER *block, REBCN
 
 		case REB_GET_WORD:	// :WORD - Get value
 			if (index < BLK_LEN(block)) {
-				if (useArgs) DS_Base[ds] = *BLK_SKIP(block, index);
+				if (useArgs) {
+					DS_Base[ds] = *BLK_SKIP(block, index);
+					SPECIFY_VALUE(block, DS_VALUE(ds));
+				}
 				index++;
 			} else
 				SET_UNSET(DS_VALUE(ds)); // allowed to be none
@@ -851,16 +922,16 @@ more_get_path:
 			Check_Security(SYM_EVAL, POL_EXEC, 0);
 	}
 
-	if (!(Eval_Signals & Eval_Sigmask)) return;
+	if (!(ANY_SIGNALS & Eval_Sigmask)) return;
 
 	// Be careful of signal loops! EG: do not PRINT from here.
-	sigs = Eval_Signals & (mask = Eval_Sigmask);
+	sigs = ANY_SIGNALS & (mask = Eval_Sigmask);
 	Eval_Sigmask = 0;	// avoid infinite loop
 	//Debug_Num("Signals:", Eval_Signals);
 
 	// Check for recycle signal:
 	if (GET_FLAG(sigs, SIG_RECYCLE)) {
-		CLR_SIGNAL(SIG_RECYCLE);
+		CLR_TASK_SIGNAL(SIG_RECYCLE);
 		Recycle(FALSE, FALSE);
 	}
 
@@ -871,6 +942,20 @@ more_get_path:
 	}
 #endif
 
+	// Sample the call stack (only the task running the sampler):
+	if (GET_FLAG(sigs, SIG_SAMPLE) && Sampler) {
+		CLR_SIGNAL(SIG_SAMPLE);
+		Sample_Stack();
+	}
+
+#ifdef INCLUDE_TASK
+	// Sub-tasks halt when the program quits (see Stop_Tasks):
+	if (GET_FLAG(sigs, SIG_STOP_TASKS) && Task_Heap != 0) {
+		Eval_Sigmask = mask;
+		Halt_Code(RE_HALT, 0); // Throws!
+	}
+#endif
+
 	// Escape only allowed after MEZZ boot (no handlers):
 	if (GET_FLAG(sigs, SIG_ESCAPE) && PG_Boot_Phase >= BOOT_MEZZ) {
 		CLR_SIGNAL(SIG_ESCAPE);
@@ -905,7 +990,7 @@ more_get_path:
 	//CHECK_MEMORY(1);
 	CHECK_STACK(&value);
 	if ((DSP + 200) > (REBINT)SERIES_REST(DS_Series)) Expand_Stack(STACK_MIN); //Trap0(RE_STACK_OVERFLOW); 
-	if (--Eval_Count <= 0 || Eval_Signals) Do_Signals();
+	if (--Eval_Count <= 0 || ANY_SIGNALS) Do_Signals();
 
 	value = BLK_SKIP(block, index);
 	//if (Trace_Flags) Trace_Eval(block, index);
@@ -932,6 +1017,7 @@ reval:
 
 	case ET_SELF:
 		DS_PUSH(value);
+		SPECIFY_VALUE(block, DS_TOP);
 		index++;
 		break;
 
@@ -1041,6 +1127,7 @@ eval_func2:
 	case ET_LIT_WORD:
 		DS_PUSH(value);
 		VAL_SET(DS_TOP, REB_WORD);
+		SPECIFY_VALUE(block, DS_TOP);
 		index++;
 		break;
 
@@ -1052,6 +1139,7 @@ eval_func2:
 	case ET_LIT_PATH:
 		DS_PUSH(value);
 		VAL_SET(DS_TOP, REB_PATH);
+		SPECIFY_VALUE(block, DS_TOP);
 		index++;
 		break;
 
@@ -1106,7 +1194,7 @@ eval_func2:
 	// If block was empty:
 	if (!tos) {
 		// CC#2229 - respond to Halt() in code like 'forever []'
-		if (--Eval_Count <= 0 || Eval_Signals) Do_Signals();
+		if (--Eval_Count <= 0 || ANY_SIGNALS) Do_Signals();
 
 		tos = DS_NEXT; SET_UNSET(tos);
 	}
@@ -1143,7 +1231,7 @@ eval_func2:
 	// If series was empty:
 	if (!tos) {
 		// CC#2229 - respond to Halt() in code like 'forever []'
-		if (--Eval_Count <= 0 || Eval_Signals) Do_Signals();
+		if (--Eval_Count <= 0 || ANY_SIGNALS) Do_Signals();
 
 		tos = DS_NEXT; SET_UNSET(tos);
 	}
@@ -1185,7 +1273,7 @@ eval_func2:
 	}
 	if (!tos) {
 		// CC#2229 - respond to Halt() in code like 'forever []'
-		if (--Eval_Count <= 0 || Eval_Signals) Do_Signals();
+		if (--Eval_Count <= 0 || ANY_SIGNALS) Do_Signals();
 
 		tos = DS_NEXT; SET_UNSET(tos);
 	}
@@ -1762,6 +1850,7 @@ reapply:  // Go back here to start over with a new func
 **
 ***********************************************************************/
 {
+	GC_BARRIER(VAL_SERIES(block));
 	Bind_Block(frame, VAL_BLK_DATA(block), BIND_DEEP);
 	return DO_BLK(block);
 }
@@ -1776,6 +1865,7 @@ reapply:  // Go back here to start over with a new func
 **
 ***********************************************************************/
 {
+	GC_BARRIER(VAL_SERIES(block));
 	Bind_Block(frame, VAL_BLK_DATA(block), binding);
 	Reduce_Block(VAL_SERIES(block), VAL_INDEX(block), 0);
 }
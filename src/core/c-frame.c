@@ -83,12 +83,30 @@
 			4. Special frames, such as system natives and actions
 			may be created by specific block scans and appending to
 			a given frame.
+
+		Word lookups by symbol (used for paths like req/headers/host)
+		remember the found index for the word list and symbol. Cloned
+		frames share the word list, so objects made from the same
+		prototype find their words without a scan. A remembered index
+		is used only when the word at it still has the symbol, so
+		changed or reused word lists are always safe.
 */
 
 #include "sys-core.h"
 
 #define CHECK_BIND_TABLE
 
+#define WORD_INDEX_CACHE 256 // must be power of 2
+#define WORD_INDEX_SLOT(w,s) ((((REBUPT)(w) >> 4) ^ ((s) * 0x9E3779B1)) & (WORD_INDEX_CACHE - 1))
+
+typedef struct Reb_Word_Index {
+	REBSER *words;	// frame word list
+	REBCNT sym;		// symbol looked up
+	REBCNT index;	// where it was found
+} REBWIX;
+
+static THREAD REBWIX Word_Index_Cache[WORD_INDEX_CACHE];
+
 /***********************************************************************
 **
 */	void Check_Bind_Table(void)
@@ -702,6 +720,9 @@
 
 	if (IS_PROTECT_SERIES(target)) Trap0(RE_PROTECTED);
 
+	// Values of the source are copied into the target:
+	GC_BARRIER(target);
+
 	if (IS_INTEGER(only_words)) { // Must be: 0 < i <= tail
 		i = VAL_INT32(only_words); // never <= 0
 		if (i == 0) i = 1;
@@ -813,6 +834,9 @@
 **      bind prior instances of the word before the set-word. That is
 **      forward references are not allowed.
 **
+**      The caller applies GC_BARRIER to the top block; sub-blocks
+**      and function bodies are done here.
+**
 ***********************************************************************/
 {
 	REBINT *binds = WORDS_HEAD(Bind_Table); // GC safe to do here
@@ -850,11 +874,14 @@
 			}
 			val = Append_Value(MOLD_LOOP);
 			Set_Block(val, VAL_SERIES(value));
+			GC_BARRIER(VAL_SERIES(value));
 			Bind_Block_Words(frame, VAL_BLK_DATA(value), mode);
 			Remove_Last(MOLD_LOOP);
 		}
-		else if ((IS_FUNCTION(value) || IS_CLOSURE(value)) && (mode & BIND_FUNC))
+		else if ((IS_FUNCTION(value) || IS_CLOSURE(value)) && (mode & BIND_FUNC)) {
+			GC_BARRIER(VAL_FUNC_BODY(value));
 			Bind_Block_Words(frame, BLK_HEAD(VAL_FUNC_BODY(value)), mode);
+		}
 	}
 	
 }
@@ -872,6 +899,9 @@
 **                      (note: word must not occur before the SET)
 **          BIND_DEEP - Recurse into sub-blocks.
 **
+**      Words of the block will link the frame, so the caller must
+**      GC_BARRIER the series of the block when it may be old.
+**
 ***********************************************************************/
 {
 	REBVAL *words;
@@ -954,6 +984,8 @@
 	REBVAL *value = BLK_HEAD(block);
 	REBINT n;
 
+	GC_BARRIER(block);
+
 	for (; NOT_END(value); value++) {
 		if (ANY_WORD(value)) {
 			// Is the word (canon sym) found in this frame?
@@ -1007,6 +1039,27 @@
 }
 
 
+/***********************************************************************
+**
+*/  void Mark_Relative(REBSER *block)
+/*
+**      Flags the block and its sub-blocks as parts of a shared
+**      closure body (SER_REL). Series values of such blocks are
+**      copied once per call when they are used (see Do_Closure).
+**
+***********************************************************************/
+{
+	REBVAL *value;
+
+	if (SERIES_GET_FLAG(block, SER_REL)) return;
+	SERIES_SET_FLAG(block, SER_REL);
+
+	for (value = BLK_HEAD(block); NOT_END(value); value++) {
+		if (ANY_BLOCK(value)) Mark_Relative(VAL_SERIES(value));
+	}
+}
+
+
 /***********************************************************************
 **
 */  void Bind_Stack_Block(REBSER *frame, REBSER *block)
@@ -1048,14 +1101,18 @@
 	REBINT *binds = WORDS_HEAD(Bind_Table);
 
 	for (; NOT_END(data); data++) {
-		if (ANY_BLOCK_OR_MAP(data))
+		if (ANY_BLOCK_OR_MAP(data)) {
+			GC_BARRIER(VAL_SERIES(data));
 			Rebind_Block(src_frame, dst_frame, VAL_BLK_DATA(data), modes);
+		}
 		else if (ANY_WORD(data) && VAL_WORD_FRAME(data) == src_frame) {
 			VAL_WORD_FRAME(data) = dst_frame;
 			if (modes & REBIND_TABLE) VAL_WORD_INDEX(data) = binds[VAL_WORD_CANON(data)];
 			if (modes & REBIND_TYPE) VAL_WORD_INDEX(data) = - VAL_WORD_INDEX(data);
-		} else if ((modes & REBIND_FUNC) && (IS_FUNCTION(data) || IS_CLOSURE(data)))
+		} else if ((modes & REBIND_FUNC) && (IS_FUNCTION(data) || IS_CLOSURE(data))) {
+			GC_BARRIER(VAL_FUNC_BODY(data));
 			Rebind_Block(src_frame, dst_frame, BLK_HEAD(VAL_FUNC_BODY(data)), modes);
+		}
 	}
 }
 
@@ -1095,16 +1152,30 @@
 **
 ***********************************************************************/
 {
-	REBCNT len = SERIES_TAIL(FRM_WORD_SERIES(frame));
-	REBVAL *word = FRM_WORDS(frame) + 1;
+	REBSER *words = FRM_WORD_SERIES(frame);
+	REBCNT len = SERIES_TAIL(words);
+	REBVAL *word;
 	REBCNT n;
 	REBCNT s;
+	REBWIX *wix = &Word_Index_Cache[WORD_INDEX_SLOT(words, sym)];
 
 	s = SYMBOL_TO_CANON(sym); // always compare to CANON sym
 
-	for (n = 1; n < len; n++, word++)
+	// Found in this word list before (see notes above)?
+	if (wix->words == words && wix->sym == sym && wix->index < len) {
+		word = BLK_SKIP(words, wix->index);
 		if (sym == VAL_BIND_SYM(word) || s == VAL_BIND_CANON(word))
+			return (!always && VAL_GET_OPT(word, OPTS_HIDE)) ? 0 : wix->index;
+	}
+
+	word = BLK_SKIP(words, 1);
+	for (n = 1; n < len; n++, word++)
+		if (sym == VAL_BIND_SYM(word) || s == VAL_BIND_CANON(word)) {
+			wix->words = words;
+			wix->sym = sym;
+			wix->index = n;
 			return (!always && VAL_GET_OPT(word, OPTS_HIDE)) ? 0 : n;
+		}
 
 	return 0;
 }
@@ -1222,7 +1293,7 @@
 		if (dsf <= 0) Trap1(RE_NOT_DEFINED, word); // change error !!!
 	}
 //	if (Trace_Level) Dump_Stack_Frame(dsf);
-	return DSF_ARGS(dsf, -index);
+	return DSF_VARS(dsf) - index;
 }
 
 
@@ -1243,6 +1314,7 @@
 	if (index >= 0) {
 		if (VAL_PROTECTED(FRM_WORDS(frame) + index))
 			Trap1(RE_LOCKED_WORD, word);
+		GC_BARRIER(frame);
 		return FRM_VALUES(frame) + index;
 	}
 
@@ -1255,6 +1327,10 @@
 		if (dsf <= 0) Trap1(RE_NOT_DEFINED, word); // change error !!!
 	}
 //	if (Trace_Level) Dump_Stack_Frame(dsf);
+	if (NZ(frame = DSF_CLOSURE_FRAME(dsf))) {
+		GC_BARRIER(frame);
+		return FRM_VALUES(frame) - index;
+	}
 	return DSF_ARGS(dsf, -index);
 }
 
@@ -1278,7 +1354,7 @@
 		dsf = PRIOR_DSF(dsf);
 		if (dsf <= 0) return 0;
 	}
-	return DSF_ARGS(dsf, -index);
+	return DSF_VARS(dsf) - index;
 }
 
 
@@ -1325,6 +1401,7 @@
 		frm = VAL_WORD_FRAME(word);
 		if (VAL_PROTECTED(FRM_WORDS(frm)+index))
 			Trap1(RE_LOCKED_WORD, word);
+		GC_BARRIER(frm);
 		FRM_VALUES(frm)[index] = *value;
 		return;
 	}
@@ -1336,6 +1413,11 @@
 		dsf = PRIOR_DSF(dsf);
 		if (dsf <= 0) Trap1(RE_NOT_DEFINED, word); // change error !!!
 	}
+	if (NZ(frm = DSF_CLOSURE_FRAME(dsf))) {
+		GC_BARRIER(frm);
+		FRM_VALUES(frm)[-index] = *value;
+		return;
+	}
 	*DSF_ARGS(dsf, -index) = *value;
 }
 
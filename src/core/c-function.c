@@ -229,6 +229,9 @@
 	if ((type == REB_FUNCTION || type == REB_CLOSURE || type == REB_OP) && !IS_ACTION(def))
 		Bind_Relative(VAL_FUNC_ARGS(value), VAL_FUNC_ARGS(value), VAL_FUNC_BODY(value));
 
+	if (type == REB_CLOSURE)
+		Mark_Relative(VAL_FUNC_BODY(value));
+
 	return TRUE;
 }
 
@@ -271,6 +274,8 @@
 	// Rebind function words:
 	if (IS_FUNCTION(value) || IS_CLOSURE(value))
 		Bind_Relative(VAL_FUNC_ARGS(value), VAL_FUNC_ARGS(value), VAL_FUNC_BODY(value));
+	if (IS_CLOSURE(value))
+		Mark_Relative(VAL_FUNC_BODY(value));
 
 	return TRUE;
 }
@@ -290,6 +295,8 @@
 	// VAL_FUNC_BODY(value) = Clone_Block(VAL_FUNC_BODY(func));
 	VAL_FUNC_BODY(value) = Copy_Block_Values(VAL_FUNC_BODY(func), 0, SERIES_TAIL(VAL_FUNC_BODY(func)), TS_CLONE);
 	Rebind_Block(src_frame, VAL_FUNC_ARGS(value), BLK_HEAD(VAL_FUNC_BODY(value)), 0);
+	if (IS_CLOSURE(value))
+		Mark_Relative(VAL_FUNC_BODY(value));
 }
 
 
@@ -451,34 +458,167 @@
 
 /***********************************************************************
 **
-*/	void Do_Closure(REBVAL *func)
+*/	static REBSER *Closure_State(REBINT dsf)
 /*
-**		Do a closure by cloning its body and rebinding it to
-**		a new frame of words/values.
+**		Returns the block of a running closure's call state:
+**		its frame object (or NONE) followed by pairs of the body's
+**		series and their copies made for the call (see DSF_VARS).
 **
 ***********************************************************************/
 {
-	REBSER *body;
-	REBSER *frame;
-	REBVAL *result;
-	REBVAL *ds;
+	REBSER *state;
 
-	Eval_Functions++;
-	//DISABLE_GC;
+	if (IS_BLOCK(DSF_RETURN(dsf))) return VAL_SERIES(DSF_RETURN(dsf));
+
+	state = Make_Block(7);
+	SET_NONE(BLK_HEAD(state));
+	SERIES_TAIL(state) = 1;
+	BLK_TERM(state);
+	Set_Block(DSF_RETURN(dsf), state); // keep it GC safe
+	return state;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Closure_Frame(REBINT dsf)
+/*
+**		Returns the frame object of a running closure. It is made
+**		from the args on the stack when the first word escapes and
+**		from then it holds the closure's variables (see DSF_VARS).
+**
+***********************************************************************/
+{
+	REBSER *state;
+	REBSER *frame;
+	REBVAL *func;
 
-	// Clone the body of the function to allow rebinding to it:
-	body = Clone_Block(VAL_FUNC_BODY(func));
+	if (NZ(frame = DSF_CLOSURE_FRAME(dsf))) return frame;
 
-	// Copy stack frame args as the closure object (one extra at head)
-	frame = Copy_Values(BLK_SKIP(DS_Series, DS_ARG_BASE), SERIES_TAIL(VAL_FUNC_ARGS(func)));
+	state = Closure_State(dsf);
+	func = DSF_FUNC(dsf);
+	frame = Copy_Values(DSF_ARGS(dsf, 0), SERIES_TAIL(VAL_FUNC_ARGS(func)));
 	SET_FRAME(BLK_HEAD(frame), 0, VAL_FUNC_ARGS(func));
+	GC_BARRIER(state);
+	SET_OBJECT(BLK_HEAD(state), frame); // keep it GC safe
+	return frame;
+}
 
-	// Rebind the body to the new context (deeply):
-	Rebind_Block(VAL_FUNC_ARGS(func), frame, BLK_HEAD(body), REBIND_TYPE);
 
-	ds = DS_RETURN;
-	SET_OBJECT(ds, body); // keep it GC safe
-	result = Do_Blk(body, 0); // GC-OK - also, result returned on DS stack
+/***********************************************************************
+**
+*/	static REBFLG Has_Relative_Words(REBSER *args, REBSER *block)
+/*
+**		Returns TRUE when the block (or map) has any words bound
+**		relatively to the closure args (deep).
+**
+***********************************************************************/
+{
+	REBVAL *value;
+
+	for (value = BLK_HEAD(block); NOT_END(value); value++) {
+		if (ANY_WORD(value)) {
+			if (VAL_WORD_INDEX(value) < 0 && VAL_WORD_FRAME(value) == args) return TRUE;
+		}
+		else if (ANY_BLOCK_OR_MAP(value) && Has_Relative_Words(args, VAL_SERIES(value)))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	void Specify_Closure_Value(REBVAL *value)
+/*
+**		Makes a value of a shared closure body usable outside of the
+**		evaluation. Words relative to the running closure are bound
+**		to its frame object. Series are copied (deeply) once per call,
+**		as if the body was copied for each call, and the copies of
+**		blocks with the closure's words are rebound to the frame.
+**		Maps are copied only when they have such words.
+**
+**		The value must be GC safe (usually it is on the stack).
+**
+***********************************************************************/
+{
+	REBSER *args;
+	REBSER *state;
+	REBSER *ser;
+	REBVAL *val;
+	REBINT dsf;
+
+	if (ANY_WORD(value)) {
+		if (VAL_WORD_INDEX(value) >= 0) return;
+		// Find the closure's call:
+		args = VAL_WORD_FRAME(value);
+		dsf = DSF;
+		while (args != VAL_WORD_FRAME(DSF_WORD(dsf))) {
+			dsf = PRIOR_DSF(dsf);
+			if (dsf <= 0) return;
+		}
+		if (!IS_CLOSURE(DSF_FUNC(dsf))) return;
+		VAL_WORD_FRAME(value) = Closure_Frame(dsf);
+		VAL_WORD_INDEX(value) = -VAL_WORD_INDEX(value);
+		return;
+	}
+
+	// The body is evaluated by the closure itself or by natives
+	// which got its blocks as they are (see Only_Evaluates):
+	for (dsf = DSF; dsf > 0 && !IS_CLOSURE(DSF_FUNC(dsf)); dsf = PRIOR_DSF(dsf))
+		if (!Only_Evaluates(DSF_FUNC(dsf))) return;
+	if (dsf <= 0) return;
+	args = VAL_FUNC_ARGS(DSF_FUNC(dsf));
+
+	if (IS_MAP(value) && !Has_Relative_Words(args, VAL_SERIES(value))) return;
+
+	// Already copied in this call?
+	state = Closure_State(dsf);
+	for (val = BLK_SKIP(state, 1); NOT_END(val); val += 2) {
+		if (VAL_SERIES(val) == VAL_SERIES(value)) {
+			VAL_SERIES(value) = VAL_SERIES(val+1);
+			return;
+		}
+	}
+
+	if (IS_MAP(value)) {
+		ser = Copy_Map(value, TS_CODE);
+		Rebind_Block(args, Closure_Frame(dsf), BLK_HEAD(ser), REBIND_TYPE);
+	}
+	else if (ANY_BLOCK(value)) {
+		ser = Clone_Block(VAL_SERIES(value));
+		if (Has_Relative_Words(args, ser))
+			Rebind_Block(args, Closure_Frame(dsf), BLK_HEAD(ser), REBIND_TYPE);
+	}
+	else ser = Copy_Series(VAL_SERIES(value));
+
+	*Append_Value(state) = *value;
+	val = Append_Value(state);
+	*val = *value;
+	VAL_SERIES(val) = ser;
+	VAL_SERIES(value) = ser;
+}
+
+
+/***********************************************************************
+**
+*/	void Do_Closure(REBVAL *func)
+/*
+**		Do a closure. Its body is shared as in a function and the
+**		args stay on the stack. Only series of the body which are used
+**		as values in the call are copied (once per call) and those with
+**		words of the closure are bound to a frame object made for the
+**		call (see Specify_Closure_Value).
+**
+***********************************************************************/
+{
+	REBVAL *result;
+	REBVAL *ds;
+
+	Eval_Functions++;
+
+	SET_NONE(DS_RETURN); // no call state yet
+	result = Do_Blk(VAL_FUNC_BODY(func), 0); // GC-OK - also, result returned on DS stack
 	ds = DS_RETURN;
 
 	if (IS_ERROR(result) && IS_RETURN(result)) {
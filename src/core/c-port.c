@@ -180,11 +180,16 @@
 	REBINT old_time = -1;
 
 	while (wt) {
-		if (GET_SIGNAL(SIG_ESCAPE)) {
+		// Escape is handled by the main task only (see Init_Task):
+		if (GET_SIGNAL(SIG_ESCAPE) && GET_FLAG(Eval_Sigmask, SIG_ESCAPE)) {
 			CLR_SIGNAL(SIG_ESCAPE);
 			Out_Str(cb_cast("[ESC]"), 1, TRUE);
 			Halt_Code(RE_HALT, 0); // Throws!
 		}
+#ifdef INCLUDE_TASK
+		if (GET_SIGNAL(SIG_STOP_TASKS) && Task_Heap != 0)
+			Halt_Code(RE_HALT, 0); // Throws!
+#endif
 
 		// Process any waiting events:
 		if ((result = Awake_System(ports, only)) > 0) return TRUE;
@@ -597,6 +602,8 @@ SCHEME_ACTIONS *Scheme_Actions;	// Initial Global (not threaded)
 	Init_UDP_Scheme();
 	Init_DNS_Scheme();
 	Init_Checksum_Scheme();
+	Init_Channel_Scheme();
+	Init_Compress_Scheme();
 #ifdef INCLUDE_CLIPBOARD
 	Init_Clipboard_Scheme();
 #endif
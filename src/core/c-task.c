@@ -24,7 +24,12 @@
 **  Summary: sub-task support
 **  Section: core
 **  Author:  Carl Sassenrath
-**  Notes:   INCOMPLETE IMPLEMENTATION (partially operational)
+**  Notes:
+**		Each task runs in its own thread with its own memory pools,
+**		data stack, task context, GC and bind table. The word table,
+**		natives, mezzanines and boot values are shared and must be
+**		used read-only by tasks. Tasks exchange values only as
+**		molded copies (task body and channel ports, see p-channel.c).
 **
 ***********************************************************************/
 
@@ -61,33 +66,196 @@
 #include "sys-core.h"
 
 #ifdef INCLUDE_TASK
+typedef struct Reb_Task_Start {
+	REBYTE *body;	// molded task body (UTF-8)
+	REBCNT size;	// its size in bytes
+	REBCNT heap;	// heap id of the new task
+} REBTSK;
+
+
 /***********************************************************************
 **
-*/	static void Launch_Task(REBVAL *task)
+*/	static REBCNT Make_Task_Heap(void)
 /*
+**		Reserve a heap id for a new task. Returns zero if all
+**		ids are used.
+**
+***********************************************************************/
+{
+	REBCNT n;
+
+	OS_Lock(PG_Task_Lock);
+	for (n = 1; n < MAX_TASK_HEAPS; n++) {
+		if (!PG_Task_Heaps[n]) {
+			PG_Task_Heaps[n] = 1;
+			PG_Task_Count++;
+			break;
+		}
+	}
+	OS_Unlock(PG_Task_Lock);
+	return (n < MAX_TASK_HEAPS) ? n : 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Free_Task_Heap(REBCNT heap)
+/*
+***********************************************************************/
+{
+	OS_Lock(PG_Task_Lock);
+	PG_Task_Heaps[heap] = 0;
+	PG_Task_Count--;
+	OS_Signal_Lock(PG_Task_Lock); // see Stop_Tasks
+	OS_Unlock(PG_Task_Lock);
+}
+#endif
+
+
+/***********************************************************************
+**
+*/	REBFLG Stop_Tasks(REBINT msec)
+/*
+**		Ask all sub-tasks to halt and wait (up to msec) until they
+**		end. Returns FALSE when some task still runs, so the memory
+**		shared with tasks must not be released.
+**
+***********************************************************************/
+{
+#ifdef INCLUDE_TASK
+	REBI64 base;
+	REBINT wait;
+	REBFLG done;
+
+	if (!PG_Task_Lock) return TRUE;
+
+	OS_Lock(PG_Task_Lock);
+	if (PG_Task_Count > 0) {
+		SET_SIGNAL(SIG_STOP_TASKS);
+		base = OS_Delta_Time(0, 0);
+		while (PG_Task_Count > 0) {
+			wait = msec - (REBINT)(OS_Delta_Time(base, 0) / 1000);
+			if (wait <= 0) break;
+			OS_Wait_Lock(PG_Task_Lock, wait);
+		}
+	}
+	done = (PG_Task_Count == 0);
+	OS_Unlock(PG_Task_Lock);
+	return done;
+#else
+	return TRUE;
+#endif
+}
+
+
+/***********************************************************************
+**
+*/	REBYTE *Pack_Task_Value(REBVAL *value, REBCNT *size)
+/*
+**		Mold (/all) a value into an UTF-8 buffer (made by Make_Mem),
+**		so it can be handed to another task. Tasks do not share
+**		series, so values are always passed as deep copies.
+**		The size (in bytes) is stored in the size argument.
+**
+***********************************************************************/
+{
+	REB_MOLD mo = {0};
+	REBYTE *bin;
+
+	SET_FLAG(mo.opts, MOPT_MOLD_ALL);
+	Reset_Mold(&mo);
+	Mold_Value(&mo, value, TRUE);
+
+	*size = SERIES_TAIL(mo.series);
+	bin = Make_Mem(*size + 1);
+	if (!bin) Trap0(RE_NO_MEMORY);
+	COPY_MEM(bin, BIN_HEAD(mo.series), *size);
+	bin[*size] = 0;
+	return bin;
+}
+
+
+/***********************************************************************
+**
+*/	void Unpack_Task_Value(REBYTE *bin, REBCNT size, REBVAL *out)
+/*
+**		Load a value packed by Pack_Task_Value (in this task).
+**		Words of the result are not bound.
+**
+***********************************************************************/
+{
+	REBSER *ser = Scan_Source(bin, size);
+
+	if (SERIES_TAIL(ser) > 0) *out = *BLK_HEAD(ser);
+	else SET_UNSET(out);
+}
+
+
+#ifdef INCLUDE_TASK
+/***********************************************************************
+**
+*/	static void Launch_Task(REBTSK *task)
+/*
+**		Thread entry of a new task. The task gets its own memory
+**		pools, data stack and task context. The body is loaded
+**		from its molded form and bound to a new private context
+**		resolved from lib (as the user context is).
+**
 ***********************************************************************/
 {
 	REBOL_STATE state;
 	REBSER *body;
+	REBSER *frame;
+	REBVAL vali;
+	REBCNT heap;
+	int marker;
 
-	Debug_Str("Begin Task");
+	Task_Heap = task->heap;
+#ifdef OS_STACK_GROWS_UP
+	Stack_Limit = (REBUPT)(&marker) + STACK_BOUNDS;
+#else
+	Stack_Limit = (REBUPT)(&marker) - STACK_BOUNDS;
+#endif
 
 	Init_Task();
-	body = Clone_Block(VAL_MOD_BODY(task));
 	OS_Task_Ready(0);
-	
-	PUSH_STATE(state, Saved_State);
+
+	PUSH_STATE(state, Halt_State);
 	if (SET_JUMP(state)) {
-		POP_STATE(state, Saved_State);
+		POP_STATE(state, Halt_State);
+		Saved_State = Halt_State;
 		Catch_Error(DS_NEXT); // Stores error value here
-		Debug_Str("End Task -> error!");
-		return;
+		if (VAL_ERR_NUM(DS_NEXT) != RE_QUIT && VAL_ERR_NUM(DS_NEXT) != RE_HALT)
+			Debug_Str("End Task -> error!");
+		goto done;
 	}
-	SET_STATE(state, Saved_State);
+	SET_STATE(state, Halt_State);
+	// Errors, HALT and QUIT end the task (see Do_String):
+	Saved_State = Halt_State;
+
+	Unpack_Task_Value(task->body, task->size, DS_NEXT);
+	if (!IS_BLOCK(DS_NEXT)) Trap_Arg(DS_NEXT);
+	body = VAL_SERIES(DS_NEXT);
+	SAVE_SERIES(body);
+
+	frame = Make_Frame(0);
+	SAVE_SERIES(frame);
+	Bind_Block(frame, BLK_HEAD(body), BIND_ALL | BIND_DEEP);
+	SET_INTEGER(&vali, 1);
+	Resolve_Context(frame, Lib_Context, &vali, FALSE, 0);
+
 	Do_Blk(body, 0);
 
-	POP_STATE(state, Saved_State);
-	Debug_Str("End Task");
+	POP_STATE(state, Halt_State);
+	Saved_State = Halt_State;
+
+done:
+	Dispose_Task();
+	heap = task->heap;
+	Free_Mem(task->body, task->size + 1);
+	Free_Mem(task, sizeof(REBTSK));
+	// Last, as the main task may release all shared memory then:
+	Free_Task_Heap(heap);
 }
 #endif
 
@@ -95,10 +263,37 @@
 **
 */	void Do_Task(REBVAL *task)
 /*
+**		Start the task in a new thread. The body is passed molded,
+**		so nothing of the caller's memory is used by the task.
+**
 ***********************************************************************/
 {
 #ifdef INCLUDE_TASK
-	OS_Create_Thread((void*)Launch_Task, task, 50000);
+	REBVAL blk;
+	REBTSK *start;
+	REBCNT heap;
+
+	// No task runs yet, so the word table can be prepared for sharing:
+	if (PG_Task_Count == 0) Reserve_Word_Table();
+
+	start = Make_Mem(sizeof(REBTSK));
+	if (!start) Trap0(RE_NO_MEMORY);
+	Set_Block(&blk, VAL_MOD_BODY(task));
+	start->body = Pack_Task_Value(&blk, &start->size);
+
+	heap = Make_Task_Heap();
+	if (!heap) {
+		Free_Mem(start->body, start->size + 1);
+		Free_Mem(start, sizeof(REBTSK));
+		Trap_Num(RE_SIZE_LIMIT, MAX_TASK_HEAPS);
+	}
+	start->heap = heap;
+
+	if (OS_Create_Thread((CFUNC)Launch_Task, start, STACK_SIZE) < 0) {
+		Free_Task_Heap(heap);
+		Free_Mem(start->body, start->size + 1);
+		Free_Mem(start, sizeof(REBTSK));
+		Trap0(RE_NO_MEMORY);
+	}
 #endif
 }
-
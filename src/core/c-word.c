@@ -46,6 +46,7 @@
 #include <stdio.h>
 
 #define WORD_TABLE_SIZE 1024  // initial size in words
+#define WORD_TABLE_RESERVE (16 * WORD_TABLE_SIZE) // free words while tasks run
 
 
 /***********************************************************************
@@ -200,11 +201,31 @@
 	REBCNT	*hashes;
 	REBVAL  *words;
 	REBVAL  *w;
+	REBFLG  locked = FALSE;
 
 	//REBYTE *sss = Get_Sym_Name(1);	// (Debugging method)
 
 	if (len == 0) len = (REBCNT)LEN_BYTES(str);
 
+#ifdef INCLUDE_TASK
+	// The word table is shared. While tasks run, it is changed only
+	// with the lock and it must not be moved (see Reserve_Word_Table):
+	if (PG_Task_Count > 0) {
+		OS_Lock(PG_Task_Lock);
+		locked = TRUE;
+		if (
+			PG_Word_Table.series->tail >= PG_Word_Table.hashes->tail/2
+			|| SERIES_FULL(PG_Word_Table.series)
+			|| SERIES_AVAIL(PG_Word_Names) <= len + 1
+		) {
+			OS_Unlock(PG_Task_Lock);
+			Trap_Num(RE_SIZE_LIMIT, PG_Word_Table.series->tail);
+		}
+		// Words may be added by other tasks:
+		Bind_Table->tail = PG_Word_Table.series->tail;
+	}
+#endif
+
 	// If hash part of word table is too dense, expand it:
 	if (PG_Word_Table.series->tail > PG_Word_Table.hashes->tail/2)
 		Expand_Word_Table();
@@ -233,7 +254,10 @@
 		h = hashes[hash];
 		if (!h) break;
 		while ((n = Compare_UTF8(VAL_SYM_NAME(words + h), str, len)) >= 0) {
-			if (n == 0) return h; // direct hit
+			if (n == 0) { // direct hit
+				if (locked) OS_Unlock(PG_Task_Lock);
+				return h;
+			}
 			if (VAL_SYM_ALIAS(words + h)) h = VAL_SYM_ALIAS(words + h);
 			else goto make_sym; // Create new alias for word
 		}
@@ -261,10 +285,40 @@ make_sym:
 	PG_Word_Table.series->tail++;
 	Bind_Table->tail++;
 
+	if (locked) OS_Unlock(PG_Task_Lock);
 	return n;
 }
 
 
+/***********************************************************************
+**
+*/	void Reserve_Word_Table(void)
+/*
+**		Make room for new words before the first sub-task starts.
+**		While tasks run, the word table is not expanded, because
+**		other tasks read it without a lock.
+**
+***********************************************************************/
+{
+	REBCNT need = PG_Word_Table.series->tail + WORD_TABLE_RESERVE;
+
+	while (need > PG_Word_Table.hashes->tail/2)
+		Expand_Word_Table();
+
+	if (SERIES_REST(PG_Word_Table.series) <= need)
+		Extend_Series(PG_Word_Table.series, need - PG_Word_Table.series->tail);
+
+	if (SERIES_AVAIL(PG_Word_Names) < 8 * WORD_TABLE_RESERVE)
+		Extend_Series(PG_Word_Names, 8 * WORD_TABLE_RESERVE);
+
+	// Bind_Table size must be same like PG_Word_Table.series:
+	if (SERIES_REST(Bind_Table) < SERIES_REST(PG_Word_Table.series)) {
+		Extend_Series(Bind_Table, SERIES_REST(PG_Word_Table.series) - Bind_Table->tail);
+		CLEAR_SERIES(Bind_Table);
+	}
+}
+
+
 /***********************************************************************
 **
 */	REBCNT Last_Word_Num(void)
@@ -44,7 +44,7 @@
 		memo,
 		series,
 		SERIES_WIDE(series),
-		SERIES_TOTAL(series),
+		(REBCNT)SERIES_TOTAL(series),
 		SERIES_BIAS(series),
 		SERIES_TAIL(series),
 		SERIES_REST(series),
@@ -0,0 +1,426 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2026 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  d-profile.c
+**  Summary: sampling profiler of the call stack
+**  Section: debug
+**  Author:  Oldes
+**  Notes:
+**		A host timer sets SIG_SAMPLE and the next Do_Signals takes
+**		the sample: function words of the call frames (as shown by
+**		backtraces). Samples are taken only between evaluation
+**		steps, so a long native is counted to the native itself.
+**
+**		For each function word it counts samples with the function
+**		anywhere on the stack (inclusive) and on the top (exclusive)
+**		and the series made while it was on the top. Unique stacks
+**		are kept with their counts to be exported in the folded
+**		format used by flame graph tools: "root;...;top count".
+**
+**		All data is in plain memory (not series), so sampling never
+**		triggers GC or errors. The data is kept after SAMPLER OFF
+**		until the sampler is started again.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define SAMPLE_MSEC 1	// default sampling interval
+
+typedef struct Reb_Sample_Func {
+	REBCNT total;	// samples with the function on the stack
+	REBCNT self;	// samples with the function on the top
+	REBCNT allocs;	// series made while it was on the top
+	REBCNT stamp;	// last sample counted in total (recursion)
+} REBSFN;
+
+typedef struct Reb_Sampler {
+	REBFLG  running;
+	REBINT  msec;		// sampling interval
+	REBCNT  samples;	// all samples (also of top level code)
+	REBSFN *funcs;		// indexed by function word symbol
+	REBCNT  funcs_size;
+	REBCNT *frames;		// symbols of the sampled stack (root first)
+	REBCNT  frames_size;
+	REBCNT *stacks;		// unique stacks: count, depth, symbols...
+	REBCNT  stacks_tail;
+	REBCNT  stacks_size;
+	REBCNT *hashes;		// stack offsets + 1 (open addressing)
+	REBCNT  hashes_size;	// power of 2
+	REBCNT  hashes_count;
+} REBSMP;
+
+
+/***********************************************************************
+**
+*/	static REBFLG Grow_Sampler_Mem(void **mem, REBCNT *size, REBCNT need, REBCNT wide)
+/*
+**		Make sure the array has room for need items (cleared).
+**		Returns FALSE when out of memory.
+**
+***********************************************************************/
+{
+	REBCNT n = *size ? *size : 64;
+	void *m;
+
+	if (need <= *size) return TRUE;
+	while (n < need) n *= 2;
+	m = Make_Clear_Mem(n, wide);
+	if (!m) return FALSE;
+	if (*mem) {
+		COPY_MEM(m, *mem, *size * wide);
+		Free_Mem(*mem, *size * wide);
+	}
+	*mem = m;
+	*size = n;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Hash_Stack(REBCNT *syms, REBCNT depth)
+/*
+***********************************************************************/
+{
+	REBCNT hash = depth;
+
+	for (; depth > 0; depth--) hash = (hash * 31) ^ *syms++;
+	return hash * 0x9E3779B1;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Rehash_Stacks(REBSMP *smp)
+/*
+***********************************************************************/
+{
+	REBCNT size = smp->hashes_size ? smp->hashes_size * 2 : 256;
+	REBCNT *hashes = Make_Clear_Mem(size, sizeof(REBCNT));
+	REBCNT *stack;
+	REBCNT n, slot;
+
+	if (!hashes) return FALSE;
+	for (n = 0; n < smp->stacks_tail; n += 2 + stack[1]) {
+		stack = smp->stacks + n;
+		slot = Hash_Stack(stack + 2, stack[1]) & (size - 1);
+		while (hashes[slot]) slot = (slot + 1) & (size - 1);
+		hashes[slot] = n + 1;
+	}
+	if (smp->hashes) Free_Mem(smp->hashes, smp->hashes_size * sizeof(REBCNT));
+	smp->hashes = hashes;
+	smp->hashes_size = size;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static void Count_Stack(REBSMP *smp, REBCNT depth)
+/*
+**		Count the sampled frames as a unique stack.
+**
+***********************************************************************/
+{
+	REBCNT *frames = smp->frames;
+	REBCNT *stack;
+	REBCNT slot;
+
+	if (2 * (smp->hashes_count + 1) > smp->hashes_size && !Rehash_Stacks(smp)) return;
+
+	slot = Hash_Stack(frames, depth) & (smp->hashes_size - 1);
+	while (smp->hashes[slot]) {
+		stack = smp->stacks + smp->hashes[slot] - 1;
+		if (stack[1] == depth && !memcmp(stack + 2, frames, depth * sizeof(REBCNT))) {
+			stack[0]++;
+			return;
+		}
+		slot = (slot + 1) & (smp->hashes_size - 1);
+	}
+
+	if (!Grow_Sampler_Mem((void **)&smp->stacks, &smp->stacks_size, smp->stacks_tail + 2 + depth, sizeof(REBCNT))) return;
+	stack = smp->stacks + smp->stacks_tail;
+	stack[0] = 1;
+	stack[1] = depth;
+	COPY_MEM(stack + 2, frames, depth * sizeof(REBCNT));
+	smp->hashes[slot] = smp->stacks_tail + 1;
+	smp->hashes_count++;
+	smp->stacks_tail += 2 + depth;
+}
+
+
+/***********************************************************************
+**
+*/	void Sample_Stack(void)
+/*
+**		Take a sample of the call stack (from Do_Signals).
+**
+***********************************************************************/
+{
+	REBSMP *smp = Sampler;
+	REBCNT depth = 0;
+	REBCNT max = 0;
+	REBCNT sym, n;
+	REBINT dsf;
+	REBSFN *fn;
+
+	if (!smp || !smp->running) return;
+
+	smp->samples++;
+
+	// Collect function words from the top of the stack:
+	for (dsf = DSF; dsf > 0; dsf = PRIOR_DSF(dsf)) {
+		if (!Grow_Sampler_Mem((void **)&smp->frames, &smp->frames_size, depth + 1, sizeof(REBCNT))) return;
+		sym = VAL_WORD_SYM(DSF_WORD(dsf));
+		smp->frames[depth++] = sym;
+		if (sym > max) max = sym;
+	}
+	if (depth == 0) return; // top level code
+
+	// Root first (as in folded stacks):
+	for (n = 0; n < depth / 2; n++) {
+		sym = smp->frames[n];
+		smp->frames[n] = smp->frames[depth - 1 - n];
+		smp->frames[depth - 1 - n] = sym;
+	}
+
+	if (!Grow_Sampler_Mem((void **)&smp->funcs, &smp->funcs_size, max + 1, sizeof(REBSFN))) return;
+	for (n = 0; n < depth; n++) {
+		fn = smp->funcs + smp->frames[n];
+		if (fn->stamp != smp->samples) {
+			fn->stamp = smp->samples;
+			fn->total++;
+		}
+	}
+	smp->funcs[smp->frames[depth - 1]].self++;
+
+	Count_Stack(smp, depth);
+}
+
+
+/***********************************************************************
+**
+*/	void Sample_Alloc(void)
+/*
+**		Count a new series to the function on the top of the stack
+**		(from Make_Series while the sampler runs).
+**
+***********************************************************************/
+{
+	REBSMP *smp = Sampler;
+	REBCNT sym;
+
+	if (!smp->running || DSF <= 0) return;
+	sym = VAL_WORD_SYM(DSF_WORD(DSF));
+	if (!Grow_Sampler_Mem((void **)&smp->funcs, &smp->funcs_size, sym + 1, sizeof(REBSFN))) return;
+	smp->funcs[sym].allocs++;
+}
+
+
+/***********************************************************************
+**
+*/	static void Sampler_Tick(void *unused)
+/*
+**		Called by the host timer (from a signal handler or another
+**		thread), so it only sets the signal.
+**
+***********************************************************************/
+{
+	SET_SIGNAL(SIG_SAMPLE);
+}
+
+
+/***********************************************************************
+**
+*/	static void Stop_Sampler(void)
+/*
+***********************************************************************/
+{
+	if (!Sampler || !Sampler->running) return;
+	OS_Stop_Sampler();
+	CLR_SIGNAL(SIG_SAMPLE);
+	Sampler->running = FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	void Dispose_Sampler(void)
+/*
+**		Stop the sampler and free its data.
+**
+***********************************************************************/
+{
+	REBSMP *smp = Sampler;
+
+	if (!smp) return;
+	Stop_Sampler();
+	if (smp->funcs)  Free_Mem(smp->funcs,  smp->funcs_size  * sizeof(REBSFN));
+	if (smp->frames) Free_Mem(smp->frames, smp->frames_size * sizeof(REBCNT));
+	if (smp->stacks) Free_Mem(smp->stacks, smp->stacks_size * sizeof(REBCNT));
+	if (smp->hashes) Free_Mem(smp->hashes, smp->hashes_size * sizeof(REBCNT));
+	Free_Mem(smp, sizeof(REBSMP));
+	Sampler = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Start_Sampler(REBINT msec)
+/*
+***********************************************************************/
+{
+	Dispose_Sampler();
+
+	Sampler = Make_Clear_Mem(1, sizeof(REBSMP));
+	if (!Sampler) Trap0(RE_NO_MEMORY);
+	Sampler->msec = msec;
+	Sampler->running = TRUE;
+
+	if (!OS_Start_Sampler(Sampler_Tick, msec)) {
+		Dispose_Sampler();
+		Trap0(RE_FEATURE_NA);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static int Compare_Sample_Funcs(const void *a, const void *b)
+/*
+**		Most exclusive samples first, then most inclusive ones.
+**
+***********************************************************************/
+{
+	const REBSFN *fa = a;
+	const REBSFN *fb = b;
+
+	if (fa->self != fb->self) return (fa->self < fb->self) ? 1 : -1;
+	if (fa->total != fb->total) return (fa->total < fb->total) ? 1 : -1;
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Sampled_Funcs(REBSMP *smp)
+/*
+**		Returns block of: word total-time self-time allocations
+**		for each sampled function (one per line).
+**
+***********************************************************************/
+{
+	REBSFN *list;
+	REBSER *blk;
+	REBVAL *val;
+	REBCNT n, count = 0;
+
+	for (n = 0; n < smp->funcs_size; n++) {
+		if (smp->funcs[n].total || smp->funcs[n].allocs) count++;
+	}
+	blk = Make_Block(count * 4);
+	if (!count) return blk;
+
+	list = Make_Mem(count * sizeof(REBSFN));
+	if (!list) Trap0(RE_NO_MEMORY);
+	count = 0;
+	for (n = 0; n < smp->funcs_size; n++) {
+		if (smp->funcs[n].total || smp->funcs[n].allocs) {
+			list[count] = smp->funcs[n];
+			list[count++].stamp = n; // the symbol
+		}
+	}
+	stable_sort(list, count, sizeof(REBSFN), Compare_Sample_Funcs);
+
+	for (n = 0; n < count; n++) {
+		val = Append_Value(blk);
+		Init_Word(val, list[n].stamp);
+		VAL_SET_LINE(val);
+		val = Append_Value(blk);
+		VAL_SET(val, REB_TIME);
+		VAL_TIME(val) = (REBI64)list[n].total * smp->msec * (SEC_SEC / 1000);
+		val = Append_Value(blk);
+		VAL_SET(val, REB_TIME);
+		VAL_TIME(val) = (REBI64)list[n].self * smp->msec * (SEC_SEC / 1000);
+		val = Append_Value(blk);
+		SET_INTEGER(val, list[n].allocs);
+	}
+	Free_Mem(list, count * sizeof(REBSFN));
+	return blk;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Folded_Stacks(REBSMP *smp)
+/*
+**		Returns string of sampled stacks in the folded format
+**		(one "root;...;top count" line per unique stack).
+**
+***********************************************************************/
+{
+	REBSER *ser = Make_Binary(smp->stacks_tail * 8);
+	REBCNT *stack;
+	REBCNT n, i;
+
+	for (n = 0; n < smp->stacks_tail; n += 2 + stack[1]) {
+		stack = smp->stacks + n;
+		for (i = 0; i < stack[1]; i++) {
+			if (i > 0) Append_Byte(ser, ';');
+			Append_UTF8(ser, Get_Sym_Name(stack[2 + i]), NO_LIMIT);
+		}
+		Append_Byte(ser, ' ');
+		Append_Int(ser, stack[0]);
+		Append_Byte(ser, '\n');
+	}
+	TERM_SERIES(ser);
+	return ser;
+}
+
+
+/***********************************************************************
+**
+*/  REBNATIVE(sampler)
+/*
+***********************************************************************/
+{
+	REBVAL *arg = D_ARG(1);
+	REBINT msec;
+
+	Check_Security(SYM_DEBUG, POL_READ, 0);
+
+	if (IS_LOGIC(arg) && !VAL_LOGIC(arg)) {
+		if (!Sampler) return R_NONE;
+		Stop_Sampler();
+		if (D_REF(2)) Set_String(D_RET, Folded_Stacks(Sampler));
+		else Set_Block(D_RET, Sampled_Funcs(Sampler));
+		return R_RET;
+	}
+
+	if (IS_LOGIC(arg)) msec = SAMPLE_MSEC;
+	else if (IS_TIME(arg)) msec = (REBINT)(VAL_TIME(arg) / (SEC_SEC / 1000));
+	else msec = Int32s(arg, 1);
+	if (msec < 1) msec = 1;
+
+	Start_Sampler(msec);
+	return R_UNSET;
+}
@@ -317,6 +317,7 @@ x*/	REBSER *Copy_Block_Deep(REBSER *block, REBCNT index, REBINT len, REBCNT mode
 {
 	REBVAL *value;
 
+	GC_BARRIER(block);
 	EXPAND_SERIES_TAIL(block, 1);
 	value = BLK_TAIL(block);
 	SET_END(value);
@@ -350,6 +351,7 @@ x*/	REBSER *Copy_Block_Deep(REBSER *block, REBCNT index, REBINT len, REBCNT mode
 {
 	REBVAL *value;
 
+	GC_BARRIER(block);
 	EXPAND_SERIES_TAIL(block, 1);
 	value = BLK_TAIL(block);
 	SET_END(value);
@@ -401,7 +403,7 @@ x*/	REBSER *Copy_Block_Deep(REBSER *block, REBCNT index, REBINT len, REBCNT mode
 
 	ret = Make_Series(ser->tail, SERIES_WIDE(ser), FALSE);
 	ret->tail = ser->tail;
-	memcpy(ret->data, ser->data, ret->tail * SERIES_WIDE(ret));
+	memcpy(ret->data, ser->data, (size_t)ret->tail * SERIES_WIDE(ret));
 	return ret;
 }
 #endif
@@ -51,11 +51,14 @@
 	REBCNT tail  = SERIES_TAIL(dst_ser);
 	REBINT ilen  = 1;	// length to be inserted
 	REBINT size;		// total to insert
+	size_t dst_pos, dst_size; // in bytes
 	REBFLG is_blk = FALSE; // src_val is a block not a value
 
 	if (dups < 0) return (action == A_APPEND) ? 0 : dst_idx;
 	if (action == A_APPEND || dst_idx > tail) dst_idx = tail;
 
+	GC_BARRIER(dst_ser);
+
 	// Check /PART, compute LEN:
 	if (!GET_FLAG(flags, AN_ONLY) && ANY_BLOCK(src_val)) {
 		is_blk = TRUE; // src_val is a block
@@ -68,7 +71,8 @@
 		ilen = (action != A_CHANGE && GET_FLAG(flags, AN_PART)) ? dst_len : VAL_LEN(src_val);
 	}
 
-	// Total to insert:
+	// Total to insert (must not wrap around the length limit):
+	if ((REBU64)dups * ilen >= MAX_SERIES_LEN) Trap0(RE_TOO_LONG);
 	size = dups * ilen;
 
 	if (action != A_CHANGE) {
@@ -88,11 +92,11 @@
 
 	if (is_blk) src_val = VAL_BLK_DATA(src_val);
 
-	dst_idx *= SERIES_WIDE(dst_ser); // loop invariant
-	ilen  *= SERIES_WIDE(dst_ser); // loop invariant
+	dst_pos = (size_t)dst_idx * SERIES_WIDE(dst_ser); // loop invariant
+	dst_size = (size_t)ilen * SERIES_WIDE(dst_ser); // loop invariant
 	for (; dups > 0; dups--) {
-		memcpy(dst_ser->data + dst_idx, (REBYTE *)src_val, ilen);
-		dst_idx += ilen;
+		memcpy(dst_ser->data + dst_pos, (REBYTE *)src_val, dst_size);
+		dst_pos += dst_size;
 	}
 	BLK_TERM(dst_ser);
 
@@ -197,7 +201,8 @@
 		src_idx = 0;
 	}
 
-	// Total to insert:
+	// Total to insert (must not wrap around the length limit):
+	if ((REBU64)dups * src_len >= MAX_SERIES_LEN) Trap0(RE_TOO_LONG);
 	size = dups * src_len;
 
 	if (action != A_CHANGE) {
@@ -0,0 +1,247 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2026 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  f-parallel-sort.c
+**  Summary: stable merge sort using multiple threads
+**  Section: functional
+**  Author:  Oldes
+**  Notes:
+**    The data are split into one part per thread. Parts are sorted by
+**    a bottom-up merge sort and then merged pairwise, again in threads.
+**    Threads use only the memory prepared by the caller and the
+**    comparator must not use any thread globals (data stack, pools)
+**    nor throw errors.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define PSORT_MIN_RUN 32
+#define PSORT_MAX_THREADS 64
+
+typedef struct rebol_parallel_sort {
+	REBYTE *base;
+	REBYTE *tmp;
+	size_t  size;
+	cmp_ctx_t *cmp;
+	void   *ctx;
+	void   *lock;
+	REBCNT  pending;    // jobs not finished yet
+} REBPSRT;
+
+typedef struct rebol_parallel_sort_job {
+	REBPSRT *sort;
+	REBYTE  *src;       // merge only: from
+	REBYTE  *dst;       // merge only: into
+	size_t   lo, mid, hi;
+	REBFLG   merge;
+} REBPSJB;
+
+
+/***********************************************************************
+**
+*/	static void Merge_Runs(REBPSRT *sort, REBYTE *src, REBYTE *dst, size_t lo, size_t mid, size_t hi)
+/*
+**		Stable merge of the runs [lo mid) and [mid hi) of src
+**		into the same positions of dst.
+**
+***********************************************************************/
+{
+	size_t size = sort->size;
+	REBYTE *a = src + lo * size, *ae = src + mid * size;
+	REBYTE *b = ae,              *be = src + hi * size;
+	REBYTE *d = dst + lo * size;
+
+	// Already ordered runs are just copied:
+	if (a == ae || b == be || sort->cmp(sort->ctx, ae - size, b) <= 0) {
+		if (src != dst) COPY_MEM(d, a, (hi - lo) * size);
+		return;
+	}
+	while (a < ae && b < be) {
+		if (sort->cmp(sort->ctx, a, b) <= 0) {
+			COPY_MEM(d, a, size); a += size;
+		} else {
+			COPY_MEM(d, b, size); b += size;
+		}
+		d += size;
+	}
+	if (a < ae) COPY_MEM(d, a, ae - a);
+	if (b < be) COPY_MEM(d, b, be - b);
+}
+
+
+/***********************************************************************
+**
+*/	static void Sort_Part(REBPSRT *sort, size_t lo, size_t hi)
+/*
+**		Bottom-up merge sort of [lo hi). The result is in the base.
+**
+***********************************************************************/
+{
+	size_t size = sort->size;
+	REBYTE *src = sort->base;
+	REBYTE *dst = sort->tmp;
+	REBYTE *swp;
+	REBYTE *key = sort->tmp + lo * size; // not used yet, so a free slot
+	size_t i, j, n, width;
+
+	// Insertion sort of short runs:
+	for (n = lo; n < hi; n += PSORT_MIN_RUN) {
+		size_t end = MIN(n + PSORT_MIN_RUN, hi);
+		for (i = n + 1; i < end; i++) {
+			COPY_MEM(key, src + i * size, size);
+			for (j = i; j > n && sort->cmp(sort->ctx, src + (j - 1) * size, key) > 0; j--)
+				COPY_MEM(src + j * size, src + (j - 1) * size, size);
+			COPY_MEM(src + j * size, key, size);
+		}
+	}
+
+	for (width = PSORT_MIN_RUN; width < hi - lo; width *= 2) {
+		for (n = lo; n < hi; n += 2 * width) {
+			size_t mid = MIN(n + width, hi);
+			Merge_Runs(sort, src, dst, n, mid, MIN(n + 2 * width, hi));
+		}
+		swp = src; src = dst; dst = swp;
+	}
+	if (src != sort->base) COPY_MEM(sort->base + lo * size, src + lo * size, (hi - lo) * size);
+}
+
+
+/***********************************************************************
+**
+*/	static void Run_Sort_Job(REBPSJB *job)
+/*
+***********************************************************************/
+{
+	REBPSRT *sort = job->sort;
+
+	if (job->merge)
+		Merge_Runs(sort, job->src, job->dst, job->lo, job->mid, job->hi);
+	else
+		Sort_Part(sort, job->lo, job->hi);
+
+	OS_Lock(sort->lock);
+	sort->pending--;
+	OS_Signal_Lock(sort->lock);
+	OS_Unlock(sort->lock);
+}
+
+
+/***********************************************************************
+**
+*/	static void Sort_Thread(REBPSJB *job)
+/*
+**		Thread entry of a sort job.
+**
+***********************************************************************/
+{
+	OS_Task_Ready(0);
+	Run_Sort_Job(job);
+}
+
+
+/***********************************************************************
+**
+*/	static void Run_Sort_Jobs(REBPSRT *sort, REBPSJB *jobs, REBCNT count)
+/*
+**		Runs the first job in the calling thread and the others in
+**		new threads (or also here, when a thread cannot be started).
+**		Returns when all jobs are done.
+**
+***********************************************************************/
+{
+	REBCNT n;
+
+	sort->pending = count;
+	for (n = 1; n < count; n++) {
+		if (OS_Create_Thread((CFUNC)Sort_Thread, &jobs[n], 0) < 0)
+			Run_Sort_Job(&jobs[n]);
+	}
+	Run_Sort_Job(&jobs[0]);
+
+	OS_Lock(sort->lock);
+	while (sort->pending > 0) OS_Wait_Lock(sort->lock, -1);
+	OS_Unlock(sort->lock);
+}
+
+
+/***********************************************************************
+**
+*/	REBFLG Parallel_Sort(void *base, size_t nmemb, size_t size, REBCNT threads, cmp_ctx_t *cmp, void *ctx)
+/*
+**		Stable sort of nmemb items of the size using the number of
+**		threads. Returns FALSE (and nothing is sorted) when there is
+**		no need for threads or they cannot be used.
+**
+***********************************************************************/
+{
+	REBPSRT sort;
+	REBPSJB jobs[PSORT_MAX_THREADS];
+	REBYTE *src, *dst, *swp;
+	size_t part, n;
+	REBCNT count;
+
+	if (threads > PSORT_MAX_THREADS) threads = PSORT_MAX_THREADS;
+	if (threads < 2 || nmemb < (size_t)threads * PSORT_MIN_RUN) return FALSE;
+
+	CLEARS(&sort);
+	sort.base = base;
+	sort.size = size;
+	sort.cmp  = cmp;
+	sort.ctx  = ctx;
+	if (!(sort.tmp = Make_Mem(nmemb * size))) return FALSE;
+	if (!(sort.lock = OS_Make_Lock())) {
+		Free_Mem(sort.tmp, nmemb * size);
+		return FALSE;
+	}
+
+	// Sort the parts:
+	part = (nmemb + threads - 1) / threads;
+	for (count = 0, n = 0; n < nmemb; n += part, count++) {
+		jobs[count].sort  = &sort;
+		jobs[count].merge = FALSE;
+		jobs[count].lo = n;
+		jobs[count].hi = MIN(n + part, nmemb);
+	}
+	Run_Sort_Jobs(&sort, jobs, count);
+
+	// Merge them in pairs until there is just one:
+	src = sort.base;
+	dst = sort.tmp;
+	for (; part < nmemb; part *= 2) {
+		for (count = 0, n = 0; n < nmemb; n += 2 * part, count++) {
+			jobs[count].sort  = &sort;
+			jobs[count].merge = TRUE;
+			jobs[count].src = src;
+			jobs[count].dst = dst;
+			jobs[count].lo  = n;
+			jobs[count].mid = MIN(n + part, nmemb);
+			jobs[count].hi  = MIN(n + 2 * part, nmemb);
+		}
+		Run_Sort_Jobs(&sort, jobs, count);
+		swp = src; src = dst; dst = swp;
+	}
+	if (src != sort.base) COPY_MEM(sort.base, src, nmemb * size);
+
+	OS_Free_Lock(sort.lock);
+	Free_Mem(sort.tmp, nmemb * size);
+	return TRUE;
+}
@@ -0,0 +1,169 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2026 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  f-radix-sort.c
+**  Summary: LSD radix sort of numbers and numeric keys
+**  Section: functional
+**  Author:  Oldes
+**  Notes:
+**    Numbers are sorted as unsigned integers, one byte per pass (least
+**    significant first). Signed integers and IEEE floats are transformed
+**    to keys with the same order before and back after the sort.
+**    Passes where all values have the same byte are skipped, so small
+**    integers need just one or two passes. The sort is stable.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define RADIX_SIZE 256
+
+// Sorts items by KEY bytes (least significant first) using the tmp buffer:
+#define RADIX_LSD(type, KEY, bytes) { \
+		type *src = (type *)data, *dst = (type *)tmp, *swp; \
+		REBLEN counts[8][RADIX_SIZE]; \
+		REBCNT b; \
+		REBLEN n, sum, t; \
+		CLEAR(counts, sizeof(counts)); \
+		for (n = 0; n < len; n++) { \
+			REBU64 k = (REBU64)KEY(src[n]); \
+			for (b = 0; b < (bytes); b++) counts[b][(k >> (8*b)) & 0xFF]++; \
+		} \
+		for (b = 0; b < (bytes); b++) { \
+			REBLEN *c = counts[b]; \
+			REBCNT shift = 8*b; \
+			if (c[((REBU64)KEY(src[0]) >> shift) & 0xFF] == len) continue; \
+			for (n = sum = 0; n < RADIX_SIZE; n++) { t = c[n]; c[n] = sum; sum += t; } \
+			for (n = 0; n < len; n++) dst[c[((REBU64)KEY(src[n]) >> shift) & 0xFF]++] = src[n]; \
+			swp = src; src = dst; dst = swp; \
+		} \
+		if (src != (type *)data) COPY_MEM(data, src, (size_t)len * sizeof(type)); \
+	}
+
+#define RADIX_VALUE(x) (x)
+#define RADIX_KEY(x)   ((x).key)
+
+// Transforms numbers to keys (and back) with the same unsigned order:
+#define RADIX_KEYS(type, bits, kind, reverse, back) { \
+		type *p = (type *)data; \
+		const type sign = (type)1 << ((bits) - 1); \
+		REBLEN n; \
+		for (n = 0; n < len; n++) { \
+			type x = p[n]; \
+			if (back && reverse) x = ~x; \
+			if (kind == RADIX_SIGNED) x ^= sign; \
+			else if (kind == RADIX_FLOAT) { \
+				if (back) x ^= (x & sign) ? sign : (type)~(type)0; \
+				else      x ^= (x & sign) ? (type)~(type)0 : sign; \
+			} \
+			if (!back && reverse) x = ~x; \
+			p[n] = x; \
+		} \
+	}
+
+
+/***********************************************************************
+**
+*/	static void Radix_Keys(void *data, REBLEN len, REBCNT width, REBCNT kind, REBFLG reverse, REBFLG back)
+/*
+***********************************************************************/
+{
+	if (kind == RADIX_UNSIGNED && !reverse) return;
+	switch (width) {
+	case 1: RADIX_KEYS(u8,   8, kind, reverse, back); break;
+	case 2: RADIX_KEYS(u16, 16, kind, reverse, back); break;
+	case 4: RADIX_KEYS(u32, 32, kind, reverse, back); break;
+	case 8: RADIX_KEYS(u64, 64, kind, reverse, back); break;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBFLG Radix_Sort(void *data, REBLEN len, REBCNT width, REBCNT kind, REBFLG reverse)
+/*
+**		Sorts numbers of the width (1, 2, 4 or 8 bytes) in place.
+**		Kind is RADIX_UNSIGNED, RADIX_SIGNED or RADIX_FLOAT.
+**		Returns FALSE when memory for the sort is not available.
+**
+***********************************************************************/
+{
+	size_t bytes = (size_t)len * width;
+	void *tmp;
+
+	if (len < 2) return TRUE;
+	if (width != 1 && width != 2 && width != 4 && width != 8) return FALSE;
+	if (!(tmp = Make_Mem(bytes))) return FALSE;
+
+	Radix_Keys(data, len, width, kind, reverse, FALSE);
+	switch (width) {
+	case 1: RADIX_LSD(u8,  RADIX_VALUE, 1); break;
+	case 2: RADIX_LSD(u16, RADIX_VALUE, 2); break;
+	case 4: RADIX_LSD(u32, RADIX_VALUE, 4); break;
+	case 8: RADIX_LSD(u64, RADIX_VALUE, 8); break;
+	}
+	Radix_Keys(data, len, width, kind, reverse, TRUE);
+
+	Free_Mem(tmp, bytes);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	REBFLG Radix_Sort_Keys(REBRDX *data, REBLEN len)
+/*
+**		Sorts items by their 64-bit keys (stable). The index of
+**		an item may be used to reorder the original data.
+**		Returns FALSE when memory for the sort is not available.
+**
+***********************************************************************/
+{
+	size_t bytes = (size_t)len * sizeof(REBRDX);
+	REBRDX *tmp;
+
+	if (len < 2) return TRUE;
+	if (!(tmp = Make_Mem(bytes))) return FALSE;
+	RADIX_LSD(REBRDX, RADIX_KEY, 8);
+	Free_Mem(tmp, bytes);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	REBU64 Radix_Decimal_Key(REBDEC d)
+/*
+**		Returns a key with the order of decimals. All NaNs are
+**		greater than other numbers and -0.0 is same as 0.0 (as in
+**		the Cmp_Value).
+**
+***********************************************************************/
+{
+	REBU64 x;
+
+#ifndef USE_NO_INFINITY
+	if (isnan(d)) return MAX_U64;
+#endif
+	if (d == 0.0) d = 0.0;
+	memcpy(&x, &d, sizeof(x));
+	return x ^ ((x >> 63) ? MAX_U64 : ((REBU64)1 << 63));
+}
@@ -31,6 +31,14 @@
 #include "sys-core.h"
 #include "sys-deci-funcs.h"
 
+#ifdef CPU_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
 /***********************************************************************
 **
 */	void REBCNT_To_Bytes(REBYTE *out, REBCNT in)
@@ -610,7 +618,23 @@
 ***********************************************************************/
 {
 	if (VAL_INDEX(value) >= VAL_TAIL(value)) return 0;
-	return (VAL_TAIL(value) - VAL_INDEX(value)) * SERIES_WIDE(VAL_SERIES(value));
+	return Series_Byte_Len(VAL_SERIES(value), VAL_TAIL(value) - VAL_INDEX(value));
+}
+
+
+/***********************************************************************
+**
+*/	REBCNT Series_Byte_Len(REBSER *series, REBCNT len)
+/*
+**		Get size in bytes of len units of the series, where it must
+**		fit a 32-bit length (binary!, device requests). Wide series
+**		(vectors) may be bigger, so it traps when it does not fit.
+**
+***********************************************************************/
+{
+	size_t size = (size_t)len * SERIES_WIDE(series);
+	if (size > MAX_SERIES_LEN) Trap0(RE_TOO_LONG);
+	return (REBCNT)size;
 }
 
 
@@ -972,7 +996,7 @@ FORCE_INLINE
 	wide = SERIES_WIDE(src);
 	ser = Make_Series(len, wide, FALSE);
 
-	COPY_MEM(ser->data, src->data + (VAL_INDEX(value) * wide), len * wide);
+	COPY_MEM(ser->data, SERIES_SKIP(src, VAL_INDEX(value)), (size_t)len * wide);
 	ser->tail = len;
 
 	return ser;
@@ -1025,3 +1049,58 @@ FORCE_INLINE
 	}
 	return 0;
 }
+
+
+/***********************************************************************
+**
+*/	REBCNT Get_CPU_Features(void)
+/*
+**		Returns CPU_* flags of features, which may be used by
+**		functions compiled for other than the default target.
+**
+***********************************************************************/
+{
+	static REBCNT known = 0;
+	REBCNT features = CPU_KNOWN;
+#ifdef CPU_X86
+	unsigned int r[4] = {0};
+	unsigned int max;
+#endif
+
+	if (known) return known;
+
+#ifdef CPU_X86
+#if defined(_MSC_VER)
+	__cpuid((int*)r, 0);
+	max = r[0];
+	__cpuid((int*)r, 1);
+#else
+	max = __get_cpuid_max(0, NULL);
+	if (max < 1) return known = features;
+	__cpuid(1, r[0], r[1], r[2], r[3]);
+#endif
+	if (r[2] & (1 << 20)) features |= CPU_SSE42;
+
+	if (max >= 7) {
+		// AVX2 needs also OS support of YMM registers (OSXSAVE and XCR0):
+		REBFLG ymm = FALSE;
+		if ((r[2] & (1 << 27)) && (r[2] & (1 << 28))) {
+#if defined(_MSC_VER)
+			ymm = (_xgetbv(0) & 6) == 6;
+#else
+			unsigned int lo, hi;
+			__asm__ __volatile__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+			ymm = (lo & 6) == 6;
+#endif
+		}
+#if defined(_MSC_VER)
+		__cpuidex((int*)r, 7, 0);
+#else
+		__cpuid_count(7, 0, r[0], r[1], r[2], r[3]);
+#endif
+		if (ymm && (r[1] & (1 << 5))) features |= CPU_AVX2;
+		if (r[1] & (1 << 29)) features |= CPU_SHA;
+	}
+#endif
+	return known = features;
+}
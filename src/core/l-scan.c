@@ -2117,12 +2117,40 @@ exit_block:
 }
 
 
+/***********************************************************************
+**
+*/	static REBVAL *Find_Scan_Error(REBSER *block)
+/*
+**		Returns the first error made by a relaxed scan (deep) or 0.
+**
+***********************************************************************/
+{
+	REBVAL *val;
+	REBVAL *err;
+
+	for (val = BLK_HEAD(block); NOT_END(val); val++) {
+		if (IS_ERROR(val)) return val;
+		if (ANY_BLOCK(val) && (err = Find_Scan_Error(VAL_SERIES(val)))) return err;
+	}
+	return 0;
+}
+
+
 /***********************************************************************
 **
 */	REBNATIVE(transcode)
 /*
 **		Allows BINARY! input only!
 **
+**		With /chunk the input is a buffer of a stream read in parts.
+**		A value is accepted only when it is followed by more input,
+**		so a value cut at the end of the buffer (or an error at its
+**		end, which may be caused by the cut) returns NONE and the
+**		caller reads the next chunk and scans again from the same
+**		position. An error followed by more input is thrown.
+**		Only one value is scanned at once, so the memory used is
+**		the buffer and the value (see TRANSCODE-EACH).
+**
 ***********************************************************************/
 {
 	SCAN_STATE scan_state;
@@ -2134,6 +2162,7 @@ exit_block:
 	REBOOL line  = D_REF(6);
 	REBVAL *count = D_ARG(7);
 	REBVAL *length = D_ARG(9);
+	REBOOL chunk = D_REF(10);
 	REBSER *blk;
 	REBSER *ser;
 	REBYTE *bin;
@@ -2157,9 +2186,9 @@ exit_block:
 
     Init_Scan_State(&scan_state, bin, len);
 
-	if (next || one) SET_FLAG(scan_state.opts, SCAN_NEXT);
+	if (next || one || chunk) SET_FLAG(scan_state.opts, SCAN_NEXT);
 	if (only)  SET_FLAG(scan_state.opts, SCAN_ONLY);
-	if (relax) SET_FLAG(scan_state.opts, SCAN_RELAX);
+	if (relax || chunk) SET_FLAG(scan_state.opts, SCAN_RELAX); // errors are counted
 	if (line) {
 		if (0 >= VAL_INT64(count)) Trap1(RE_OUT_OF_RANGE, count);
 		scan_state.line_count = VAL_UNT32(count);
@@ -2172,9 +2201,23 @@ exit_block:
 	blk = Scan_Code(&scan_state, 0);
 	DS_RELOAD(ds); // in case stack moved
 
-	if (end_pos != NO_LIMIT)
+	if (end_pos != NO_LIMIT) {
 		bin[end_pos] = end_char;
-	
+		len = end_pos;
+	}
+
+	if (chunk && scan_state.errors && scan_state.end < bin + len) {
+		// More input follows, so the error is not caused by the cut:
+		REBVAL *err = Find_Scan_Error(blk);
+		if (err) Throw_Error(VAL_ERR_OBJECT(err));
+	}
+
+	if (chunk && (
+		scan_state.errors
+		|| scan_state.end >= bin + len
+		|| IS_END(BLK_HEAD(blk))
+	)) return R_NONE; // needs more input
+
 	if (next && IS_END((REBVAL*)BLK_SKIP(blk, 0))) {
 		if (relax) {
 			ser = Make_Error(RE_PAST_END, src, 0, 0);
@@ -77,6 +77,26 @@
 **
 **		DONE flag - do not scan the series; it has no links.
 **
+**	  Generational mode (USE_GENERATIONAL_GC):
+**
+**		Every series that survives a recycle is promoted to the old
+**		generation (SER_OLD flag). Automatic recycles are then mostly
+**		minor ones, which do not trace old series and free only the
+**		young ones. Old blocks modified since the last recycle are
+**		found in the remembered set (filled by the GC_BARRIER write
+**		barrier). Roots, the data stack, task buffers and ports with
+**		pending requests are modified without the barrier, so a minor
+**		recycle always scans their content. Each MAX_MINOR_RECYCLES-th
+**		and every manual RECYCLE is a full one.
+**
+**	  Tasks (INCLUDE_TASK):
+**
+**		Each task recycles only its own heap. Series made by other
+**		tasks (see SERIES_HEAP) are neither marked nor traced, as
+**		their flags may be changed by the owner at the same time.
+**		Shared values (natives, mezzanines, word table) belong to
+**		the main task and are kept alive by it.
+**
 ***********************************************************************/
 
 #include "sys-core.h"
@@ -109,8 +129,20 @@ REBVAL *N_watch(REBFRM *frame, REBVAL **inter_block)
 
 extern REBDEV *Devices[];
 
+#ifdef INCLUDE_TASK
+// Series of other tasks are not marked here (see notes above):
+#define IS_OWN_SERIES(s) (SERIES_HEAP(s) == Task_Heap)
+#undef  MARK_SERIES
+#define MARK_SERIES(s) (IS_OWN_SERIES(s) ? SERIES_SET_FLAG(s, SER_MARK) : 0)
+#else
+#define IS_OWN_SERIES(s) TRUE
+#endif
+
 static void Mark_Series(REBSER *series, REBCNT depth);
 static void Mark_Value(REBVAL *val, REBCNT depth);
+#ifdef USE_GENERATIONAL_GC
+static void Mark_Root_Series(REBSER *series, REBCNT levels);
+#endif
 
 /***********************************************************************
 **
@@ -275,8 +307,17 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	for (d = 0; d < RDI_MAX; d++) {
 		dev = devices[d];
 		if (dev)
-			for (req = dev->pending; req; req = req->next)
-				if (req->port) CHECK_MARK((REBSER*)req->port, depth);
+			for (req = dev->pending; req; req = req->next) {
+				if (!req->port) continue;
+#ifdef USE_GENERATIONAL_GC
+				// Pending ports are updated by devices without the barrier:
+				if (GC_Minor) {
+					Mark_Root_Series((REBSER*)req->port, 2);
+					continue;
+				}
+#endif
+				CHECK_MARK((REBSER*)req->port, depth);
+			}
 	}
 }
 
@@ -295,24 +336,15 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 
 /***********************************************************************
 **
-*/	static void Mark_Series(REBSER *series, REBCNT depth)
+*/	static void Mark_Series_Values(REBSER *series, REBCNT depth)
 /*
-**		Mark all series reachable from the block.
+**		Mark all series reachable from the values of the block.
 **
 ***********************************************************************/
 {
 	REBCNT len;
 	REBVAL *val;
 
-	ASSERT(series != 0, RP_NULL_MARK_SERIES);
-
-	if (SERIES_FREED(series)) return; // series data freed already
-
-	MARK_SERIES(series);
-
-	// If not a block, go no further
-	if (SERIES_WIDE(series) != sizeof(REBVAL) || IS_BARE_SERIES(series)) return;
-
 	ASSERT2(RP_SERIES_OVERFLOW, SERIES_TAIL(series) < SERIES_REST(series));
 
 	//Moved to end: ASSERT1(IS_END(BLK_TAIL(series)), RP_MISSING_END);
@@ -344,6 +376,185 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 }
 
 
+/***********************************************************************
+**
+*/	static void Mark_Series(REBSER *series, REBCNT depth)
+/*
+**		Mark all series reachable from the block.
+**
+***********************************************************************/
+{
+	ASSERT(series != 0, RP_NULL_MARK_SERIES);
+
+	if (SERIES_FREED(series)) return; // series data freed already
+	if (!IS_OWN_SERIES(series)) return; // owned by other task
+
+#ifdef USE_GENERATIONAL_GC
+	// Minor recycle does not trace the old generation:
+	if (GC_Minor && IS_OLD_SERIES(series)) return;
+#endif
+
+	MARK_SERIES(series);
+
+	// If not a block, go no further
+	if (SERIES_WIDE(series) != sizeof(REBVAL) || IS_BARE_SERIES(series)) return;
+
+	Mark_Series_Values(series, depth);
+}
+
+
+#ifdef USE_GENERATIONAL_GC
+/***********************************************************************
+**
+*/	static void Mark_Root_Series(REBSER *series, REBCNT levels)
+/*
+**		Minor recycle: mark series reachable from a root even when
+**		the root is old. Roots are modified without the write barrier,
+**		so their values (up to given levels of nested blocks and
+**		objects) are always scanned.
+**
+***********************************************************************/
+{
+	REBCNT len;
+	REBVAL *val;
+
+	if (SERIES_FREED(series) || !IS_OWN_SERIES(series)) return;
+
+	if (!IS_OLD_SERIES(series) || levels == 0) {
+		CHECK_MARK(series, 0);
+		return;
+	}
+
+	if (SERIES_WIDE(series) != sizeof(REBVAL) || IS_BARE_SERIES(series)) return;
+
+	for (len = 0; len < series->tail; len++) {
+		val = BLK_SKIP(series, len);
+		if (IS_END(val)) break; // the data stack
+		if (ANY_BLOCK(val))
+			Mark_Root_Series(VAL_SERIES(val), levels - 1);
+		else if (ANY_OBJECT(val))
+			Mark_Root_Series(VAL_OBJ_FRAME(val), levels - 1);
+		else if (!ANY_SCALAR(val))
+			Mark_Value(val, 1);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	void Remember_Series(REBSER *series)
+/*
+**		Write barrier (slow path). Add an old block to the remembered
+**		set, so the next minor recycle scans its values.
+**		Use the GC_BARRIER macro instead of calling it directly.
+**
+***********************************************************************/
+{
+	SERIES_SET_FLAG(series, SER_REMB);
+	if (SERIES_FULL(GC_Remembered)) Extend_Series(GC_Remembered, 64);
+	((REBSER **)GC_Remembered->data)[GC_Remembered->tail++] = series;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Sweep_Young_Series(void)
+/*
+**		Free all unmarked young series and promote the marked ones.
+**		Old series are kept (minor recycle does not mark them).
+**
+***********************************************************************/
+{
+	REBSEG	*seg;
+	REBSER	*series;
+	REBCNT  n;
+	REBCNT	count = 0;
+
+	for (seg = Mem_Pools[SERIES_POOL].segs; seg; seg = seg->next) {
+		series = (REBSER *) (seg + 1);
+		for (n = Mem_Pools[SERIES_POOL].units; n > 0; n--) {
+			SKIP_WALL(series);
+			MUNG_CHECK(SERIES_POOL, series, sizeof(*series));
+			if (!SERIES_FREED(series)) {
+				if (!IS_OLD_SERIES(series) && IS_FREEABLE(series)) {
+					Free_Series(series);
+					count++;
+				} else {
+					// Survivor (or old leaf series marked by value):
+					SERIES_CLR_FLAG(series, SER_MARK | SER_REMB);
+					SERIES_SET_FLAG(series, SER_OLD);
+				}
+			}
+			series++;
+			SKIP_WALL(series);
+		}
+	}
+
+	return count;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Recycle_Minor(void)
+/*
+**		Recycle the young generation only.
+**		Returns number of released series.
+**
+***********************************************************************/
+{
+	REBINT n;
+	REBSER **sp;
+	REBSER *ser;
+	REBCNT count;
+
+	GC_Minor = TRUE;
+
+	// Old blocks modified since last recycle (the remembered set):
+	sp = (REBSER **)GC_Remembered->data;
+	for (n = SERIES_TAIL(GC_Remembered); n > 0; n--) {
+		ser = *sp++;
+		// It may be freed (or even reused) since it was remembered:
+		if (!SERIES_FREED(ser) && SERIES_GET_FLAG(ser, SER_REMB))
+			Mark_Root_Series(ser, 1);
+	}
+
+	// Temp-saved and guarded series:
+	sp = (REBSER **)GC_Protect->data;
+	for (n = SERIES_TAIL(GC_Protect); n > 0; n--) Mark_Root_Series(*sp++, 1);
+	sp = (REBSER **)GC_Series->data;
+	for (n = SERIES_TAIL(GC_Series); n > 0; n--) Mark_Root_Series(*sp++, 1);
+
+	// Infants:
+	for (n = 0; n < MAX_SAFE_SERIES; n++) {
+		if (NZ(ser = GC_Infants[n])) Mark_Root_Series(ser, 1);
+		else break;
+	}
+
+	MARK_SERIES(GC_Mark_Queue);
+
+	// Root and task series hold system buffers and the data stack:
+	Mark_Root_Series(VAL_SERIES(ROOT_ROOT), 2);
+	Mark_Root_Series(Task_Series, 2);
+
+	if (!Task_Heap) Mark_Devices(0);
+
+	while (GC_Mark_Queue->tail > 0) {
+		Mark_Series(((REBSER**)GC_Mark_Queue->data)[--GC_Mark_Queue->tail], 0);
+	}
+
+	// Gobs and handles are swept only by a full recycle, because
+	// the minor one does not see those linked from old series.
+	count = Sweep_Young_Series();
+
+	RESET_TAIL(GC_Remembered);
+	GC_Minor = FALSE;
+
+	return count;
+}
+#endif
+
+
 /***********************************************************************
 **
 */	static void Mark_Value(REBVAL *val, REBCNT depth)
@@ -552,8 +763,13 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 					//printf("free: %0xh %s\n", (int)series, series->label);
 					Free_Series(series);
 					count++;
-				} else
+				} else {
 					UNMARK_SERIES(series);
+#ifdef USE_GENERATIONAL_GC
+					SERIES_CLR_FLAG(series, SER_REMB);
+					SERIES_SET_FLAG(series, SER_OLD);
+#endif
+				}
 			}
 			series++;
 			SKIP_WALL(series);
@@ -648,17 +864,21 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 **
 **      When all is TRUE, then infant series are not protected!
 **
+**		In generational mode, automatic recycles (all and pools are
+**		FALSE) are minor ones, except each MAX_MINOR_RECYCLES-th.
+**
 ***********************************************************************/
 {
 	REBINT n;
 	REBSER **sp;
 	REBCNT count;
+	REBI64 base;
 
 	//Debug_Num("GC", GC_Disabled);
 
 	// If disabled, exit now but set the pending flag.
 	if (GC_Disabled || !GC_Active) {
-		SET_SIGNAL(SIG_RECYCLE);
+		SET_TASK_SIGNAL(SIG_RECYCLE);
 		//Print("pending");
 		return 0;
 	}
@@ -666,8 +886,8 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	if (Reb_Opts->watch_recycle) Debug_Str(cs_cast(BOOT_STR(RS_WATCH, 0)));
 #endif
 	GC_Disabled = 1;
+	base = OS_Delta_Time(0, 0); // pause time
 
-	PG_Reb_Stats->Recycle_Counter++;
 	PG_Reb_Stats->Recycle_Series = Mem_Pools[SERIES_POOL].free;
 
 	//printf("PG_Mem_Usage: %llu\n", PG_Mem_Usage);
@@ -685,6 +905,19 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	VAL_BLK_TERM(TASK_BUF_WORDS);
 //!!!	SET_END(BLK_TAIL(Save_Value_List));
 
+#ifdef USE_GENERATIONAL_GC
+	if (!all && !pools && GC_Minor_Count < MAX_MINOR_RECYCLES) {
+		GC_Minor_Count++;
+		PG_Reb_Stats->Recycle_Minor_Counter++;
+		count = Recycle_Minor();
+		PG_Reb_Stats->Recycle_Minor_Time += OS_Delta_Time(base, 0);
+		goto done;
+	}
+	GC_Minor_Count = 0;
+	RESET_TAIL(GC_Remembered); // all survivors will be old
+#endif
+	PG_Reb_Stats->Recycle_Counter++;
+
 	// Mark series stack (temp-saved series):
 	sp = (REBSER **)GC_Protect->data;
 	for (n = SERIES_TAIL(GC_Protect); n > 0; n--) {
@@ -717,8 +950,8 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	Mark_Series(VAL_SERIES(ROOT_ROOT), 0);
 	Mark_Series(Task_Series, 0);
 
-	// Mark all devices:
-	Mark_Devices(0);
+	// Mark all devices (requests are done by the main task only):
+	if (!Task_Heap) Mark_Devices(0);
 
 	// Mark series queued to avoid a stack overflow in case of deep recursion
 	while (GC_Mark_Queue->tail > 0) {
@@ -734,6 +967,11 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	// Otherwise, check only pools where usage is less than 20%.
 	Free_Empty_Pool_Segments(pools ? 90 : 20);
 
+	PG_Reb_Stats->Recycle_Time += OS_Delta_Time(base, 0);
+
+#ifdef USE_GENERATIONAL_GC
+done:
+#endif
 	CHECK_MEMORY(4);
 
 	// Compute new stats:
@@ -832,6 +1070,12 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	GC_Mark_Queue = Make_Series(15, sizeof(REBSER*), FALSE);
 	BARE_SERIES(GC_Mark_Queue);
 	LABEL_SERIES(GC_Mark_Queue, "gc mark queue");
+
+	// Old blocks modified since last recycle (see GC_BARRIER).
+	GC_Minor = FALSE;
+	GC_Minor_Count = 0;
+	GC_Remembered = Make_Series(63, sizeof(REBSER*), FALSE);
+	KEEP_SERIES(GC_Remembered, "gc remembered");
 }
 
 /***********************************************************************
@@ -852,6 +1096,7 @@ static void Mark_Value(REBVAL *val, REBCNT depth);
 	}
 	Free_Series(GC_Protect);
 	Free_Series(GC_Series);
+	Free_Series(GC_Remembered);
 	Sweep_Series();
 	Sweep_Gobs();
 	Free_Mem(GC_Infants, sizeof(REBSER*) * (MAX_SAFE_SERIES + 2));
@@ -62,6 +62,11 @@
 
 //#define GC_TRIGGER (GC_Active && (GC_Ballast <= 0 || (GC_Pending && !GC_Disabled)))
 
+// The ballast is 32-bit, so a series larger than the ballast just
+// requests a recycle (and is not counted):
+#define USE_BALLAST(n) \
+	if ((n) >= (size_t)VAL_INT32(TASK_BALLAST) || (GC_Ballast -= (REBINT)(n)) <= 0) SET_TASK_SIGNAL(SIG_RECYCLE)
+
 #ifdef POOL_MAP
 #define FIND_POOL(n) ((n <= 4 * MEM_BIG_SIZE) ? (REBCNT)(PG_Pool_Map[n]) : SYSTEM_POOL)
 #else
@@ -308,6 +313,13 @@ FORCE_INLINE
 		if (Mem_Pools[n].units < 2) Mem_Pools[n].units = 2;
 	}
 
+	// Pools are per task, but the pool map and spare segments are
+	// shared by all tasks, so these are made only by the boot call:
+	if (PG_Pool_Map) return;
+
+	PG_Pool_Spares = Make_Clear_Mem(sizeof(REBSPR), MAX_POOLS);
+	PG_Pool_Lock = OS_Make_Lock();
+
 	// For pool lookup. Maps size to pool index. (See Find_Pool below)
 	PG_Pool_Map = Make_CMem((4 * MEM_BIG_SIZE) + 4); // extra
 	n = 9;  // sizes 0 - 8 are pool 0
@@ -351,6 +363,37 @@ FORCE_INLINE
 #endif
 
 
+/***********************************************************************
+**
+*/	static REBSEG *Take_Spare_Segment(REBCNT pool_id, REBCNT mem_size)
+/*
+**		Reuse an empty segment handed back by an ended task.
+**		Only a segment of the same size may be used.
+**
+***********************************************************************/
+{
+	REBSPR *spare = &PG_Pool_Spares[pool_id];
+	REBSEG **link;
+	REBSEG *seg = 0;
+
+	// Pools are refilled rarely, so the list is only ever read under
+	// the lock; ending tasks may be pushing to it at the same time.
+	OS_Lock(PG_Pool_Lock);
+	for (link = &spare->segs; *link; link = &(*link)->next) {
+		if ((*link)->size == mem_size) {
+			seg = *link;
+			*link = seg->next;
+			spare->count--;
+			break;
+		}
+	}
+	OS_Unlock(PG_Pool_Lock);
+
+	if (seg) CLEAR(seg, mem_size); // same state as a new segment
+	return seg;
+}
+
+
 /***********************************************************************
 **
 */	static void Fill_Pool(REBPOL *pool)
@@ -372,7 +415,8 @@ FORCE_INLINE
 	REBCNT	mem_size = pool->wide * units + sizeof(REBSEG);
 #endif
 
-	seg = (REBSEG *) Make_CMem(mem_size);
+	seg = Take_Spare_Segment((REBCNT)(pool - Mem_Pools), mem_size);
+	if (!seg) seg = (REBSEG *) Make_CMem(mem_size);
 	if (!seg) Crash(RP_NO_MEMORY, mem_size);
 
 	seg->size = mem_size;
@@ -465,11 +509,15 @@ FORCE_INLINE
 	REBNOD *node;
 	REBPOL *pool;
 	REBCNT pool_num;
+	size_t size;
 
 //	if (GC_TRIGGER) Recycle(FALSE);
 
-	length *= SERIES_WIDE(series);
-	pool_num = FIND_POOL(length);
+	if (length > MAX_SERIES_LEN || (REBU64)length * SERIES_WIDE(series) > MAX_SERIES_SIZE)
+		Trap0(RE_NO_MEMORY);
+
+	size = (size_t)length * SERIES_WIDE(series);
+	pool_num = FIND_POOL(size);
 	if (pool_num < SYSTEM_POOL) {
 		pool = &Mem_Pools[pool_num];
 		if (!pool->first) Fill_Pool(pool);
@@ -477,42 +525,42 @@ FORCE_INLINE
 #pragma warning(suppress: 28182)
 		pool->first = *node;
 		pool->free--;
-		length = pool->wide;
+		size = pool->wide;
 #ifdef WATCH_SERIES_POOL
-		if(pool_num == SERIES_POOL) printf(cs_cast("*** SERIES_POOL Make_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SERIES_POOL].has, Mem_Pools[SERIES_POOL].free, length);
+		if(pool_num == SERIES_POOL) printf(cs_cast("*** SERIES_POOL Make_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SERIES_POOL].has, Mem_Pools[SERIES_POOL].free, (REBCNT)size);
 #endif
 	} else {
-		length = ALIGN(length, 2048);
+		size = ALIGN(size, 2048);
 #ifdef DEBUGGING
-		Debug_Fmt_Num("Alloc1:", length);
+		Debug_Fmt_Num("Alloc1:", (REBINT)size);
 #endif
 #ifdef MUNGWALL
-		node = (REBNOD *) Make_Mem(length+2*MUNG_SIZE);
+		node = (REBNOD *) Make_Mem(size+2*MUNG_SIZE);
 #else
-		node = (REBNOD *) Make_CMem(length);
+		node = (REBNOD *) Make_CMem(size);
 #endif
 		if (!node) Trap0(RE_NO_MEMORY);
 #ifdef MUNGWALL
 		memcpy((REBYTE *)node,MUNG_PATTERN1,MUNG_SIZE);
-		memcpy(((REBYTE *)node)+length+MUNG_SIZE,MUNG_PATTERN2,MUNG_SIZE);
+		memcpy(((REBYTE *)node)+size+MUNG_SIZE,MUNG_PATTERN2,MUNG_SIZE);
 		node=(REBNOD *)(((REBYTE *)node)+MUNG_SIZE);
 #endif
 		// NOTE: for this special pool, the values `has` and `free` have different meanings!
-		// `has`  - total number of large series bytes allocated
+		// `has`  - total number of large series bytes allocated (modulo 4GB)
 		// `free` - number of allocated large series 
-		Mem_Pools[SYSTEM_POOL].has += length;
+		Mem_Pools[SYSTEM_POOL].has += (REBCNT)size;
 		Mem_Pools[SYSTEM_POOL].free++;
 #ifdef WATCH_SYSTEM_POOL
-		printf(cs_cast("*** SYSTEM_POOL Make_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SYSTEM_POOL].has, Mem_Pools[SYSTEM_POOL].free, length);
+		printf(cs_cast("*** SYSTEM_POOL Make_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SYSTEM_POOL].has, Mem_Pools[SYSTEM_POOL].free, (REBCNT)size);
 #endif
 	}
 #ifdef CHAFF
-	memset((REBYTE *)node, 0xff, length);
+	memset((REBYTE *)node, 0xff, size);
 #endif
 	series->tail = 0;
-	SERIES_REST(series) = length / SERIES_WIDE(series);
+	SERIES_REST(series) = (REBCNT)(size / SERIES_WIDE(series));
 	series->data = (REBYTE *)node;
-	if ((GC_Ballast -= length) <= 0) SET_SIGNAL(SIG_RECYCLE);
+	USE_BALLAST(size);
 	return series;
 }
 
@@ -533,20 +581,21 @@ FORCE_INLINE
 	REBNOD *node;
 	REBPOL *pool;
 	REBCNT pool_num;
+	size_t size;
 
 	CHECK_STACK(&series);
 
-	if (((REBU64)length * wide) > MAX_I32) Trap0(RE_NO_MEMORY);
+	if (length > MAX_SERIES_LEN || ((REBU64)length * wide) > MAX_SERIES_SIZE) Trap0(RE_NO_MEMORY);
 
 	ASSERT(wide != 0, RP_BAD_SERIES);
 
 //	if (GC_TRIGGER) Recycle(FALSE);
 
 	series = (REBSER *)Make_Node(SERIES_POOL);
-	length *= wide;
-	ASSERT(length != 0, RP_BAD_SERIES);
+	size = (size_t)length * wide;
+	ASSERT(size != 0, RP_BAD_SERIES);
 
-	pool_num = FIND_POOL(length);
+	pool_num = FIND_POOL(size);
 	if (pool_num < SYSTEM_POOL) {
 		pool = &Mem_Pools[pool_num];
 		if (!pool->first) Fill_Pool(pool);
@@ -554,24 +603,27 @@ FORCE_INLINE
 #pragma warning(suppress: 28182)
 		pool->first = *node;
 		pool->free--;
-		length = pool->wide;
+		size = pool->wide;
 #pragma warning(suppress: 28183)
-		memset(node, 0, length);
+		memset(node, 0, size);
 #ifdef WATCH_SERIES_POOL
-		if(pool_num == SERIES_POOL) printf(cs_cast("*** SERIES_POOL Make_Series=> has: %u free: %u (size: %u)\n"), Mem_Pools[SERIES_POOL].has, Mem_Pools[SERIES_POOL].free, length);
+		if(pool_num == SERIES_POOL) printf(cs_cast("*** SERIES_POOL Make_Series=> has: %u free: %u (size: %u)\n"), Mem_Pools[SERIES_POOL].has, Mem_Pools[SERIES_POOL].free, (REBCNT)size);
 #endif
 	} else {
-		if (powerof2) {
+		// Doubling is not used for series over 1GB (it would waste too much):
+		if (powerof2 && size <= (1 << 30)) {
+			length = (REBCNT)size;
 			U32_ROUND_UP_POWER_OF_2(length);
+			size = length;
 		} else
-			length = ALIGN(length, 1024);
+			size = ALIGN(size, 1024);
 #ifdef DEBUGGING
-			Debug_Num("Alloc2:", length);
+			Debug_Num("Alloc2:", (REBINT)size);
 #endif
 #ifdef MUNGWALL
-		node = (REBNOD *) Make_CMem(length+2*MUNG_SIZE);
+		node = (REBNOD *) Make_CMem(size+2*MUNG_SIZE);
 #else
-		node = (REBNOD *) Make_CMem(length);
+		node = (REBNOD *) Make_CMem(size);
 #endif
 		if (!node) {
 			Free_Node(SERIES_POOL, (REBNOD *)series);
@@ -579,26 +631,26 @@ FORCE_INLINE
 		}
 #ifdef MUNGWALL
 		memcpy((REBYTE *)node,MUNG_PATTERN1,MUNG_SIZE);
-		memcpy(((REBYTE *)node)+length+MUNG_SIZE,MUNG_PATTERN2,MUNG_SIZE);
+		memcpy(((REBYTE *)node)+size+MUNG_SIZE,MUNG_PATTERN2,MUNG_SIZE);
 		node=(REBNOD *)(((REBYTE *)node)+MUNG_SIZE);
 #endif
-		Mem_Pools[SYSTEM_POOL].has += length;
+		Mem_Pools[SYSTEM_POOL].has += (REBCNT)size;
 		Mem_Pools[SYSTEM_POOL].free++;
 #ifdef WATCH_SYSTEM_POOL
-		printf(cs_cast("*** SYSTEM_POOL Make_Series => has: %u free: %u (size: %u)\n"), Mem_Pools[SYSTEM_POOL].has, Mem_Pools[SYSTEM_POOL].free, length);
+		printf(cs_cast("*** SYSTEM_POOL Make_Series => has: %u free: %u (size: %u)\n"), Mem_Pools[SYSTEM_POOL].has, Mem_Pools[SYSTEM_POOL].free, (REBCNT)size);
 #endif
 	}
 #ifdef CHAFF
-	memset((REBYTE *)node, 0xff, length);
+	memset((REBYTE *)node, 0xff, size);
 #endif
 	series->tail = series->size = 0;
-	SERIES_REST(series) = length / wide; //FIXME: This is based on the assumption that length is multiple of wide
+	SERIES_REST(series) = (REBCNT)(size / wide); //FIXME: This is based on the assumption that size is multiple of wide
 	series->data = (REBYTE *)node;
-	series->sizes = wide; // also clears bias
+	series->sizes = wide | (Task_Heap << 8); // also clears bias
 	SERIES_FLAGS(series) = 0;
 	LABEL_SERIES(series, "make");
 
-	if ((GC_Ballast -= length) <= 0) SET_SIGNAL(SIG_RECYCLE);
+	USE_BALLAST(size);
 
 	// Keep the last few series in the nursery, safe from GC:
 	if (GC_Last_Infant >= MAX_SAFE_SERIES) GC_Last_Infant = 0;
@@ -607,7 +659,44 @@ FORCE_INLINE
 	CHECK_MEMORY(2);
 
 	PG_Reb_Stats->Series_Made++;
-	PG_Reb_Stats->Series_Memory += length;
+	PG_Reb_Stats->Series_Memory += size;
+
+	if (Sampler) Sample_Alloc();
+
+	return series;
+}
+
+
+/***********************************************************************
+**
+*/	REBSER *Make_Mmap_Series(REBYTE *data, REBCNT length)
+/*
+**		Make a binary series for data of a memory mapped file
+**		(see read/mmap). The data is not owned by the memory pools,
+**		so it is never moved or compacted. It is protected (and locked) from
+**		modification and unmapped when the series is freed.
+**		The mapping must have room for the terminator after length.
+**
+***********************************************************************/
+{
+	REBSER *series;
+
+	CHECK_STACK(&series);
+
+	series = (REBSER *)Make_Node(SERIES_POOL);
+	series->tail = length;
+	series->size = 0;
+	SERIES_REST(series) = length + 1; // includes the terminator
+	series->data = data;
+	series->sizes = 1 | (Task_Heap << 8);
+	SERIES_FLAGS(series) = SER_EXT | SER_MMAP | SER_PROT | SER_LOCK; // locked, so UNPROTECT is not possible
+	LABEL_SERIES(series, "mmap");
+
+	// Keep the last few series in the nursery, safe from GC:
+	if (GC_Last_Infant >= MAX_SAFE_SERIES) GC_Last_Infant = 0;
+	GC_Infants[GC_Last_Infant++] = series;
+
+	PG_Reb_Stats->Series_Made++;
 
 	return series;
 }
@@ -625,7 +714,7 @@ FORCE_INLINE
 	REBNOD *node;
 	REBPOL *pool;
 	REBCNT pool_num;
-	REBCNT size;
+	size_t size;
 
 	// !!!! Dump_Series(series, "Free-Data");
 
@@ -633,11 +722,11 @@ FORCE_INLINE
 	if (IS_EXT_SERIES(series)) goto clear_header;  // Must be library related
 
 	size = SERIES_TOTAL(series);
-	if ((GC_Ballast += size) > VAL_INT32(TASK_BALLAST))
+	if (size >= (size_t)VAL_INT32(TASK_BALLAST) || (GC_Ballast += (REBINT)size) > VAL_INT32(TASK_BALLAST))
 		GC_Ballast = VAL_INT32(TASK_BALLAST);
 
 	// GC may no longer be necessary:
-	if (GC_Ballast > 0) CLR_SIGNAL(SIG_RECYCLE);
+	if (GC_Ballast > 0) CLR_TASK_SIGNAL(SIG_RECYCLE);
 
 	series->data -= SERIES_WIDE(series) * SERIES_BIAS(series);
 	node = (REBNOD *)series->data;
@@ -662,7 +751,7 @@ FORCE_INLINE
 		pool->free++;
 		PG_Reb_Stats->Series_Memory -= size;
 #ifdef WATCH_SERIES_POOL
-		if(pool_num == SERIES_POOL) printf(cs_cast("*** SERIES_POOL Free_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SERIES_POOL].has, Mem_Pools[SERIES_POOL].free, size);
+		if(pool_num == SERIES_POOL) printf(cs_cast("*** SERIES_POOL Free_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SERIES_POOL].has, Mem_Pools[SERIES_POOL].free, (REBCNT)size);
 #endif
 	} else {
 #ifdef MUNGWALL
@@ -670,10 +759,10 @@ FORCE_INLINE
 #else
 		Free_Mem(node, size);
 #endif
-		Mem_Pools[SYSTEM_POOL].has -= size; // number of bytes allocated for large series
+		Mem_Pools[SYSTEM_POOL].has -= (REBCNT)size; // number of bytes allocated for large series
 		Mem_Pools[SYSTEM_POOL].free--;      // reversed meaning!
 #ifdef WATCH_SYSTEM_POOL
-		printf(cs_cast("*** SYSTEM_POOL Free_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SYSTEM_POOL].has, Mem_Pools[SYSTEM_POOL].free, size);
+		printf(cs_cast("*** SYSTEM_POOL Free_Series_Data=> has: %u free: %u (size: %u)\n"), Mem_Pools[SYSTEM_POOL].has, Mem_Pools[SYSTEM_POOL].free, (REBCNT)size);
 #endif
 	}
 
@@ -703,7 +792,10 @@ clear_header:
 	}
 #endif
 	PG_Reb_Stats->Series_Freed++;
-	PG_Reb_Stats->Series_Memory -= SERIES_TOTAL(series);
+	if (IS_MMAP_SERIES(series))
+		OS_Unmap_File(series->data - SERIES_BIAS(series), SERIES_REST(series) + SERIES_BIAS(series));
+	else
+		PG_Reb_Stats->Series_Memory -= SERIES_TOTAL(series);
 
 	// Remove series from expansion list, if found:
 	for (n = 1; n < MAX_EXPAND_LIST; n++) {
@@ -956,7 +1048,7 @@ crash:
 							  "Dump",
 							  series,
 							  SERIES_WIDE(series),
-							  SERIES_TOTAL(series),
+							  (REBCNT)SERIES_TOTAL(series),
 							  SERIES_BIAS(series),
 							  SERIES_TAIL(series),
 							  SERIES_REST(series),
@@ -1220,7 +1312,7 @@ static void Free_Empty_Segment(REBPOL* pool, REBSEG* seg)
 				if (f) Debug_Fmt_(cb_cast("ODD[%d]"), SERIES_WIDE(series));
 			}
 			if (f && SERIES_WIDE(series)) {
-				Debug_Fmt(cb_cast(" units: %-5d tail: %-5d bytes: %-7d"), SERIES_REST(series), SERIES_TAIL(series), SERIES_TOTAL(series));
+				Debug_Fmt(cb_cast(" units: %-5d tail: %-5d bytes: %-7d"), SERIES_REST(series), SERIES_TAIL(series), (REBCNT)SERIES_TOTAL(series));
 			}
 
 			series++;
@@ -1290,22 +1382,16 @@ static void Free_Empty_Segment(REBPOL* pool, REBSEG* seg)
 
 /***********************************************************************
 **
-*/	void Dispose_Pools(void)
+*/	static void Free_Pool_Series(void)
 /*
-**		Free memory pool array when application quits.
-**
-**		NOTE: Don't use any Debug_* or Dump_* functions!
-**		      These depends on resources not available anymore.
+**		Free all series still allocated in the pools.
 **
 ***********************************************************************/
 {
-	REBSEG	*seg, *next;
-	REBCNT  n;
+	REBSEG	*seg;
 	REBSER  *series;
 	REBCNT  count;
 
-	//puts("===== Dispose_Pools ======");
-
 	for (seg = Mem_Pools[SERIES_POOL].segs; seg; seg = seg->next) {
 		series = (REBSER*)(seg + 1);
 		for (count = Mem_Pools[SERIES_POOL].units; count > 0; count--) {
@@ -1332,6 +1418,62 @@ static void Free_Empty_Segment(REBPOL* pool, REBSEG* seg)
 			SKIP_WALL(series);
 		}
 	}
+}
+
+
+/***********************************************************************
+**
+*/	void Release_Pools(void)
+/*
+**		Free memory pool array of an ended task. Its segments are
+**		handed back in one batch to the shared spares, so other
+**		tasks can refill their pools without a new allocation.
+**
+***********************************************************************/
+{
+	REBSEG	*seg, *next;
+	REBSPR	*spare;
+	REBCNT  n;
+
+	Free_Pool_Series();
+
+	OS_Lock(PG_Pool_Lock);
+	FOREACH(n, SYSTEM_POOL) {
+		spare = &PG_Pool_Spares[n];
+		for (seg = Mem_Pools[n].segs; seg; seg = next) {
+			next = seg->next;
+			if (spare->count < MAX_SPARE_SEGS) {
+				seg->next = spare->segs;
+				spare->segs = seg;
+				spare->count++;
+			}
+			else Free_Mem(seg, seg->size);
+		}
+	}
+	OS_Unlock(PG_Pool_Lock);
+
+	Free_Mem(Mem_Pools, sizeof(REBPOL) * MAX_POOLS);
+	Mem_Pools = 0;
+}
+
+
+/***********************************************************************
+**
+*/	void Dispose_Pools(void)
+/*
+**		Free memory pool array when application quits.
+**
+**		NOTE: Don't use any Debug_* or Dump_* functions!
+**		      These depends on resources not available anymore.
+**
+***********************************************************************/
+{
+	REBSEG	*seg, *next;
+	REBCNT  n;
+
+	//puts("===== Dispose_Pools ======");
+
+	Free_Pool_Series();
 
 	// Release all system pool memory segments.
 	FOREACH(n, SYSTEM_POOL) {
@@ -1350,5 +1492,19 @@ static void Free_Empty_Segment(REBPOL* pool, REBSEG* seg)
 	// SYSTEM_POOL contains not system series sizes (big series), at this state it should be empty!
 	ASSERT1(Mem_Pools[SYSTEM_POOL].has == 0, RP_CORRUPT_MEMORY);
 	Free_Mem(Mem_Pools, sizeof(REBPOL) * MAX_POOLS);
+
+	// Spare segments of ended tasks:
+	FOREACH(n, SYSTEM_POOL) {
+		seg = PG_Pool_Spares[n].segs;
+		while (seg) {
+			next = seg->next;
+			Free_Mem(seg, seg->size);
+			seg = next;
+		}
+	}
+	Free_Mem(PG_Pool_Spares, sizeof(REBSPR) * MAX_POOLS);
+	OS_Free_Lock(PG_Pool_Lock);
+
 	Free_Mem(PG_Pool_Map, (4 * MEM_BIG_SIZE) + 4);
+	PG_Pool_Map = 0;
 }
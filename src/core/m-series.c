@@ -61,9 +61,10 @@
 **
 ***********************************************************************/
 {
-	REBCNT start;
-	REBCNT size, new_size;
-	REBCNT extra;
+	size_t start;
+	size_t size;
+	size_t extra;
+	REBCNT new_size;
 	REBCNT wide;
 	REBSER *newser, swap;
 	REBUPT n;
@@ -71,6 +72,9 @@
 
 	if (delta == 0) return;
 
+	// New values will be stored into the block:
+	if (IS_BLOCK_SERIES(series) && !IS_BARE_SERIES(series)) GC_BARRIER(series);
+
 	// Optimized case of head insertion:
 	if (index == 0 && SERIES_BIAS(series) >= delta) {
 		series->data -= SERIES_WIDE(series) * delta;
@@ -80,15 +84,15 @@
 		return;
 	}
 
-	// Range checks:
-	if (delta & 0x80000000) Trap0(RE_PAST_END); // 2GB max
+	// Range checks (length is limited, but not the size in bytes):
+	if (delta >= MAX_SERIES_LEN - series->tail) Trap0(RE_TOO_LONG);
 	if (index > series->tail) index = series->tail; // clip
 
 	// Width adjusted variables:
 	wide  = SERIES_WIDE(series);
-	start = index * wide;
-	extra = delta * wide;
-	size  = (series->tail + 1) * wide;
+	start = (size_t)index * wide;
+	extra = (size_t)delta * wide;
+	size  = (size_t)(series->tail + 1) * wide;
 
 	// Do we need to expand the current series allocation?
 	// WARNING: Do not use ">=" below or newser size may be the same!
@@ -114,11 +118,9 @@
 #ifdef DEBUGGING
 		Print_Num("Expand:", series->tail + delta + 1);
 #endif
-		/* new_size = series->tail + delta + x with overflow checking */
-		if (REB_U32_ADD_OF(series->tail, delta, &new_size)
-			|| REB_U32_ADD_OF(new_size, x, &new_size)) {
-			Trap0(RE_PAST_END);
-		}
+		// The sum is below the limit (checked above), the doubling is clipped:
+		new_size = series->tail + delta;
+		new_size += MIN(x, MAX_SERIES_LEN - new_size);
 
 		newser = Make_Series(new_size, wide, new_size < 512*1024);
 		// If necessary, add series to the recently expanded list:
@@ -129,6 +131,8 @@
 		}
 		Prior_Expand[0] = (REBSER*)n; // start next search here
 		Prop_Series(newser, series);
+		// The expanded data is always from the pool (not external or mapped):
+		SERIES_CLR_FLAG(newser, SER_EXT | SER_MMAP);
 		//ENABLE_GC;
 
 		// Copy the series up to the expansion point:
@@ -160,7 +164,7 @@
 	memmove(series->data + start + extra, series->data + start, size - start);
 	series->tail += delta;
 
-	if ((SERIES_TAIL(series) + SERIES_BIAS(series)) * wide >= SERIES_TOTAL(series)) {
+	if ((size_t)(SERIES_TAIL(series) + SERIES_BIAS(series)) * wide >= SERIES_TOTAL(series)) {
 		Dump_Series(series, "Overflow");
 		ASSERT(0, RP_OVER_SERIES);
 	}
@@ -196,7 +200,7 @@
 	if (index > series->tail) index = series->tail;
 	Expand_Series(series, index, len); // tail += len
 	//Print("i: %d t: %d l: %d x: %d s: %d", index, series->tail, len, (series->tail + 1) * SERIES_WIDE(series), series->size);
-	memcpy(series->data + (SERIES_WIDE(series) * index), data, SERIES_WIDE(series) * len);
+	memcpy(SERIES_SKIP(series, index), data, (size_t)SERIES_WIDE(series) * len);
 	//*(int *)(series->data + (series->tail-1) * SERIES_WIDE(series)) = 5; // for debug purposes
 	return index + len;
 }
@@ -218,8 +222,8 @@
 	REBCNT wide = SERIES_WIDE(series);
 
 	EXPAND_SERIES_TAIL(series, len);
-	memcpy(series->data + (wide * tail), data, wide * len);
-	CLEAR(series->data + (wide * series->tail), wide); // terminator
+	memcpy(SERIES_SKIP(series, tail), data, (size_t)wide * len);
+	CLEAR(SERIES_SKIP(series, series->tail), wide); // terminator
 }
 
 
@@ -261,7 +265,7 @@
 	REBCNT len = source->tail + 1;
 	REBSER *series = Make_Series(len, SERIES_WIDE(source), FALSE);
 
-	COPY_MEM(series->data, source->data, len * SERIES_WIDE(source));
+	COPY_MEM(series->data, source->data, (size_t)len * SERIES_WIDE(source));
 	if (IS_UTF8_SERIES(source)) UTF8_SERIES(series);
 	series->tail = source->tail;
 	return series;
@@ -278,7 +282,7 @@
 {
 	REBSER *series = Make_Series(length+1, SERIES_WIDE(source), FALSE);
 
-	COPY_MEM(series->data, source->data + index * SERIES_WIDE(source), (length+1) * SERIES_WIDE(source));
+	COPY_MEM(series->data, SERIES_SKIP(source, index), (size_t)(length+1) * SERIES_WIDE(source));
 	series->tail = length;
 	if (IS_UTF8_SERIES(source)) {
 
@@ -339,7 +343,8 @@
 ***********************************************************************/
 {
 	REBCNT	start;
-	REBCNT	length;
+	size_t	offset;
+	size_t	length;
 	REBYTE	*data;
 
 	if (len <= 0) return;
@@ -364,7 +369,7 @@
 			if (bias > 0xffff) { //bias is 16-bit, so a simple SERIES_ADD_BIAS could overflow it
 				REBYTE *data = series->data;
 
-				data += SERIES_WIDE(series) * len;
+				data += (size_t)SERIES_WIDE(series) * len;
 				series->data -= SERIES_WIDE(series) * SERIES_BIAS(series);
 				SERIES_REST(series) += SERIES_BIAS(series);
 				SERIES_SET_BIAS(series, 0);
@@ -386,20 +391,19 @@
 
 	if (index >= series->tail) return;
 
-	start = index * SERIES_WIDE(series);
+	offset = (size_t)index * SERIES_WIDE(series);
 
 	// Clip if past end and optimize the remove operation:
-	if (len + index >= series->tail) {
+	if ((REBCNT)len + index >= series->tail) {
 		series->tail = index;
-		CLEAR(series->data + start, SERIES_WIDE(series));
+		CLEAR(series->data + offset, SERIES_WIDE(series));
 		return;
 	}
 
-	length = SERIES_LEN(series) * SERIES_WIDE(series);
+	length = SERIES_USED(series);
 	series->tail -= (REBCNT)len;
-	len *= SERIES_WIDE(series);
-	data = series->data + start;
-	memmove(data, data + len, length - (start + len));
+	data = series->data + offset;
+	memmove(data, data + (size_t)len * SERIES_WIDE(series), length - (offset + (size_t)len * SERIES_WIDE(series)));
 
 	CHECK_MEMORY(5);
 }
@@ -554,7 +558,7 @@
 
 	ser = Make_Series(len+1, SERIES_WIDE(buf), FALSE);
 
-	COPY_MEM(ser->data, buf->data, SERIES_WIDE(buf) * len);
+	COPY_MEM(ser->data, buf->data, (size_t)SERIES_WIDE(buf) * len);
 	ser->tail = len;
 	TERM_SERIES(ser);
 
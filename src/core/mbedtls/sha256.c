@@ -218,6 +218,50 @@ static int mbedtls_a64_crypto_sha256_determine_support(void)
 
 #endif  /* MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT */
 
+/*
+ * x86 SHA extensions (SHA-NI), used only when detected at runtime.
+ * (Rebol addition, not part of the Mbed TLS distribution.)
+ */
+#if defined(MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT)
+#if (defined(MBEDTLS_ARCH_IS_X64) || defined(MBEDTLS_ARCH_IS_X86)) && \
+    (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MBEDTLS_SHA256_X86_TARGET
+#else
+#include <cpuid.h>
+#define MBEDTLS_SHA256_X86_TARGET __attribute__((target("sha,sse4.1")))
+#endif
+
+static int mbedtls_x86_sha_ni_sha256_determine_support(void)
+{
+    unsigned int regs[4] = { 0 };
+    int ssse3_sse41;
+
+#if defined(_MSC_VER)
+    __cpuid((int *) regs, 0);
+    if (regs[0] < 7) {
+        return 0;
+    }
+    __cpuid((int *) regs, 1);
+    ssse3_sse41 = (regs[2] & (1 << 9)) && (regs[2] & (1 << 19));
+    __cpuidex((int *) regs, 7, 0);
+#else
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return 0;
+    }
+    __cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+    ssse3_sse41 = (regs[2] & (1 << 9)) && (regs[2] & (1 << 19));
+    __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+    return (ssse3_sse41 && (regs[1] & (1 << 29))) ? 1 : 0; /* EBX bit 29: SHA */
+}
+#else
+#undef MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT
+#endif
+#endif  /* MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT */
+
 #if !defined(MBEDTLS_SHA256_ALT)
 
 #define SHA256_BLOCK_SIZE 64
@@ -447,7 +491,8 @@ int mbedtls_internal_sha256_process_a64_crypto(mbedtls_sha256_context *ctx,
 #undef MBEDTLS_POP_TARGET_PRAGMA
 #endif
 
-#if !defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT)
+#if !defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT) && \
+    !defined(MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT)
 #define mbedtls_internal_sha256_process_many_c mbedtls_internal_sha256_process_many
 #define mbedtls_internal_sha256_process_c      mbedtls_internal_sha256_process
 #endif
@@ -482,10 +527,12 @@ int mbedtls_internal_sha256_process_a64_crypto(mbedtls_sha256_context *ctx,
         (d) += local.temp1; (h) = local.temp1 + local.temp2;        \
     } while (0)
 
-#if defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT)
+#if defined(MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT) || \
+    defined(MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT)
 /*
  * This function is for internal use only if we are building both C and Armv8
- * versions, otherwise it is renamed to be the public mbedtls_internal_sha256_process()
+ * (or x86 SHA-NI) versions, otherwise it is renamed to be the public
+ * mbedtls_internal_sha256_process()
  */
 static
 #endif
@@ -639,6 +686,128 @@ int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
 #endif /* MBEDTLS_SHA256_USE_ARMV8_A_CRYPTO_IF_PRESENT */
 
 
+#if defined(MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT)
+
+/*
+ * Four rounds (g is their group) with message words in MC. MP and MN are
+ * the previous and the next words, whose schedule is computed here too.
+ */
+#define SHA_NI_QROUND(g, MC, MP, MN)                                          \
+    do                                                                        \
+    {                                                                         \
+        if ((g) < 4) {                                                        \
+            MC = _mm_shuffle_epi8(                                            \
+                _mm_loadu_si128((const __m128i *) (msg + 16 * (g))), MASK);   \
+        }                                                                     \
+        tmp = _mm_add_epi32(MC, _mm_loadu_si128((const __m128i *) &K[4 * (g)])); \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);                  \
+        if ((g) >= 3 && (g) < 15) {                                           \
+            MN = _mm_add_epi32(MN, _mm_alignr_epi8(MC, MP, 4));               \
+            MN = _mm_sha256msg2_epu32(MN, MC);                                \
+        }                                                                     \
+        tmp = _mm_shuffle_epi32(tmp, 0x0E);                                   \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, tmp);                  \
+        if ((g) >= 1 && (g) < 13) {                                           \
+            MP = _mm_sha256msg1_epu32(MP, MC);                                \
+        }                                                                     \
+    } while (0)
+
+MBEDTLS_SHA256_X86_TARGET
+static size_t mbedtls_internal_sha256_process_many_x86_sha_ni(
+    mbedtls_sha256_context *ctx, const uint8_t *msg, size_t len)
+{
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, save0, save1, tmp;
+    __m128i m0 = _mm_setzero_si128(), m1 = m0, m2 = m0, m3 = m0;
+    size_t processed = 0;
+
+    /* State is kept as ABEF and CDGH */
+    tmp    = _mm_loadu_si128((const __m128i *) &ctx->state[0]);
+    state1 = _mm_loadu_si128((const __m128i *) &ctx->state[4]);
+    tmp    = _mm_shuffle_epi32(tmp, 0xB1);            /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);         /* EFGH */
+    state0 = _mm_alignr_epi8(tmp, state1, 8);         /* ABEF */
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);      /* CDGH */
+
+    for (;
+         len >= SHA256_BLOCK_SIZE;
+         processed += SHA256_BLOCK_SIZE,
+         msg += SHA256_BLOCK_SIZE,
+         len -= SHA256_BLOCK_SIZE) {
+        save0 = state0;
+        save1 = state1;
+
+        SHA_NI_QROUND(0,  m0, m3, m1);
+        SHA_NI_QROUND(1,  m1, m0, m2);
+        SHA_NI_QROUND(2,  m2, m1, m3);
+        SHA_NI_QROUND(3,  m3, m2, m0);
+        SHA_NI_QROUND(4,  m0, m3, m1);
+        SHA_NI_QROUND(5,  m1, m0, m2);
+        SHA_NI_QROUND(6,  m2, m1, m3);
+        SHA_NI_QROUND(7,  m3, m2, m0);
+        SHA_NI_QROUND(8,  m0, m3, m1);
+        SHA_NI_QROUND(9,  m1, m0, m2);
+        SHA_NI_QROUND(10, m2, m1, m3);
+        SHA_NI_QROUND(11, m3, m2, m0);
+        SHA_NI_QROUND(12, m0, m3, m1);
+        SHA_NI_QROUND(13, m1, m0, m2);
+        SHA_NI_QROUND(14, m2, m1, m3);
+        SHA_NI_QROUND(15, m3, m2, m0);
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+    }
+
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);         /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);         /* DCHG */
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);      /* DCBA */
+    state1 = _mm_alignr_epi8(state1, tmp, 8);         /* HGFE */
+    _mm_storeu_si128((__m128i *) &ctx->state[0], state0);
+    _mm_storeu_si128((__m128i *) &ctx->state[4], state1);
+
+    return processed;
+}
+
+#undef SHA_NI_QROUND
+
+static int mbedtls_x86_sha_ni_sha256_has_support(void)
+{
+    static int done = 0;
+    static int supported = 0;
+
+    if (!done) {
+        supported = mbedtls_x86_sha_ni_sha256_determine_support();
+        done = 1;
+    }
+
+    return supported;
+}
+
+static size_t mbedtls_internal_sha256_process_many(mbedtls_sha256_context *ctx,
+                                                   const uint8_t *msg, size_t len)
+{
+    if (mbedtls_x86_sha_ni_sha256_has_support()) {
+        return mbedtls_internal_sha256_process_many_x86_sha_ni(ctx, msg, len);
+    } else {
+        return mbedtls_internal_sha256_process_many_c(ctx, msg, len);
+    }
+}
+
+int mbedtls_internal_sha256_process(mbedtls_sha256_context *ctx,
+                                    const unsigned char data[SHA256_BLOCK_SIZE])
+{
+    if (mbedtls_x86_sha_ni_sha256_has_support()) {
+        return (mbedtls_internal_sha256_process_many_x86_sha_ni(ctx, data,
+                                                                SHA256_BLOCK_SIZE) ==
+                SHA256_BLOCK_SIZE) ? 0 : -1;
+    } else {
+        return mbedtls_internal_sha256_process_c(ctx, data);
+    }
+}
+
+#endif /* MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT */
+
+
 /*
  * SHA-256 process buffer
  */
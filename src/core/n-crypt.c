@@ -210,6 +210,7 @@ static mbedtls_ctr_drbg_context ctr_drbg;
 		add_ec_word(SYM_ADLER32)
 		add_ec_word(SYM_CRC24)
 		add_ec_word(SYM_CRC32)
+		add_ec_word(SYM_CRC32C)
 #ifdef INCLUDE_MD4
 		add_ec_word(SYM_MD4)
 #endif
@@ -351,6 +351,9 @@ static REBYTE arg_to_byte(REBVAL* val) {
 //	if (D_REF(3)) blk = Copy_Block_Deep(blk, VAL_INDEX(arg), VAL_TAIL(arg), COPY_DEEP);
 	Set_Block_Index(D_RET, blk, D_REF(3) ? 0 : VAL_INDEX(arg));
 
+	// Words of the block will link the frame:
+	GC_BARRIER(blk);
+
 	if (rel)
 		Bind_Stack_Block(frame, blk); //!! needs deep
 	else
@@ -535,6 +538,7 @@ static REBYTE arg_to_byte(REBVAL* val) {
 
 	// Special form: IN object block
 	if (IS_BLOCK(word) || IS_PAREN(word)) {
+		GC_BARRIER(VAL_SERIES(word));
 		Bind_Block(frame, VAL_BLK(word), BIND_DEEP);
 		return R_ARG2;
 	}
@@ -565,6 +569,7 @@ static REBYTE arg_to_byte(REBVAL* val) {
 	REBSER *frame = VAL_OBJ_FRAME(D_ARG(1));
 	REBSER *body  = VAL_SERIES   (D_ARG(2));
 
+	GC_BARRIER(body);
 	Bind_Block(frame, BLK_HEAD(body), BIND_DEEP);
 
 	// Evaluate the body:
@@ -648,6 +653,7 @@ static REBYTE arg_to_byte(REBVAL* val) {
 	// Is target an object?
 	if (IS_OBJECT(word)) {
 		Assert_Public_Object(word);
+		GC_BARRIER(VAL_OBJ_FRAME(word));
 		// Check for protected or unset before setting anything.
 		for (tmp = val, word = VAL_OBJ_WORD(word, 1); NOT_END(word); word++) { // skip self
 			if (VAL_PROTECTED(word)) Trap1(RE_LOCKED_WORD, word);
@@ -278,7 +278,7 @@ FORCE_INLINE
 	n = Get_Hash_Prime(len * 2); // best when 2X # of keys
 	if (!n) Trap_Num(RE_SIZE_LIMIT, len);
 
-	ser = Make_Series(n + 1, sizeof(REBCNT), FALSE);
+	ser = Make_Series(n + 1, sizeof(REBHSL), FALSE);
 	LABEL_SERIES(ser, "make hash array");
 	//No need to clear the series, because Make_Series guarantees completely cleared memory.
 	//Clear_Series(ser);
@@ -302,16 +302,16 @@ FORCE_INLINE
 	REBCNT n;
 	REBCNT key;
 	REBSER* hser;
-	REBCNT* hashes;
+	REBHSL* hashes;
 	REBSER* series = VAL_SERIES(block);
 
 	// Create the hash array (integer indexes):
 	hser = Make_Hash_Array(VAL_LEN(block));
-	hashes = (REBCNT*)hser->data;
+	hashes = HASH_SLOTS(hser);
 
 	for (n = VAL_INDEX(block); n < series->tail; n++) {
 		key = Find_Key(series, hser, BLK_SKIP(series, n), 1, cased, 0);
-		hashes[key] = n + 1;
+		hashes[key].index = n + 1;
 	}
 
 	return hser;
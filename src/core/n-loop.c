@@ -419,6 +419,7 @@ cont_utf8:
 
 		rindex = index;  // remember starting spot
 		j = 0;
+		GC_BARRIER(frame); // may be old after a recycle in the body
 
 		// Set the FOREACH loop variables from the series:
 		for (i = 1; i < frame->tail; i++) {
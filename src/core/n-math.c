@@ -882,6 +882,12 @@ compare:
 
 	if (IS_PAIR(D_ARG(1)) || IS_PAIR(D_ARG(2)))
 		return Min_Max_Pair(ds, 1);
+#ifndef EXCLUDE_VECTOR_MATH
+	if (IS_VECTOR(D_ARG(1)) || IS_VECTOR(D_ARG(2))) {
+		Min_Max_Vector(D_RET, D_ARG(1), D_ARG(2), 1);
+		return R_RET;
+	}
+#endif
 
 	a = *D_ARG(1);
 	b = *D_ARG(2);
@@ -899,6 +905,12 @@ compare:
 
 	if (IS_PAIR(D_ARG(1)) || IS_PAIR(D_ARG(2)))
 		return Min_Max_Pair(ds, 0);
+#ifndef EXCLUDE_VECTOR_MATH
+	if (IS_VECTOR(D_ARG(1)) || IS_VECTOR(D_ARG(2))) {
+		Min_Max_Vector(D_RET, D_ARG(1), D_ARG(2), 0);
+		return R_RET;
+	}
+#endif
 
 	a = *D_ARG(1);
 	b = *D_ARG(2);
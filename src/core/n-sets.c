@@ -43,26 +43,77 @@ enum {
 #define SET_OP_DIFFERENCE	(FLAGIT(SOP_BOTH) | FLAGIT(SOP_CHECK) | FLAGIT(SOP_INVERT))
 
 
+/***********************************************************************
+**
+*/	static REBCNT Char_Key(REBSER *ser, REBCNT i, REBCNT skip, REBFLG cased, REBFLG utf8, REBCNT *bytes)
+/*
+**		Returns the first char (or byte) of the record at the index
+**		(lowercased when not cased) and the record's length in bytes.
+**
+***********************************************************************/
+{
+	REBCNT chr;
+
+	if (utf8) {
+		chr = UTF8_Get_Codepoint(BIN_SKIP(ser, i));
+		*bytes = UTF8_Skip(ser, i, skip) - i;
+	}
+	else {
+		chr = BIN_HEAD(ser)[i];
+		*bytes = MIN(skip, SERIES_TAIL(ser) - i);
+	}
+	if (!cased && chr < UNICODE_CASES) chr = LO_CASE(chr);
+	return chr;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Char_Keys(REBVAL *val, REBCNT skip, REBFLG cased)
+/*
+**		Returns a bitset with the first chars of all records.
+**
+***********************************************************************/
+{
+	REBSER *bset = Make_Bitset(256);
+	REBSER *ser = VAL_SERIES(val);
+	REBFLG utf8 = !IS_BINARY(val) && IS_UTF8_SERIES(ser);
+	REBCNT i, bytes;
+
+	for (i = VAL_INDEX(val); i < SERIES_TAIL(ser); i += bytes)
+		Set_Bit(bset, Char_Key(ser, i, skip, cased, utf8, &bytes), TRUE);
+	return bset;
+}
+
+
 /***********************************************************************
 **
 */	static REBINT Do_Set_Operation(REBVAL *ds, REBCNT flags)
 /*
 **		Do set operations on a series.
 **
+**		Blocks and maps use just one hash table. It is built for the
+**		result, which gets unique records of the first series. Records
+**		of the second series are then only looked up (their matches
+**		are marked) and the result is compacted in place.
+**		Strings and binaries use bitsets of their chars.
+**
 ***********************************************************************/
 {
 	REBVAL *val;
 	REBVAL *val1;
 	REBVAL *val2 = 0;
 	REBSER *ser;
-	REBSER *hser = 0;	// hash table for series
-	REBSER *retser;		// return series
 	REBSER *hret;		// hash table for return series
-	REBCNT i;
+	REBSER *retser;		// return series
+	REBSER *seen;		// chars already in the result
+	REBSER *other = 0;	// chars of the other series
+	REBSER *marks;		// result records found in the other series
+	REBCNT i, n, k;
 	REBINT h = TRUE;
 	REBCNT skip = 1;	// record size
 	REBFLG cased = 0;	// case sensitive when TRUE
-	REBFLG utf8 = 0;    // if any of series contains Unicode chars
+	REBFLG utf8;
 
 	SET_NONE(D_RET);
 	val1 = D_ARG(1);
@@ -87,98 +138,103 @@ enum {
 		// fall thru...
 	case REB_BLOCK:
 		i = VAL_LEN(val1);
-		// Setup result block:
+		// Setup result block (sized for all records at once):
 		if (GET_FLAG(flags, SOP_BOTH)) i += VAL_LEN(val2);
-		retser = BUF_EMIT;			// use preallocated shared block
-		Resize_Series(retser, i);
+		retser = Make_Block(i);
 		// don't hash small blocks...
-		hret = (i <= MIN_DICT) ? NULL : Make_Hash_Array(i);	// allocated
+		hret = (i <= MIN_DICT) ? NULL : Make_Hash_Array(i / skip);
 
+		// Unique records of the first series/map (or of both in union):
 		do {
-			// Check what is in first series/map but not in second series/map:
-			if (GET_FLAG(flags, SOP_CHECK)) {
-				hser = IS_MAP(val1)
-					? VAL_SERIES(val2)->series // use existing map's hash table
-					: Hash_Block(val2, cased);
-			}
-			// Iterate over first series/map:
 			ser = VAL_SERIES(val1);
 			i = VAL_INDEX(val1);
 			FOR_SER(ser, val, i, skip) {
-				if (GET_FLAG(flags, SOP_CHECK)) {
-					h = Find_Key(VAL_SERIES(val2), hser, val, skip, cased, 1) != NOT_FOUND;
-					if (GET_FLAG(flags, SOP_INVERT)) h = !h;
-				}
-				if (h) Find_Key(retser, hret, val, skip, cased, 2);
+				if (IS_MAP(val1) && VAL_MAP_REMOVED(val)) continue;
+				Find_Key(retser, hret, val, skip, cased, 2);
+			}
+			if (flags != SET_OP_UNION) break;
+			val1 = val2;
+			flags = SET_OP_UNIQUE;
+		} while (TRUE);
+
+		if (GET_FLAG(flags, SOP_CHECK)) {
+			// Mark records found in the second series/map (difference
+			// adds its records not found in the first one):
+			n = SERIES_TAIL(retser) / skip;
+			marks = Make_Binary(n + 1);
+			CLEAR(BIN_HEAD(marks), n + 1);
+			ser = VAL_SERIES(val2);
+			i = VAL_INDEX(val2);
+			FOR_SER(ser, val, i, skip) {
+				if (IS_MAP(val2) && VAL_MAP_REMOVED(val)) continue;
+				k = Find_Key(retser, hret, val, skip, cased, GET_FLAG(flags, SOP_BOTH) ? 2 : 1);
+				if (k == NOT_FOUND) continue;
+				k = hret ? HASH_SLOTS(hret)[k].index - 1 : k / skip;
+				if (k < n) BIN_HEAD(marks)[k] = 1;
 			}
 
-			// Iterate over second series/map?
-			if (NZ(i = GET_FLAG(flags, SOP_BOTH))) {
-				val = val1;
-				val1 = val2;
-				val2 = val;
-				CLR_FLAG(flags, SOP_BOTH);
+			// Keep marked records (intersect) or not marked ones and the added:
+			h = GET_FLAG(flags, SOP_INVERT) ? 0 : 1;
+			val = BLK_HEAD(retser);
+			for (i = k = 0; k < SERIES_TAIL(retser) / skip; k++) {
+				if (k < n && BIN_HEAD(marks)[k] != h) continue;
+				if (i != k) COPY_MEM(val + i * skip, val + k * skip, skip * sizeof(REBVAL));
+				i++;
 			}
-		} while (i);
+			Free_Series(marks);
+			if (i * skip < SERIES_TAIL(retser)) {
+				SERIES_TAIL(retser) = i * skip;
+				BLK_TERM(retser);
+				// Hash indexes are not valid anymore:
+				if (hret) Free_Series(hret);
+				hret = NULL;
+				if (IS_MAP(val1) && i > MIN_DICT) {
+					Block_As_Map(retser);
+					hret = retser->series;
+				}
+			}
+		}
 
-		if IS_MAP(val1) {
-			Set_Series(REB_MAP, D_RET, Copy_Block(retser, 0));
-			VAL_SERIES(D_RET)->series = hret;
+		if (IS_MAP(val1)) {
+			Set_Series(REB_MAP, D_RET, retser);
+			retser->series = hret;
 		}
 		else {
-			Set_Block(D_RET, Copy_Series(retser));
+			if (hret) Free_Series(hret);
+			Set_Block(D_RET, retser);
 		}
-		
-		RESET_TAIL(retser); // required - allow reuse
 		break;
 
-	//case REB_BINARY:
-	//!! Binary  input is broken, so better to turn it of for now! !!//
-	//!! https://github.com/Oldes/Rebol-issues/issues/1978         !!//
-	//	cased = TRUE;
-	//	SET_TYPE(D_RET, REB_BINARY);
+	case REB_BINARY:
+		cased = TRUE;
+		// fall thru...
 	case REB_STRING:
 		i = VAL_LEN(val1);
-		// Setup result block:
+		// Setup result (sized for all chars at once):
 		if (GET_FLAG(flags, SOP_BOTH)) i += VAL_LEN(val2);
-
-		retser = BUF_MOLD;
-		Reset_Buffer(retser, i);
-		RESET_TAIL(retser);
-
-		cased = cased ? AM_FIND_CASE : 0;
-		utf8 = IS_UTF8_STRING(val1) || (val2 && IS_UTF8_STRING(val2));
+		retser = Make_Binary(i);
+		seen = Make_Bitset(256);
 
 		do {
-			REBU32 chr;
+			REBCNT chr, bytes;
+
+			if (GET_FLAG(flags, SOP_CHECK)) {
+				if (other) Free_Series(other);
+				other = Char_Keys(val2, skip, cased);
+			}
 
 			// Iterate over first series:
 			ser = VAL_SERIES(val1);
-			i = VAL_INDEX(val1);
-			if (utf8) {
-				REBLEN bytes = skip;
-				for (; i < SERIES_TAIL(ser); i += bytes) {
-					chr = UTF8_Get_Codepoint(BIN_SKIP(ser, i));
-					bytes = UTF8_Skip(ser, i, skip) - i;
-					if (GET_FLAG(flags, SOP_CHECK)) {
-						h = Find_Str_Char(VAL_SERIES(val2), 0, VAL_INDEX(val2), VAL_TAIL(val2), skip, chr, cased) != NOT_FOUND;
-						if (GET_FLAG(flags, SOP_INVERT)) h = !h;
-					}
-					if (h && (Find_Str_Char(retser, 0, 0, SERIES_TAIL(retser), skip, chr, cased) == NOT_FOUND)) {
-						Append_String(retser, ser, i, bytes);
-					}
+			utf8 = !IS_BINARY(val1) && IS_UTF8_SERIES(ser);
+			for (i = VAL_INDEX(val1); i < SERIES_TAIL(ser); i += bytes) {
+				chr = Char_Key(ser, i, skip, cased, utf8, &bytes);
+				if (GET_FLAG(flags, SOP_CHECK)) {
+					h = Check_Bit(other, chr, FALSE);
+					if (GET_FLAG(flags, SOP_INVERT)) h = !h;
 				}
-			}
-			else {
-				for (; i < SERIES_TAIL(ser); i += skip) {
-					chr = BIN_HEAD(ser)[i];
-					if (GET_FLAG(flags, SOP_CHECK)) {
-						h = Find_Str_Char(VAL_SERIES(val2), 0, VAL_INDEX(val2), VAL_TAIL(val2), skip, chr, cased) != NOT_FOUND;
-						if (GET_FLAG(flags, SOP_INVERT)) h = !h;
-					}
-					if (h && (Find_Str_Char(retser, 0, 0, SERIES_TAIL(retser), skip, chr, cased) == NOT_FOUND)) {
-						Append_String(retser, ser, i, skip);
-					}
+				if (h && !Check_Bit(seen, chr, FALSE)) {
+					Set_Bit(seen, chr, TRUE);
+					Append_String(retser, ser, i, bytes);
 				}
 			}
 
@@ -191,11 +247,13 @@ enum {
 			}
 		} while (i);
 
-		ser = Copy_String(retser, 0, -1);
-		if (IS_BINARY(D_RET))
-			Set_Binary(D_RET, ser);
+		TERM_SERIES(retser);
+		Free_Series(seen);
+		if (other) Free_Series(other);
+		if (IS_BINARY(val1))
+			Set_Binary(D_RET, retser);
 		else
-			Set_String(D_RET, ser);
+			Set_String(D_RET, retser);
 		break;
 
 	case REB_BITSET:
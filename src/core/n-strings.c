@@ -86,6 +86,15 @@ static struct digest {
 
 };
 
+#define CHECKSUM_CHUNK 0x10000 // part of data processed by all methods at once
+
+typedef struct rebol_checksum_state {
+	struct digest *digest;	// NULL for the CRC32, CRC32C and ADLER32
+	void  *ctx;
+	REBCNT sym;
+	REBCNT sum;
+} REBCSS;
+
 
 /***********************************************************************
 **
@@ -175,6 +184,78 @@ static struct digest {
 }
 
 
+/***********************************************************************
+**
+*/	static void Checksum_Methods(REBVAL *out, REBYTE *bin, REBCNT len, REBVAL *methods)
+/*
+**		Computes checksums of all methods in one pass over the data.
+**		Data are processed in parts, which stay in the CPU cache for
+**		all methods. Results are returned in a block.
+**
+***********************************************************************/
+{
+	REBVAL *val;
+	REBCNT cnt = VAL_LEN(methods);
+	REBCSS *sums;
+	REBCNT n, i, part;
+	REBSER *ser;
+
+	// Validate methods first (errors must not leak the states):
+	for (val = VAL_BLK_DATA(methods); NOT_END(val); val++) {
+		if (!IS_WORD(val)) Trap_Arg(val);
+		n = VAL_WORD_CANON(val);
+		if (n == SYM_CRC32 || n == SYM_CRC32C || n == SYM_ADLER32) continue;
+		for (i = 0; digests[i].index && digests[i].index != (REBINT)n; i++);
+		if (!digests[i].index) Trap_Arg(val);
+	}
+
+	sums = Make_Clear_Mem(cnt + 1, sizeof(REBCSS));
+	for (n = 0, val = VAL_BLK_DATA(methods); n < cnt; n++, val++) {
+		sums[n].sym = VAL_WORD_CANON(val);
+		sums[n].sum = (sums[n].sym == SYM_ADLER32) ? 1 : 0;
+		for (i = 0; digests[i].index; i++) {
+			if (digests[i].index == (REBINT)sums[n].sym) {
+				sums[n].digest = &digests[i];
+				sums[n].ctx = Make_CMem(digests[i].ctxsize());
+				digests[i].init(sums[n].ctx);
+				break;
+			}
+		}
+	}
+
+	for (; len > 0; bin += part, len -= part) {
+		part = MIN(len, CHECKSUM_CHUNK);
+		for (n = 0; n < cnt; n++) {
+			if (sums[n].digest)
+				sums[n].digest->update(sums[n].ctx, bin, part);
+			else if (sums[n].sym == SYM_CRC32)
+				sums[n].sum = Update_CRC32(sums[n].sum, bin, part);
+			else if (sums[n].sym == SYM_CRC32C)
+				sums[n].sum = Update_CRC32C(sums[n].sum, bin, part);
+			else
+				sums[n].sum = ADLER32_FUNC(sums[n].sum, bin, part);
+		}
+	}
+
+	ser = Make_Block(cnt);
+	SAVE_SERIES(ser);
+	for (n = 0; n < cnt; n++) {
+		val = Append_Value(ser);
+		if (sums[n].digest) {
+			REBSER *digest = Make_Binary(sums[n].digest->len);
+			sums[n].digest->final(sums[n].ctx, BIN_HEAD(digest));
+			SERIES_TAIL(digest) = sums[n].digest->len;
+			Set_Binary(val, digest);
+			Free_Mem(sums[n].ctx, sums[n].digest->ctxsize());
+		}
+		else SET_INTEGER(val, sums[n].sum);
+	}
+	UNSAVE_SERIES(ser);
+	Free_Mem(sums, (cnt + 1) * sizeof(REBCSS));
+	Set_Block(out, ser);
+}
+
+
 /***********************************************************************
 **
 */	REBNATIVE(ajoin)
@@ -234,7 +315,7 @@ static struct digest {
 //	checksum: native [
 //		{Computes a checksum, CRC, hash, or HMAC.}
 //		data [binary! string! file!] {If string, it will be UTF8 encoded. File is dispatched to file-checksum function.}
-//		method [word!] {One of `system/catalog/checksums` and HASH}
+//		method [word! block!] {One of `system/catalog/checksums` and HASH, or a block of them (computed in one pass)}
 //		/with {Extra value for HMAC key or hash table size; not compatible with TCP/CRC24/CRC32/ADLER32 methods.}
 //		 spec [any-string! binary! integer!] {String or binary for MD5/SHA* HMAC key, integer for hash table size.}
 //		/part {Limits to a given length}
@@ -256,6 +337,13 @@ static struct digest {
 
 
 	len = Partial1(data, D_ARG(ARG_CHECKSUM_LENGTH));
+
+	if (IS_BLOCK(method)) {
+		if (IS_FILE(data)) Trap0(RE_FEATURE_NA);
+		if (D_REF(ARG_CHECKSUM_WITH)) Trap0(RE_BAD_REFINES);
+		Checksum_Methods(DS_RETURN, VAL_BIN_DATA(data), len, method);
+		return R_RET;
+	}
 	sym = VAL_WORD_CANON(method);
 
 	if (IS_BINARY(data) || IS_STRING(data)) {
@@ -356,6 +444,9 @@ static struct digest {
 	if (sym == SYM_CRC32 || sym == SYM_ADLER32) {
 		sum = (sym == SYM_CRC32) ? CRC32(bin, len) : ADLER32_FUNC(0x00000001L, bin, len);
 	}
+	else if (sym == SYM_CRC32C) {
+		sum = Update_CRC32C(0, bin, len);
+	}
 	else if (sym == SYM_HASH) {  // /hash
 		if(!D_REF(ARG_CHECKSUM_WITH)) Trap0(RE_MISSING_ARG);
 		if (!IS_INTEGER(spec)) Trap1(RE_BAD_REFINE, D_ARG(ARG_CHECKSUM_SPEC));
@@ -184,6 +184,14 @@
 
 			stats++;
 			SET_INTEGER(stats, PG_Reb_Stats->Recycle_Counter);
+			stats++;
+			SET_INTEGER(stats, PG_Reb_Stats->Recycle_Minor_Counter);
+			stats++;
+			VAL_TIME(stats) = PG_Reb_Stats->Recycle_Time * 1000;
+			VAL_SET(stats, REB_TIME);
+			stats++;
+			VAL_TIME(stats) = PG_Reb_Stats->Recycle_Minor_Time * 1000;
+			VAL_SET(stats, REB_TIME);
 #ifdef DEBUG_HASH_COLLISIONS
 			stats++;
 			SET_INTEGER(stats, Eval_Collisions);
@@ -443,8 +451,9 @@ err:
 **	Args:
 **		1: codec:  handle!
 **		2: action: word! (identify, decode, encode)
-**		3: data:   binary! image! sound!
-**		4: option: (optional)
+**		3: data:   binary! image! string! (or any value to encode)
+**		4: /as
+**		5: options (passed to the codec)
 **
 ***********************************************************************/
 {
@@ -466,7 +475,8 @@ err:
 	case SYM_IDENTIFY:
 		codi.action = CODI_IDENTIFY;
 	case SYM_DECODE:
-		if (!IS_BINARY(val)) Trap1(RE_INVALID_ARG, val);
+		// Strings are UTF-8 encoded, so these are passed as they are
+		if (!IS_BINARY(val) && !IS_STRING(val)) Trap1(RE_INVALID_ARG, val);
 		codi.data = VAL_BIN_DATA(D_ARG(3));
 		codi.len  = VAL_LEN(D_ARG(3));
 		break;
@@ -479,14 +489,19 @@ err:
 			codi.h = VAL_IMAGE_HIGH(val);
 			codi.alpha = Image_Has_Alpha(val, 0);
 		}
-		else
-			Trap1(RE_INVALID_ARG, val);
+		else {
+			// Codecs which encode only images don't know this action
+			codi.action = CODI_ENCODE_VALUE;
+			codi.other = val;
+		}
 		break;
 
 	default:
 		Trap1(RE_INVALID_ARG, D_ARG(2));
 	}
 
+	if (D_REF(4)) codi.options = D_ARG(5);
+
 	// Nasty alias, but it must be done:
 	result = ((codo)(VAL_HANDLE(hnd)))(&codi);
 
@@ -530,6 +545,10 @@ err:
 		Set_String(D_RET, codi.other);
 		break;
 
+	case CODI_VALUE:
+		*D_RET = *(REBVAL *)codi.other;
+		break;
+
 	default:
 		Trap0(RE_BAD_MEDIA); // need better!!!
 	}
@@ -72,10 +72,7 @@
 			}
 			if (IS_VECTOR(data) || IS_BINARY(data)) {
 				req->data = VAL_BIN_DATA(data);
-				req->length = VAL_TAIL(data) - VAL_INDEX(data);
-				if (IS_VECTOR(data)) {
-					req->length *= VAL_VEC_WIDTH(data); // length in raw bytes
-				}
+				req->length = Val_Byte_Len(data); // length in raw bytes
 			}
 			else break;
 		}
@@ -87,12 +84,7 @@
 			len = Partial(arg, 0, D_ARG(ARG_WRITE_LENGTH), 0);
 
 			req->data = VAL_BIN_DATA(arg);
-			req->length = len;
-
-			if (IS_VECTOR(arg)) {
-				// length in raw bytes
-				req->length *= VAL_VEC_WIDTH(arg);
-			}
+			req->length = Series_Byte_Len(VAL_SERIES(arg), len); // length in raw bytes
 		}
 
 		result = OS_Do_Device(req, RDC_WRITE);
@@ -0,0 +1,333 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2025 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-channel.c
+**  Summary: channel port interface (messages between tasks)
+**  Section: ports
+**  Author:  Oldes
+**  Notes:
+**		A channel is a named queue shared by all tasks. Ports opened
+**		with the same name (channel://name) use the same queue.
+**		Written values are molded (/all) into plain memory and loaded
+**		again by the reader, so tasks never share any series.
+**		READ waits for a message (or until the spec's timeout) and
+**		returns NONE when there is no message.
+**		A channel (with its pending messages) exists while any port
+**		of any task has it open.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#define CHANNEL_POLL 100	// msec between checks of signals (escape) while waiting
+
+typedef struct Reb_Channel_Msg {
+	struct Reb_Channel_Msg *next;
+	REBYTE *data;		// molded value (UTF-8)
+	REBCNT  size;
+} REBCHM;
+
+typedef struct Reb_Channel {
+	struct Reb_Channel *next;
+	void   *lock;		// guards the queue, signaled on write
+	REBCHM *first;		// oldest message
+	REBCHM *last;
+	REBCNT  count;		// number of messages
+	REBCNT  refs;		// number of open ports
+	REBYTE *name;
+	REBCNT  len;
+} REBCHN;
+
+static REBCHN *Channels;		// all open channels
+static void   *Channels_Lock;	// guards the list above
+
+
+/***********************************************************************
+**
+*/	static REBCHN *Open_Channel(REBYTE *name, REBCNT len)
+/*
+**		Find a channel of the given name or make a new one.
+**
+***********************************************************************/
+{
+	REBCHN *chn;
+
+	OS_Lock(Channels_Lock);
+	for (chn = Channels; chn; chn = chn->next) {
+		if (chn->len == len && !memcmp(chn->name, name, len)) break;
+	}
+	if (!chn) {
+		chn = Make_Clear_Mem(sizeof(REBCHN), 1);
+		if (chn) chn->name = Make_Mem(len + 1);
+		if (chn) chn->lock = OS_Make_Lock();
+		if (!chn || !chn->name || !chn->lock) {
+			OS_Unlock(Channels_Lock);
+			Trap0(RE_NO_MEMORY);
+		}
+		COPY_MEM(chn->name, name, len);
+		chn->name[len] = 0;
+		chn->len = len;
+		chn->next = Channels;
+		Channels = chn;
+	}
+	chn->refs++;
+	OS_Unlock(Channels_Lock);
+	return chn;
+}
+
+
+/***********************************************************************
+**
+*/	static void Free_Channel_Msg(REBCHM *msg)
+/*
+***********************************************************************/
+{
+	Free_Mem(msg->data, msg->size + 1);
+	Free_Mem(msg, sizeof(REBCHM));
+}
+
+
+/***********************************************************************
+**
+*/	static void Close_Channel(REBCHN **chp)
+/*
+**		Release port's reference to a channel. The last one
+**		removes the channel with its pending messages.
+**		Used as a handle free callback (also on GC of the port).
+**
+***********************************************************************/
+{
+	REBCHN *chn = *chp;
+	REBCHN **prev;
+	REBCHM *msg;
+
+	if (!chn) return;
+	*chp = NULL;
+
+	OS_Lock(Channels_Lock);
+	if (--chn->refs > 0) {
+		OS_Unlock(Channels_Lock);
+		return;
+	}
+	for (prev = &Channels; *prev; prev = &(*prev)->next) {
+		if (*prev == chn) {
+			*prev = chn->next;
+			break;
+		}
+	}
+	OS_Unlock(Channels_Lock);
+
+	while (NZ(msg = chn->first)) {
+		chn->first = msg->next;
+		Free_Channel_Msg(msg);
+	}
+	OS_Free_Lock(chn->lock);
+	Free_Mem(chn->name, chn->len + 1);
+	Free_Mem(chn, sizeof(REBCHN));
+}
+
+
+/***********************************************************************
+**
+*/	static void Write_Channel(REBCHN *chn, REBVAL *value)
+/*
+***********************************************************************/
+{
+	REBCHM *msg;
+
+	msg = Make_Mem(sizeof(REBCHM));
+	if (!msg) Trap0(RE_NO_MEMORY);
+	msg->next = NULL;
+	msg->data = Pack_Task_Value(value, &msg->size);
+
+	OS_Lock(chn->lock);
+	if (chn->last) chn->last->next = msg;
+	else chn->first = msg;
+	chn->last = msg;
+	chn->count++;
+	OS_Signal_Lock(chn->lock);
+	OS_Unlock(chn->lock);
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Read_Channel(REBCHN *chn, REBINT timeout, REBVAL *out)
+/*
+**		Take the oldest message. Timeout is in msec (negative to
+**		wait forever). Returns FALSE when there is no message.
+**
+***********************************************************************/
+{
+	REBCHM *msg;
+	REBI64 base = 0;
+	REBINT wait = timeout;
+
+	if (timeout > 0) base = OS_Delta_Time(0, 0);
+
+	OS_Lock(chn->lock);
+	while (!chn->first && wait != 0) {
+		OS_Wait_Lock(chn->lock, (wait < 0 || wait > CHANNEL_POLL) ? CHANNEL_POLL : wait);
+		if (chn->first) break;
+		// Let escape (and other signals) interrupt the wait:
+		if (ANY_SIGNALS & Eval_Sigmask) {
+			OS_Unlock(chn->lock);
+			Do_Signals(); // may throw
+			OS_Lock(chn->lock);
+		}
+		if (timeout > 0) {
+			// Wake ups may be spurious, so count the time left:
+			wait = timeout - (REBINT)(OS_Delta_Time(base, 0) / 1000);
+			if (wait < 0) wait = 0;
+		}
+	}
+	msg = chn->first;
+	if (msg) {
+		chn->first = msg->next;
+		if (!chn->first) chn->last = NULL;
+		chn->count--;
+	}
+	OS_Unlock(chn->lock);
+
+	if (!msg) return FALSE;
+
+	// Messages are always valid molds, so loading does not throw:
+	Unpack_Task_Value(msg->data, msg->size, out);
+	Free_Channel_Msg(msg);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Channel_Timeout(REBVAL *spec)
+/*
+**		Returns spec's timeout in msec, or -1 to wait forever.
+**
+***********************************************************************/
+{
+	REBVAL *val = Obj_Value(spec, STD_PORT_SPEC_CHANNEL_TIMEOUT);
+	REBINT timeout;
+
+	if (!val) return -1;
+	switch (VAL_TYPE(val)) {
+	case REB_INTEGER:
+		timeout = 1000 * Int32(val);
+		break;
+	case REB_DECIMAL:
+		timeout = (REBINT)(1000 * VAL_DECIMAL(val));
+		break;
+	case REB_TIME:
+		timeout = (REBINT)(VAL_TIME(val) / (SEC_SEC / 1000));
+		break;
+	default:
+		return -1;
+	}
+	return (timeout < 0) ? 0 : timeout;
+}
+
+
+/***********************************************************************
+**
+*/	static int Channel_Actor(REBVAL *ds, REBVAL *port_value, REBCNT action)
+/*
+***********************************************************************/
+{
+	REBSER *port;
+	REBVAL *spec;
+	REBVAL *state;
+	REBVAL *name;
+	REBSER *ser;
+	REBCHN **chp = NULL;
+
+	port = Validate_Port_Value(port_value);
+
+	spec = BLK_SKIP(port, STD_PORT_SPEC);
+	if (!IS_OBJECT(spec)) Trap1(RE_INVALID_SPEC, spec);
+
+	state = BLK_SKIP(port, STD_PORT_STATE);
+	if (IS_HANDLE(state)) {
+		if (NOT_VALID_CONTEXT_HANDLE(state, SYM_CHANNEL))
+			Trap_Port(RE_INVALID_PORT, port, 0);
+		chp = (REBCHN **)VAL_HANDLE_CONTEXT_DATA(state);
+	}
+
+	switch (action) {
+	case A_OPEN:
+	case A_READ:
+	case A_WRITE:
+	case A_LENGTHQ:
+		if (chp) break; // read and write open the port when needed
+		name = Obj_Value(spec, STD_PORT_SPEC_CHANNEL_NAME);
+		if (!name || !IS_STRING(name)) Trap1(RE_INVALID_SPEC, spec);
+		MAKE_HANDLE(state, SYM_CHANNEL);
+		chp = (REBCHN **)VAL_HANDLE_CONTEXT_DATA(state);
+		// channels are keyed by the UTF-8 bytes of the name, so that the
+		// same name matches whatever width the string was stored in
+		if (VAL_BYTE_SIZE(name))
+			ser = Encode_UTF8_String(VAL_BIN_AT(name), VAL_LEN(name), FALSE, 0);
+		else
+			ser = Encode_UTF8_String(VAL_UNI_DATA(name), VAL_LEN(name), TRUE, 0);
+		*chp = Open_Channel(BIN_HEAD(ser), SERIES_TAIL(ser));
+		break;
+
+	case A_OPENQ:
+		return chp ? R_TRUE : R_FALSE;
+
+	case A_CLOSE:
+		if (chp) {
+			Free_Hob(VAL_HANDLE_CTX(state));
+			SET_NONE(state);
+		}
+		return R_ARG1;
+
+	default:
+		Trap1(RE_NO_PORT_ACTION, Get_Action_Word(action));
+	}
+
+	switch (action) {
+	case A_WRITE:
+		Write_Channel(*chp, D_ARG(2));
+		break;
+
+	case A_READ:
+		if (!Read_Channel(*chp, Channel_Timeout(spec), D_RET)) return R_NONE;
+		return R_RET;
+
+	case A_LENGTHQ:
+		SET_INTEGER(D_RET, (*chp)->count);
+		return R_RET;
+	}
+	return R_ARG1;
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Channel_Scheme(void)
+/*
+***********************************************************************/
+{
+	Channels = NULL;
+	Channels_Lock = OS_Make_Lock();
+	Register_Handle(SYM_CHANNEL, sizeof(REBCHN *), (REB_HANDLE_FREE_FUNC)Close_Channel);
+	Register_Scheme(SYM_CHANNEL, 0, Channel_Actor);
+}
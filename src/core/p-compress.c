@@ -0,0 +1,720 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2026 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  p-compress.c
+**  Summary: streaming compression port interface
+**  Section: ports
+**  Author:  Oldes
+**  Notes:
+**		Keeps a compression (or decompression) stream open, so data
+**		can be processed in chunks with bounded memory:
+**
+**			WRITE  - process next chunk of input
+**			READ   - returns output produced so far (may be empty)
+**			FLUSH  - make all output of written input readable
+**			UPDATE - finish the compression stream (adds the end marker)
+**
+**		Supported methods depend on the build: zlib, deflate and gzip
+**		use the bundled zlib (INCLUDE_ZLIB_STREAM in the Base, as
+**		libdeflate is one-shot only), lz4 needs INCLUDE_LZ4 (part of
+**		the Core) and br needs INCLUDE_BROTLI.
+**		The lz4 stream is the standard LZ4 frame format (linked 64kB
+**		blocks, no checksums), so it can be read by the lz4 tools and
+**		by DECOMPRESS with lz4. Frames of other tools can be read too
+**		(their checksums are skipped, not verified).
+**		The stream state is in a handle, so it is released also when
+**		an error is thrown or the port is not closed.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+
+#if defined(INCLUDE_DEPRECATED_ZLIB) || defined(INCLUDE_ZLIB_STREAM)
+#define COMPRESS_ZLIB
+#include "sys-zlib.h"
+#endif
+#ifdef INCLUDE_BROTLI
+#include "brotli/encode.h"
+#include "brotli/decode.h"
+#endif
+#ifdef INCLUDE_LZ4
+#include "lz4/lz4.h"
+#endif
+
+#define COMPRESS_CHUNK 16384	// minimal free output space per call
+
+#ifdef INCLUDE_LZ4
+// LZ4 frame format: https://github.com/lz4/lz4/blob/dev/doc/lz4_Frame_format.md
+#define LZ4_FRAME_MAGIC		0x184D2204
+#define LZ4F_BLOCK_INDEP	0x20		// FLG bits
+#define LZ4F_BLOCK_CHECK	0x10
+#define LZ4F_CONTENT_SIZE	0x08
+#define LZ4F_CONTENT_CHECK	0x04
+#define LZ4F_RAW_BLOCK		0x80000000	// block size bit: stored uncompressed
+
+#define LZ4_STREAM_BLOCK 65536	// uncompressed size of a written block (max) and of the dictionary
+#define LZ4_STREAM_BOUND LZ4_COMPRESSBOUND(LZ4_STREAM_BLOCK)
+
+// Written frames have linked 64kB blocks and no checksums (FLG 0x40, BD 0x40).
+// The last byte is the header checksum: (XXH32(FLG BD, seed 0) >> 8) & 0xFF
+static const REBYTE Lz4_Frame_Head[7] = {0x04, 0x22, 0x4D, 0x18, 0x40, 0x40, 0xC0};
+
+enum {LZ4_HEAD, LZ4_DESC, LZ4_SIZE, LZ4_DATA, LZ4_CHECK, LZ4_DONE}; // frame parts
+
+typedef struct Reb_Lz4_Stream {
+	LZ4_stream_t enc;
+	REBCNT stage;		// frame part (LZ4_HEAD until the header is written or read)
+	REBCNT index;		// current block buffer (compression)
+	REBCNT len;			// bytes in the current block (compression) or of the part (decompression)
+	REBCNT need;		// size of the part (decompression)
+	REBCNT flags;		// FLG byte of the frame
+	REBCNT block_max;	// maximal block size of the frame
+	REBCNT bsize;		// size field of the current block
+	REBCNT dict_len;	// bytes of the last output kept in block[0] (decompression)
+	REBYTE head[16];	// header part or block size split between writes
+	REBYTE *pending;	// block split between writes (block_max + checksum)
+	REBYTE block[2][LZ4_STREAM_BLOCK]; // compression: the previous block is a dictionary of the next one
+} REBLZ4S;
+
+static void Init_Lz4_Stream(REBLZ4S *lz, REBFLG decompress)
+{
+	if (!decompress) LZ4_initStream(&lz->enc, sizeof(lz->enc));
+	lz->stage = LZ4_HEAD;
+	lz->index = 0;
+	lz->len = 0;
+	lz->need = 6; // magic number, FLG and BD
+	lz->dict_len = 0;
+	lz->pending = NULL;
+}
+#endif
+
+typedef struct Reb_Compress_Stream {
+	REBCNT method;		// SYM_ZLIB, SYM_DEFLATE, SYM_GZIP, SYM_BR or SYM_LZ4
+	REBFLG decompress;
+	REBFLG finished;	// end of the compressed stream reached
+	REBINT level;		// compression level or -1 for the default
+	void  *state;		// z_stream, brotli encoder/decoder or REBLZ4S
+} REBCMS;
+
+
+static void *Stream_Alloc(void *opaque, size_t size) { return Make_Managed_Mem(opaque, size); }
+static void  Stream_Free(void *opaque, void *address) { Free_Managed_Mem(opaque, address); }
+#ifdef COMPRESS_ZLIB
+static void *Zlib_Alloc(void *opaque, unsigned nr, unsigned size) { return Make_Managed_Mem(opaque, (size_t)nr * size); }
+#endif
+
+
+/***********************************************************************
+**
+*/	static void End_Compress_Stream(REBCMS *cms)
+/*
+**		Release the stream state. Used as a handle free callback.
+**
+***********************************************************************/
+{
+	if (!cms->state) return;
+	switch (cms->method) {
+#ifdef COMPRESS_ZLIB
+	case SYM_ZLIB:
+	case SYM_DEFLATE:
+	case SYM_GZIP:
+		if (cms->decompress) inflateEnd((z_stream *)cms->state);
+		else deflateEnd((z_stream *)cms->state);
+		Stream_Free(NULL, cms->state);
+		break;
+#endif
+#ifdef INCLUDE_BROTLI
+	case SYM_BR:
+		if (cms->decompress) BrotliDecoderDestroyInstance((BrotliDecoderState *)cms->state);
+		else BrotliEncoderDestroyInstance((BrotliEncoderState *)cms->state);
+		break;
+#endif
+#ifdef INCLUDE_LZ4
+	case SYM_LZ4:
+		Stream_Free(NULL, ((REBLZ4S *)cms->state)->pending);
+		Stream_Free(NULL, cms->state);
+		break;
+#endif
+	}
+	cms->state = NULL;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Begin_Compress_Stream(REBCMS *cms)
+/*
+**		Make the stream state for the method and direction.
+**
+***********************************************************************/
+{
+#ifdef COMPRESS_ZLIB
+	z_stream *zs;
+	REBINT bits = MAX_WBITS;
+	int err;
+#endif
+
+	cms->finished = FALSE;
+
+	switch (cms->method) {
+#ifdef COMPRESS_ZLIB
+	case SYM_DEFLATE:
+		bits = -bits;
+		goto zlib_begin;
+	case SYM_GZIP:
+		bits |= 16; // and continue as zlib
+	case SYM_ZLIB:
+	zlib_begin:
+		zs = Stream_Alloc(NULL, sizeof(z_stream));
+		if (!zs) return FALSE;
+		CLEAR(zs, sizeof(z_stream));
+		zs->zalloc = Zlib_Alloc;
+		zs->zfree = Stream_Free;
+		if (cms->decompress)
+			err = inflateInit2(zs, bits);
+		else {
+			REBINT level = cms->level;
+			if (level < 0 || level > Z_BEST_COMPRESSION) level = Z_DEFAULT_COMPRESSION;
+			err = z_deflateInit2(zs, level, Z_DEFLATED, bits, 8, Z_DEFAULT_STRATEGY);
+		}
+		if (err != Z_OK) {
+			Stream_Free(NULL, zs);
+			return FALSE;
+		}
+		cms->state = zs;
+		return TRUE;
+#endif
+#ifdef INCLUDE_BROTLI
+	case SYM_BR:
+		if (cms->decompress) {
+			cms->state = BrotliDecoderCreateInstance(Stream_Alloc, Stream_Free, NULL);
+		} else {
+			cms->state = BrotliEncoderCreateInstance(Stream_Alloc, Stream_Free, NULL);
+			if (cms->state) {
+				REBINT level = (cms->level < 0) ? 6 : MIN(11, cms->level);
+				BrotliEncoderSetParameter((BrotliEncoderState *)cms->state, BROTLI_PARAM_QUALITY, level);
+			}
+		}
+		return cms->state != NULL;
+#endif
+#ifdef INCLUDE_LZ4
+	case SYM_LZ4: {
+		REBLZ4S *lz = Stream_Alloc(NULL, sizeof(REBLZ4S));
+		if (!lz) return FALSE;
+		Init_Lz4_Stream(lz, cms->decompress); // level is not used
+		cms->state = lz;
+		return TRUE;
+	}
+#endif
+	}
+	return FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	static void Reserve_Output(REBSER *out, REBCNT size)
+/*
+***********************************************************************/
+{
+	REBCNT tail = SERIES_TAIL(out);
+
+	if (SERIES_AVAIL(out) > size) return;
+	Expand_Series(out, AT_TAIL, size);
+	SERIES_TAIL(out) = tail;
+}
+
+
+#ifdef INCLUDE_LZ4
+/***********************************************************************
+**
+*/	static void Emit_Lz4_Block(REBLZ4S *lz, REBSER *out)
+/*
+**		Compress the current block and switch to the other buffer.
+**
+***********************************************************************/
+{
+	const char *src = (const char *)lz->block[lz->index];
+	REBYTE *bp;
+	int size;
+
+	Reserve_Output(out, 4 + LZ4_STREAM_BOUND);
+	bp = STR_TAIL(out);
+	size = LZ4_compress_fast_continue(&lz->enc, src, (char *)bp + 4, (int)lz->len, LZ4_STREAM_BOUND, 1);
+	if (size <= 0) {
+		SET_INTEGER(DS_RETURN, size);
+		Trap1(RE_BAD_PRESS, DS_RETURN);
+	}
+	if ((REBCNT)size < lz->len) {
+		U32TO8_LE(bp, size);
+		SERIES_TAIL(out) += 4 + size;
+	}
+	else {
+		// Not compressible, so stored (it is still the dictionary of the next block):
+		U32TO8_LE(bp, lz->len | LZ4F_RAW_BLOCK);
+		COPY_MEM(bp + 4, src, lz->len);
+		SERIES_TAIL(out) += 4 + lz->len;
+	}
+	lz->index ^= 1;
+	lz->len = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static const REBYTE *Gather_Lz4_Part(REBLZ4S *lz, REBYTE *buf, const REBYTE **in, REBLEN *len)
+/*
+**		Returns the next lz->need bytes of the input (in the buffer
+**		when they are split between writes) or NULL if incomplete.
+**
+***********************************************************************/
+{
+	const REBYTE *bp = *in;
+	REBCNT n;
+
+	if (lz->len == 0 && *len >= lz->need) {
+		*in += lz->need;
+		*len -= lz->need;
+		return bp;
+	}
+	n = MIN(*len, lz->need - lz->len);
+	COPY_MEM(buf + lz->len, bp, n);
+	lz->len += n;
+	*in += n;
+	*len -= n;
+	if (lz->len < lz->need) return NULL;
+	lz->len = 0;
+	return buf;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Decode_Lz4_Block(REBLZ4S *lz, const REBYTE *bp, REBSER *out)
+/*
+**		Append the decompressed block. Linked blocks may refer to the
+**		last 64kB of output, which are kept in block[0].
+**
+***********************************************************************/
+{
+	REBCNT size = lz->bsize & ~LZ4F_RAW_BLOCK;
+	REBYTE *dict = lz->block[0];
+	REBYTE *dp;
+	REBCNT keep;
+	int res;
+
+	Reserve_Output(out, lz->block_max);
+	dp = STR_TAIL(out);
+	if (lz->bsize & LZ4F_RAW_BLOCK) {
+		COPY_MEM(dp, bp, size);
+		res = (int)size;
+	}
+	else {
+		res = LZ4_decompress_safe_usingDict((const char *)bp, (char *)dp, (int)size, (int)lz->block_max,
+			(const char *)dict, (int)lz->dict_len);
+		if (res < 0) return res;
+	}
+	SERIES_TAIL(out) += res;
+
+	if (lz->flags & LZ4F_BLOCK_INDEP) return 0;
+	if ((REBCNT)res >= LZ4_STREAM_BLOCK) {
+		COPY_MEM(dict, dp + res - LZ4_STREAM_BLOCK, LZ4_STREAM_BLOCK);
+		lz->dict_len = LZ4_STREAM_BLOCK;
+		return 0;
+	}
+	if (lz->dict_len + res > LZ4_STREAM_BLOCK) {
+		keep = LZ4_STREAM_BLOCK - res;
+		MOVE_MEM(dict, dict + lz->dict_len - keep, keep);
+		lz->dict_len = keep;
+	}
+	COPY_MEM(dict + lz->dict_len, dp, res);
+	lz->dict_len += res;
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Decode_Lz4_Frame(REBLZ4S *lz, const REBYTE *in, REBLEN len, REBSER *out)
+/*
+**		Decompress the frame's input parts as they come. Stops at
+**		LZ4_DONE (the end of the frame). Returns a negative value
+**		for invalid (or unsupported) data.
+**
+***********************************************************************/
+{
+	const REBYTE *bp;
+	REBCNT bd;
+
+	while (lz->stage != LZ4_DONE) {
+		bp = Gather_Lz4_Part(lz, (lz->stage == LZ4_DATA) ? lz->pending : lz->head, &in, &len);
+		if (!bp) break;
+		switch (lz->stage) {
+		case LZ4_HEAD:
+			// Version 01 without a dictionary ID and with a known block size:
+			lz->flags = bp[4];
+			bd = (bp[5] >> 4) & 7;
+			if (U8TO32_LE(bp) != LZ4_FRAME_MAGIC || (lz->flags & 0xC3) != 0x40 || (bp[5] & 0x8F) || bd < 4)
+				return -1;
+			lz->block_max = 1 << (8 + 2 * bd); // 64kB, 256kB, 1MB or 4MB
+			if (!lz->pending) lz->pending = Stream_Alloc(NULL, lz->block_max + 4);
+			if (!lz->pending) return -1;
+			lz->need = ((lz->flags & LZ4F_CONTENT_SIZE) ? 8 : 0) + 1; // and the header checksum
+			lz->stage = LZ4_DESC;
+			break;
+		case LZ4_DESC:
+			lz->need = 4;
+			lz->stage = LZ4_SIZE;
+			break;
+		case LZ4_SIZE:
+			lz->bsize = U8TO32_LE(bp);
+			if (lz->bsize == 0) { // end mark
+				lz->need = 4;
+				lz->stage = (lz->flags & LZ4F_CONTENT_CHECK) ? LZ4_CHECK : LZ4_DONE;
+				break;
+			}
+			if ((lz->bsize & ~LZ4F_RAW_BLOCK) > lz->block_max) return -1;
+			lz->need = (lz->bsize & ~LZ4F_RAW_BLOCK) + ((lz->flags & LZ4F_BLOCK_CHECK) ? 4 : 0);
+			lz->stage = LZ4_DATA;
+			break;
+		case LZ4_DATA:
+			if (Decode_Lz4_Block(lz, bp, out) < 0) return -1;
+			lz->need = 4;
+			lz->stage = LZ4_SIZE;
+			break;
+		case LZ4_CHECK:
+			lz->stage = LZ4_DONE;
+			break;
+		}
+	}
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Process_Lz4_Stream(REBCMS *cms, const REBYTE *in, REBLEN len, REBINT mode, REBSER *out)
+/*
+***********************************************************************/
+{
+	REBLZ4S *lz = (REBLZ4S *)cms->state;
+	REBCNT n;
+
+	if (cms->decompress) {
+		if (Decode_Lz4_Frame(lz, in, len, out) < 0) {
+			SET_INTEGER(DS_RETURN, -1);
+			Trap1(RE_BAD_PRESS, DS_RETURN);
+		}
+		cms->finished = (lz->stage == LZ4_DONE); // data after the end are ignored
+		return;
+	}
+
+	if (lz->stage == LZ4_HEAD) {
+		Reserve_Output(out, sizeof(Lz4_Frame_Head));
+		COPY_MEM(STR_TAIL(out), Lz4_Frame_Head, sizeof(Lz4_Frame_Head));
+		SERIES_TAIL(out) += sizeof(Lz4_Frame_Head);
+		lz->stage = LZ4_DATA;
+	}
+	while (len > 0) {
+		n = MIN(len, LZ4_STREAM_BLOCK - lz->len);
+		COPY_MEM(lz->block[lz->index] + lz->len, in, n);
+		lz->len += n;
+		in += n;
+		len -= n;
+		if (lz->len == LZ4_STREAM_BLOCK) Emit_Lz4_Block(lz, out);
+	}
+	if (mode > 0 && lz->len > 0) Emit_Lz4_Block(lz, out);
+	if (mode == 2) {
+		Reserve_Output(out, 4);
+		CLEAR(STR_TAIL(out), 4); // end mark
+		SERIES_TAIL(out) += 4;
+		cms->finished = TRUE;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBFLG Decompress_Lz4_Frame(const REBYTE *in, REBLEN len, REBSER *out)
+/*
+**		Appends the content of a complete LZ4 frame (used by the
+**		one-shot DECOMPRESS). Returns FALSE for invalid data.
+**
+***********************************************************************/
+{
+	REBLZ4S *lz = Stream_Alloc(NULL, sizeof(REBLZ4S));
+	REBFLG ok;
+
+	if (!lz) return FALSE;
+	Init_Lz4_Stream(lz, TRUE);
+	ok = Decode_Lz4_Frame(lz, in, len, out) >= 0 && lz->stage == LZ4_DONE;
+	TERM_SERIES(out);
+	Stream_Free(NULL, lz->pending);
+	Stream_Free(NULL, lz);
+	return ok;
+}
+#endif
+
+
+/***********************************************************************
+**
+*/	static void Process_Stream(REBCMS *cms, const REBYTE *in, REBLEN len, REBINT mode, REBSER *out)
+/*
+**		Process input and append all output which is ready.
+**		Mode is: 0 - process, 1 - flush, 2 - finish (compression)
+**
+***********************************************************************/
+{
+	switch (cms->method) {
+#ifdef COMPRESS_ZLIB
+	case SYM_ZLIB:
+	case SYM_DEFLATE:
+	case SYM_GZIP: {
+		z_stream *zs = (z_stream *)cms->state;
+		int flush = (mode == 2) ? Z_FINISH : (mode == 1) ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+		REBCNT avail;
+		int err;
+
+		zs->next_in = (z_const Bytef *)in;
+		zs->avail_in = len;
+		for (;;) {
+			Reserve_Output(out, COMPRESS_CHUNK);
+			avail = SERIES_AVAIL(out); // terminator excluded
+			zs->next_out = STR_TAIL(out);
+			zs->avail_out = avail;
+			if (cms->decompress) err = inflate(zs, Z_NO_FLUSH);
+			else err = deflate(zs, flush);
+			SERIES_TAIL(out) += avail - zs->avail_out;
+			if (err == Z_STREAM_END) {
+				cms->finished = TRUE;
+				break;
+			}
+			if (err != Z_OK && err != Z_BUF_ERROR) {
+				SET_INTEGER(DS_RETURN, err);
+				Trap1(RE_BAD_PRESS, DS_RETURN);
+			}
+			// All input consumed and not waiting for more output space:
+			if (zs->avail_in == 0 && zs->avail_out != 0 && mode != 2) break;
+			if (err == Z_BUF_ERROR && zs->avail_out != 0) break;
+		}
+		break;
+	}
+#endif
+#ifdef INCLUDE_BROTLI
+	case SYM_BR: {
+		size_t avail_in = len;
+		size_t avail_out;
+		REBYTE *next_out;
+		REBCNT avail;
+
+		for (;;) {
+			Reserve_Output(out, COMPRESS_CHUNK);
+			avail = SERIES_AVAIL(out);
+			avail_out = avail;
+			next_out = STR_TAIL(out);
+			if (cms->decompress) {
+				BrotliDecoderResult res = BrotliDecoderDecompressStream(
+					(BrotliDecoderState *)cms->state, &avail_in, &in, &avail_out, &next_out, NULL);
+				SERIES_TAIL(out) += (REBCNT)(avail - avail_out);
+				if (res == BROTLI_DECODER_RESULT_SUCCESS) {
+					cms->finished = TRUE;
+					break;
+				}
+				if (res == BROTLI_DECODER_RESULT_ERROR) {
+					SET_INTEGER(DS_RETURN, BrotliDecoderGetErrorCode((BrotliDecoderState *)cms->state));
+					Trap1(RE_BAD_PRESS, DS_RETURN);
+				}
+				if (res == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT) break;
+			} else {
+				BrotliEncoderState *enc = (BrotliEncoderState *)cms->state;
+				BrotliEncoderOperation op = (mode == 2) ? BROTLI_OPERATION_FINISH
+					: (mode == 1) ? BROTLI_OPERATION_FLUSH : BROTLI_OPERATION_PROCESS;
+				if (!BrotliEncoderCompressStream(enc, op, &avail_in, &in, &avail_out, &next_out, NULL)) {
+					SET_INTEGER(DS_RETURN, 0);
+					Trap1(RE_BAD_PRESS, DS_RETURN);
+				}
+				SERIES_TAIL(out) += (REBCNT)(avail - avail_out);
+				if (mode == 2 && BrotliEncoderIsFinished(enc)) {
+					cms->finished = TRUE;
+					break;
+				}
+				if (avail_in == 0 && !BrotliEncoderHasMoreOutput(enc) && mode != 2) break;
+			}
+		}
+		break;
+	}
+#endif
+#ifdef INCLUDE_LZ4
+	case SYM_LZ4:
+		Process_Lz4_Stream(cms, in, len, mode, out);
+		break;
+#endif
+	}
+	TERM_SERIES(out);
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Output_Buffer(REBSER *port)
+/*
+**		Returns the port's buffer for output not read yet.
+**
+***********************************************************************/
+{
+	REBVAL *data = BLK_SKIP(port, STD_PORT_DATA);
+
+	if (!IS_BINARY(data)) Set_Binary(data, Make_Binary(COMPRESS_CHUNK));
+	return VAL_SERIES(data);
+}
+
+
+/***********************************************************************
+**
+*/	static void Open_Compress_Port(REBSER *port, REBVAL *state)
+/*
+***********************************************************************/
+{
+	REBVAL *spec = BLK_SKIP(port, STD_PORT_SPEC);
+	REBVAL *val;
+	REBCMS *cms;
+
+	if (!IS_OBJECT(spec)) Trap1(RE_INVALID_SPEC, spec);
+
+	MAKE_HANDLE(state, SYM_COMPRESS);
+	cms = (REBCMS *)VAL_HANDLE_CONTEXT_DATA(state);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_COMPRESS_METHOD);
+	if (!val || !IS_WORD(val)) goto invalid;
+	cms->method = VAL_WORD_CANON(val);
+
+	val = Obj_Value(spec, STD_PORT_SPEC_COMPRESS_DIRECTION);
+	if (!val || !IS_WORD(val)) goto invalid;
+	if (VAL_WORD_CANON(val) == SYM_DECOMPRESS) cms->decompress = TRUE;
+	else if (VAL_WORD_CANON(val) != SYM_COMPRESS) goto invalid;
+
+	val = Obj_Value(spec, STD_PORT_SPEC_COMPRESS_LEVEL);
+	cms->level = (val && IS_INTEGER(val)) ? Int32s(val, 0) : -1;
+
+	if (Begin_Compress_Stream(cms)) return;
+
+invalid:
+	Free_Hob(VAL_HANDLE_CTX(state));
+	SET_NONE(state);
+	Trap1(RE_INVALID_SPEC, spec);
+}
+
+
+/***********************************************************************
+**
+*/	static int Compress_Actor(REBVAL *ds, REBVAL *port_value, REBCNT action)
+/*
+***********************************************************************/
+{
+	REBSER *port;
+	REBVAL *state;
+	REBVAL *data;
+	REBVAL *arg;
+	REBCMS *cms = NULL;
+
+	port = Validate_Port_Value(port_value);
+
+	state = BLK_SKIP(port, STD_PORT_STATE);
+	if (IS_HANDLE(state)) {
+		if (NOT_VALID_CONTEXT_HANDLE(state, SYM_COMPRESS))
+			Trap_Port(RE_INVALID_PORT, port, 0);
+		cms = (REBCMS *)VAL_HANDLE_CONTEXT_DATA(state);
+	}
+
+	switch (action) {
+	case A_OPEN:
+		if (cms) Trap_Port(RE_ALREADY_OPEN, port, 0);
+		Open_Compress_Port(port, state);
+		return R_ARG1;
+
+	case A_OPENQ:
+		return cms ? R_TRUE : R_FALSE;
+
+	case A_CLOSE:
+		if (cms) {
+			Free_Hob(VAL_HANDLE_CTX(state));
+			SET_NONE(state);
+		}
+		return R_ARG1;
+
+	case A_WRITE:
+	case A_READ:
+	case A_FLUSH:
+	case A_UPDATE:
+		if (!cms) { // opened on demand
+			Open_Compress_Port(port, state);
+			cms = (REBCMS *)VAL_HANDLE_CONTEXT_DATA(state);
+		}
+		break;
+
+	default:
+		Trap1(RE_NO_PORT_ACTION, Get_Action_Word(action));
+	}
+
+	switch (action) {
+	case A_WRITE:
+		arg = D_ARG(2);
+		if (!ANY_BINSTR(arg) || !VAL_BYTE_SIZE(arg)) Trap_Arg(arg);
+		if (cms->finished) {
+			if (cms->decompress) break; // data after the end of the stream are ignored
+			// Writing after UPDATE starts a new stream:
+			End_Compress_Stream(cms);
+			if (!Begin_Compress_Stream(cms)) Trap_Port(RE_CANNOT_OPEN, port, 0);
+		}
+		Process_Stream(cms, VAL_BIN_DATA(arg), VAL_LEN(arg), 0, Output_Buffer(port));
+		break;
+
+	case A_FLUSH:
+		if (!cms->finished) Process_Stream(cms, NULL, 0, 1, Output_Buffer(port));
+		break;
+
+	case A_UPDATE:
+		if (!cms->finished && !cms->decompress) Process_Stream(cms, NULL, 0, 2, Output_Buffer(port));
+		break;
+
+	case A_READ:
+		// The buffer is given away, so no copy is made:
+		data = BLK_SKIP(port, STD_PORT_DATA);
+		if (IS_BINARY(data)) {
+			*D_RET = *data;
+			SET_NONE(data);
+		}
+		else Set_Binary(D_RET, Make_Binary(0));
+		return R_RET;
+	}
+	return R_ARG1;
+}
+
+
+/***********************************************************************
+**
+*/	void Init_Compress_Scheme(void)
+/*
+***********************************************************************/
+{
+	Register_Handle(SYM_COMPRESS, sizeof(REBCMS), (REB_HANDLE_FREE_FUNC)End_Compress_Stream);
+	Register_Scheme(SYM_COMPRESS, 0, Compress_Actor);
+}
@@ -263,6 +263,7 @@ static void free_crypt_cipher_context(CRYPT_CTX *ctx);
 		free_crypt_cipher_context(ctx);
 	}
 	ctx->state = CRYPT_PORT_NEEDS_INIT;
+	ctx->cipher_mode = MBEDTLS_MODE_NONE; // set below for CCM and GCM
 	switch (type) {
 
 	case SYM_AES_128_ECB:
@@ -1213,6 +1214,246 @@ failed:
 }
 
 
+#define TLS_MAX_FRAGMENT 16384	// max plaintext length in one record
+#define TLS_TAG_LEN      16
+#define TLS_EXPLICIT_LEN 8		// TLS 1.2 explicit nonce of the GCM suites
+
+/***********************************************************************
+**
+*/	static void Tls_Nonce(CRYPT_CTX *ctx, REBU64 seq, REBOOL explicit, REBYTE *nonce)
+/*
+**		Nonce of the record: the static IV with the sequence number
+**		XORed into its last 8 bytes (TLS 1.3 and CHACHA20-POLY1305).
+**		TLS 1.2 GCM suites use the IV's 4 bytes salt followed by
+**		the sequence number (as the explicit part of the nonce).
+**
+***********************************************************************/
+{
+	REBINT n;
+
+	COPY_MEM(nonce, ctx->IV, 12);
+	for (n = 11; n >= 4; n--, seq >>= 8) {
+		if (explicit) nonce[n] = (REBYTE)seq;
+		else nonce[n] ^= (REBYTE)seq;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Tls_Aead(CRYPT_CTX *ctx, REBOOL seal, REBYTE *nonce, REBYTE *aad, REBCNT aad_len, REBYTE *data, REBCNT len, REBYTE *tag)
+/*
+**		Seal or open the data in place. Returns 0 on success.
+**
+***********************************************************************/
+{
+#ifdef MBEDTLS_GCM_C
+	if (ctx->cipher_mode == MBEDTLS_MODE_GCM) {
+		mbedtls_gcm_context *gcm = (mbedtls_gcm_context *)ctx->cipher_ctx;
+		if (seal)
+			return mbedtls_gcm_crypt_and_tag(gcm, MBEDTLS_GCM_ENCRYPT, len, nonce, 12, aad, aad_len, data, data, TLS_TAG_LEN, tag);
+		return mbedtls_gcm_auth_decrypt(gcm, len, nonce, 12, aad, aad_len, tag, TLS_TAG_LEN, data, data);
+	}
+#endif
+#ifdef MBEDTLS_CHACHAPOLY_C
+	if (ctx->cipher_type == SYM_CHACHA20_POLY1305) {
+		CHACHAPOLY_CTX *poly = (CHACHAPOLY_CTX *)ctx->cipher_ctx;
+		if (seal)
+			return mbedtls_chachapoly_encrypt_and_tag(poly, len, nonce, aad, aad_len, data, data, tag);
+		return mbedtls_chachapoly_auth_decrypt(poly, len, nonce, aad, aad_len, tag, data, data);
+	}
+#endif
+	return -1;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Tls_Seal_Records(CRYPT_CTX *ctx, REBYTE type, REBU64 seq, REBYTE *data, REBCNT len, REBOOL tls13)
+/*
+**		Split data to records, each with its header and tag.
+**
+***********************************************************************/
+{
+	REBSER *out;
+	REBYTE *bp;
+	REBYTE  nonce[12];
+	REBYTE  aad[13];
+	REBCNT  count = (len + TLS_MAX_FRAGMENT - 1) / TLS_MAX_FRAGMENT;
+	REBCNT  extra;
+	REBCNT  frag;
+	REBCNT  plain;
+	REBCNT  payload;
+	REBOOL  explicit = !tls13 && ctx->cipher_mode == MBEDTLS_MODE_GCM;
+	REBINT  n;
+
+	if (count == 0) count = 1; // empty record is still a record
+	extra = 5 + TLS_TAG_LEN + (tls13 ? 1 : 0) + (explicit ? TLS_EXPLICIT_LEN : 0);
+	out = Make_Binary(len + count * extra);
+	bp = BIN_HEAD(out);
+
+	do {
+		frag = MIN(len, TLS_MAX_FRAGMENT);
+		plain = frag + (tls13 ? 1 : 0);
+		payload = plain + TLS_TAG_LEN + (explicit ? TLS_EXPLICIT_LEN : 0);
+
+		bp[0] = tls13 ? 23 : type; // TLS 1.3 hides the real type in the encrypted part
+		bp[1] = 3;
+		bp[2] = 3;
+		bp[3] = (REBYTE)(payload >> 8);
+		bp[4] = (REBYTE)payload;
+
+		Tls_Nonce(ctx, seq, explicit, nonce);
+		if (tls13) {
+			COPY_MEM(aad, bp, 5);
+		} else {
+			for (n = 7; n >= 0; n--) aad[n] = (REBYTE)(seq >> (8 * (7 - n)));
+			aad[8]  = type;
+			aad[9]  = 3;
+			aad[10] = 3;
+			aad[11] = (REBYTE)(frag >> 8);
+			aad[12] = (REBYTE)frag;
+		}
+		bp += 5;
+		if (explicit) {
+			COPY_MEM(bp, nonce + 4, TLS_EXPLICIT_LEN);
+			bp += TLS_EXPLICIT_LEN;
+		}
+		COPY_MEM(bp, data, frag);
+		if (tls13) bp[frag] = type;
+		if (Tls_Aead(ctx, TRUE, nonce, aad, tls13 ? 5 : 13, bp, plain, bp + plain)) {
+			Free_Series(out);
+			return NULL;
+		}
+		bp += plain + TLS_TAG_LEN;
+		data += frag;
+		len -= frag;
+		seq++;
+	} while (len > 0);
+
+	SERIES_TAIL(out) = (REBCNT)(bp - BIN_HEAD(out));
+	TERM_SERIES(out);
+	return out;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Tls_Open_Record(CRYPT_CTX *ctx, REBYTE type, REBU64 seq, REBYTE *data, REBCNT len, REBOOL tls13)
+/*
+**		Decrypt and verify one record fragment (without its header).
+**		Returns NULL when the record is not authentic.
+**
+***********************************************************************/
+{
+	REBSER *out;
+	REBYTE  nonce[12];
+	REBYTE  aad[13];
+	REBCNT  plain;
+	REBOOL  explicit = !tls13 && ctx->cipher_mode == MBEDTLS_MODE_GCM;
+	REBINT  n;
+
+	if (len < TLS_TAG_LEN + (tls13 ? 1 : 0) + (explicit ? TLS_EXPLICIT_LEN : 0)) return NULL;
+
+	Tls_Nonce(ctx, seq, FALSE, nonce);
+	if (explicit) {
+		COPY_MEM(nonce + 4, data, TLS_EXPLICIT_LEN);
+		data += TLS_EXPLICIT_LEN;
+		len -= TLS_EXPLICIT_LEN;
+	}
+	plain = len - TLS_TAG_LEN;
+
+	if (tls13) {
+		aad[0] = type;
+		aad[1] = 3;
+		aad[2] = 3;
+		aad[3] = (REBYTE)(len >> 8);
+		aad[4] = (REBYTE)len;
+	} else {
+		for (n = 7; n >= 0; n--) aad[n] = (REBYTE)(seq >> (8 * (7 - n)));
+		aad[8]  = type;
+		aad[9]  = 3;
+		aad[10] = 3;
+		aad[11] = (REBYTE)(plain >> 8);
+		aad[12] = (REBYTE)plain;
+	}
+
+	out = Make_Binary(plain);
+	COPY_MEM(BIN_HEAD(out), data, plain);
+	if (Tls_Aead(ctx, FALSE, nonce, aad, tls13 ? 5 : 13, BIN_HEAD(out), plain, data + plain)) {
+		Free_Series(out);
+		return NULL;
+	}
+	if (tls13) {
+		// Remove the padding, the content type is the last non zero byte:
+		while (plain > 0 && BIN_HEAD(out)[plain - 1] == 0) plain--;
+		if (plain == 0) {
+			Free_Series(out);
+			return NULL;
+		}
+	}
+	SERIES_TAIL(out) = plain;
+	TERM_SERIES(out);
+	return out;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(tls_record)
+/*
+//	tls-record: native [
+//		"Seals data into TLS records, or opens a received record, using an AEAD crypt port."
+//		port     [port!]    "Crypt port with the traffic key and IV (AES-GCM or CHACHA20-POLY1305)"
+//		type     [integer!] "Record content type"
+//		sequence [integer!] "Sequence number of the (first) record"
+//		data     [binary!]  "Data to seal, or the record's fragment to open"
+//		/tls13   "TLS 1.3 record protection (inner content type)"
+//	]
+**
+**		The port's direction decides if the data are sealed or opened.
+**		Sealed data are split to records of max 16kB (each one uses
+**		the next sequence number) and returned with record headers.
+**		Opened TLS 1.3 records have the inner content type as the last
+**		byte. Returns NONE when the record is not authentic.
+**
+***********************************************************************/
+{
+	REBVAL *val_port = D_ARG(1);
+	REBINT  type     = VAL_INT32(D_ARG(2));
+	REBU64  seq      = (REBU64)VAL_INT64(D_ARG(3));
+	REBVAL *val_data = D_ARG(4);
+	REBOOL  ref_tls13 = D_REF(5);
+	REBSER *port = VAL_PORT(val_port);
+	REBVAL *state = BLK_SKIP(port, STD_PORT_STATE);
+	CRYPT_CTX *ctx;
+	REBSER *out;
+
+	if (!IS_HANDLE(state) || VAL_HANDLE_TYPE(state) != SYM_CRYPT)
+		Trap_Port(RE_NOT_OPEN, port, 0);
+	ctx = (CRYPT_CTX *)VAL_HANDLE_CONTEXT_DATA(state);
+
+	if (
+		(ctx->cipher_mode != MBEDTLS_MODE_GCM && ctx->cipher_type != SYM_CHACHA20_POLY1305)
+		|| ctx->IV_len != 12 || type < 0 || type > 255
+	) Trap_Port(RE_FEATURE_NA, port, 0);
+
+	if (ctx->state == CRYPT_PORT_NEEDS_INIT) {
+		// sets the key
+		if (Crypt_Init(ctx)) Trap_Port(RE_INVALID_SPEC, port, 0);
+	}
+
+	if (ctx->operation == MBEDTLS_ENCRYPT)
+		out = Tls_Seal_Records(ctx, (REBYTE)type, seq, VAL_BIN_AT(val_data), VAL_LEN(val_data), ref_tls13);
+	else
+		out = Tls_Open_Record(ctx, (REBYTE)type, seq, VAL_BIN_AT(val_data), VAL_LEN(val_data), ref_tls13);
+
+	if (!out) return R_NONE;
+	SET_BINARY(D_RET, out);
+	return R_RET;
+}
+
+
 /***********************************************************************
 **
 */	void Init_Crypt_Scheme(void)
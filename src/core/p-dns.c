@@ -136,6 +136,23 @@ pick:
 	case A_UPDATE:
 		return R_NONE;
 
+	case A_MODIFY:
+		// Seconds for which lookups are cached (for all DNS ports):
+		if (!IS_WORD(arg)) Trap1(RE_BAD_FILE_MODE, arg);
+		switch (VAL_WORD_CANON(arg)) {
+			case SYM_TTL:          sock->modify.mode = RDM_DNS_TTL; break;
+			case SYM_NEGATIVE_TTL: sock->modify.mode = RDM_DNS_NEGATIVE_TTL; break;
+			default: Trap1(RE_BAD_FILE_MODE, arg);
+		}
+		spec = D_ARG(3);
+		if (IS_INTEGER(spec) && VAL_INT64(spec) >= 0 && VAL_INT64(spec) <= MAX_I32)
+			sock->modify.value = VAL_INT32(spec);
+		else if (IS_TIME(spec) && VAL_TIME(spec) >= 0)
+			sock->modify.value = (REBCNT)MIN(VAL_TIME(spec) / SEC_SEC, MAX_I32);
+		else Trap2(RE_INVALID_VALUE_FOR, spec, arg);
+		OS_Do_Device(sock, RDC_MODIFY);
+		return R_ARG3;
+
 	default:
 		Trap1(RE_NO_PORT_ACTION, Get_Action_Word(action));
 	}
@@ -95,6 +95,7 @@ REBREQ *req;		//!!! move this global
 			//RL_Print("event queue increased to :%d\n", SERIES_REST(VAL_SERIES(state)));
 		}
 	}
+	GC_BARRIER(VAL_SERIES(state));
 	VAL_TAIL(state)++;
 	value = VAL_BLK_TAIL(state);
 	SET_END(value);
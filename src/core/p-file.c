@@ -262,6 +262,30 @@ REBINT Mode_Syms[] = {
 	REBVAL *ds = DS_RETURN;
 	REBINT res;
 
+	if ((args & AM_READ_MMAP) && len > 0) {
+		// Map the file instead of copying it into a new series. When
+		// the device cannot map it (empty, virtual, not a regular file),
+		// it is read as usual.
+		SET_FLAG(file->modes, RFM_MMAP);
+		file->length = len;
+		res = OS_Do_Device(file, RDC_READ);
+		CLR_FLAG(file->modes, RFM_MMAP);
+		if (res >= 0) {
+			ser = Make_Mmap_Series(file->data, file->actual);
+			Set_Series(REB_BINARY, ds, ser);
+			if (args & (AM_READ_STRING | AM_READ_LINES)) {
+				REBSER *str = Decode_UTF_String(BIN_HEAD(ser), file->actual, -1, TRUE, NULL);
+				if (!str) return;
+				Set_String(ds, str);
+				Free_Series(ser); // not referenced anymore, so unmap it now
+				if (args & AM_READ_LINES) Set_Block(ds, Split_Lines(ds));
+			}
+			return;
+		}
+		if (res != -RFE_NO_MMAP) return;
+		file->error = 0;
+	}
+
 resize:
 	// Allocate read result buffer:
 	ser = Make_Binary(len);
@@ -34,6 +34,9 @@
 #include "reb-evtypes.h"
 
 #define NET_BUF_SIZE 32*1024
+#define MAX_NET_READ (64*1024*1024)	// max READ-SIZE option
+#define NET_DGRAM_SIZE 2048		// default buffer of a batched datagram
+#define MAX_DGRAM_SIZE 65536
 
 enum Transport_Types {
 	TRANSPORT_TCP,
@@ -139,6 +142,173 @@ enum Transport_Types {
 }
 
 
+/***********************************************************************
+**
+*/	static REBREQ *File_Port_Request(REBVAL *value)
+/*
+**		Returns request of an open file port or NULL.
+**
+***********************************************************************/
+{
+	REBVAL *state = BLK_SKIP(VAL_PORT(value), STD_PORT_STATE);
+	REBREQ *file;
+
+	if (!IS_HANDLE(state) || VAL_HANDLE_TYPE(state) != SYM_PORT_STATEX) return NULL;
+	file = (REBREQ *)VAL_HANDLE_CONTEXT_DATA(state);
+	if (file->device != RDI_FILE || !IS_OPEN(file) || GET_FLAG(file->modes, RFM_DIR)) return NULL;
+	return file;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Make_Net_Parts(REBSER *port, REBREQ *sock, REBVAL *block)
+/*
+**		Makes a list of REBIOV parts (as the sock data) for a gather
+**		write of a block of strings and binaries. Returns their total
+**		length.
+**
+**		The port's data is set to a block with the parts (keeping them
+**		GC safe) and a binary with the list as its last value.
+**
+***********************************************************************/
+{
+	REBCNT cnt = VAL_LEN(block);
+	REBSER *parts;
+	REBSER *list;
+	REBIOV *iov;
+	REBVAL *val;
+	REBCNT len = 0;
+	REBCNT n;
+
+	for (val = VAL_BLK_DATA(block); NOT_END(val); val++) {
+		if (!IS_BINARY(val) && !IS_STRING(val)) Trap_Arg(val);
+		if (VAL_LEN(val) > MAX_I32 - len) Trap_Arg(val);
+		len += VAL_LEN(val);
+	}
+
+	parts = Copy_Values(VAL_BLK_DATA(block), cnt);
+	Set_Block(OFV(port, STD_PORT_DATA), parts);
+	list = Make_Binary((cnt + 1) * sizeof(REBIOV));
+	Set_Binary(Append_Value(parts), list);
+
+	iov = (REBIOV *)BIN_HEAD(list);
+	for (n = 0, val = BLK_HEAD(parts); n < cnt; n++, val++) {
+		iov[n].data = VAL_BIN_DATA(val);
+		iov[n].length = VAL_LEN(val);
+	}
+	iov[cnt].data = NULL;
+	iov[cnt].length = 0;
+	sock->data = (REBYTE *)iov;
+	return len;
+}
+
+
+/***********************************************************************
+**
+*/	static void Make_Datagram_Buffer(REBSER *port, REBREQ *sock)
+/*
+**		Prepares the port's data for a batched UDP READ: a binary with
+**		a list of REBDGM items followed by their buffers (of READ-SIZE
+**		or NET_DGRAM_SIZE bytes). Longer datagrams are truncated.
+**
+***********************************************************************/
+{
+	REBCNT cnt = sock->net.batch;
+	REBCNT size = sock->net.read_size ? MIN(sock->net.read_size, MAX_DGRAM_SIZE) : NET_DGRAM_SIZE;
+	REBSER *buf = Make_Binary(cnt * (sizeof(REBDGM) + size));
+	REBDGM *dgm = (REBDGM *)BIN_HEAD(buf);
+	REBYTE *bp = (REBYTE *)(dgm + cnt);
+	REBCNT n;
+
+	Set_Binary(OFV(port, STD_PORT_DATA), buf);
+	for (n = 0; n < cnt; n++, bp += size) {
+		dgm[n].data = bp;
+		dgm[n].length = size;
+	}
+	sock->data = (REBYTE *)dgm;
+	sock->length = cnt;
+	sock->actual = 0;
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_Datagram_Records(REBVAL *data, REBREQ *sock)
+/*
+**		Replaces the buffer of a batched UDP READ with a block of
+**		received datagrams as records: [binary! remote-ip remote-port].
+**
+***********************************************************************/
+{
+	REBDGM *dgm = (REBDGM *)VAL_BIN(data);
+	REBCNT cnt = sock->actual;
+	REBSER *blk = Make_Block(3 * cnt);
+	REBSER *bin;
+	REBCNT n;
+
+	SAVE_SERIES(blk);
+	for (n = 0; n < cnt; n++) {
+		bin = Make_Binary(dgm[n].length);
+		COPY_MEM(BIN_HEAD(bin), dgm[n].data, dgm[n].length);
+		SERIES_TAIL(bin) = dgm[n].length;
+		TERM_SERIES(bin);
+		Set_Binary(Append_Value(blk), bin);
+		Set_Tuple(Append_Value(blk), (REBYTE *)&dgm[n].remote_ip, 4);
+		SET_INTEGER(Append_Value(blk), dgm[n].remote_port);
+	}
+	UNSAVE_SERIES(blk);
+	Set_Block(data, blk);
+}
+
+
+/***********************************************************************
+**
+*/	static void Make_Datagram_List(REBSER *port, REBREQ *sock, REBVAL *block)
+/*
+**		Makes a REBDGM list (as the sock data) for a batched UDP WRITE
+**		of a block of records: [data remote-ip remote-port]. The data
+**		is a binary or string, NONE address is the port's remote one.
+**
+**		The port's data is set to a block with the records (keeping
+**		them GC safe) and a binary with the list as its last value.
+**
+***********************************************************************/
+{
+	REBCNT len = VAL_LEN(block);
+	REBCNT cnt = len / 3;
+	REBSER *records;
+	REBSER *list;
+	REBDGM *dgm;
+	REBVAL *val;
+	REBCNT n;
+
+	if (len % 3) Trap_Arg(block);
+	for (val = VAL_BLK_DATA(block); NOT_END(val); val += 3) {
+		if (!IS_BINARY(val) && !IS_STRING(val)) Trap_Arg(val);
+		if (!IS_NONE(val+1) && !(IS_TUPLE(val+1) && VAL_TUPLE_LEN(val+1) == 4)) Trap_Arg(val+1);
+		if (!IS_NONE(val+2) && !(IS_INTEGER(val+2) && VAL_UNT64(val+2) <= 0xFFFF)) Trap_Arg(val+2);
+	}
+
+	records = Copy_Values(VAL_BLK_DATA(block), len);
+	Set_Block(OFV(port, STD_PORT_DATA), records);
+	list = Make_Binary(cnt * sizeof(REBDGM));
+	Set_Binary(Append_Value(records), list);
+
+	dgm = (REBDGM *)BIN_HEAD(list);
+	for (n = 0, val = BLK_HEAD(records); n < cnt; n++, val += 3) {
+		dgm[n].data = VAL_BIN_DATA(val);
+		dgm[n].length = VAL_LEN(val);
+		if (IS_TUPLE(val+1)) memcpy(&dgm[n].remote_ip, VAL_TUPLE(val+1), 4);
+		else dgm[n].remote_ip = sock->net.remote_ip;
+		dgm[n].remote_port = IS_INTEGER(val+2) ? VAL_INT32(val+2) : sock->net.remote_port;
+	}
+	sock->data = (REBYTE *)dgm;
+	sock->length = cnt;
+	sock->actual = 0;
+}
+
+
 /***********************************************************************
 **
 */	static void Accept_New_Port(REBVAL *ds, REBSER *port, REBREQ *sock)
@@ -252,6 +422,7 @@ enum Transport_Types {
 			return R_FALSE;
 
 		case A_UPDATE:	// allowed after a close
+		case A_MODIFY:	// options may be set before the open
 			break;
 
 		default:
@@ -267,7 +438,10 @@ enum Transport_Types {
 		// This is normally called by the WAKE-UP function.
 		arg = OFV(port, STD_PORT_DATA);
 		if (sock->command == RDC_READ) {
-			if (ANY_BINSTR(arg)) VAL_TAIL(arg) += sock->actual;
+			if (GET_FLAG(sock->modes, RST_BATCH)) {
+				if (IS_BINARY(arg)) Set_Datagram_Records(arg, sock);
+			}
+			else if (ANY_BINSTR(arg)) VAL_TAIL(arg) += sock->actual;
 		}
 		else if (sock->command == RDC_WRITE) {
 			SET_NONE(arg);  // Write is done.
@@ -282,14 +456,26 @@ enum Transport_Types {
 				&& !GET_FLAG(sock->state, RSM_CONNECT))
 			Trap_Port(RE_NOT_CONNECTED, port, -15);
 
+		if (GET_FLAG(sock->modes, RST_UDP) && sock->net.batch) {
+			// Receive more datagrams at once (as a block on UPDATE):
+			SET_FLAG(sock->modes, RST_BATCH);
+			Make_Datagram_Buffer(port, sock);
+			if (OS_Do_Device(sock, RDC_READ) < 0)
+				Trap_Port(RE_READ_ERROR, port, sock->error);
+			break;
+		}
+		CLR_FLAG(sock->modes, RST_BATCH);
+
 		// Setup the read buffer (allocate a buffer if needed):
 		arg = OFV(port, STD_PORT_DATA);
 		if (!IS_STRING(arg) && !IS_BINARY(arg)) {
 			Set_Binary(arg, Make_Binary(NET_BUF_SIZE));
 		}
 		ser = VAL_SERIES(arg);
+		// Extend it by the READ-SIZE option or by the current transfer size:
+		len = sock->net.read_size ? sock->net.read_size : MAX(NET_BUF_SIZE, sock->net.transfer);
 		sock->length = SERIES_AVAIL(ser); // space available
-		if (sock->length < NET_BUF_SIZE/2) Extend_Series(ser, NET_BUF_SIZE);
+		if (sock->length < len/2) Extend_Series(ser, len);
 		sock->length = SERIES_AVAIL(ser);
 		sock->data = STR_TAIL(ser); // write at tail
 		//if (SERIES_TAIL(ser) == 0)
@@ -313,18 +499,74 @@ enum Transport_Types {
 				&& !GET_FLAG(sock->state, RSM_CONNECT))
 			Trap_Port(RE_NOT_CONNECTED, port, -15);
 
-		// Determine length. Clip /PART to size of string if needed.
 		spec = D_ARG(2);
-		len = VAL_LEN(spec);
+		if (IS_PORT(spec) && !GET_FLAG(sock->modes, RST_UDP)) {
+			// Send the open file from its position (or /SEEK index) without
+			// reading it into a series (using sendfile where available):
+			REBREQ *file = File_Port_Request(spec);
+			REBI64 index, size;
+			if (!file) Trap_Arg(spec);
+			size  = file->file.size;
+			index = (refs & AM_WRITE_SEEK) ? Int64s(D_ARG(ARG_WRITE_INDEX), 0) : file->file.index;
+			if (index > size) index = size;
+			size -= index;
+			if (refs & AM_WRITE_PART) {
+				REBI64 n = Int64s(D_ARG(ARG_WRITE_LENGTH), 0);
+				if (n < size) size = n;
+			}
+			// One WRITE sends at most MAX_I32 bytes. The file port is moved
+			// after the sent part (like READ), so the rest can be sent by
+			// another WRITE until the file port is at its tail:
+			if (size > MAX_I32) size = MAX_I32;
+			file->file.index = index + size;
+			SET_FLAG(file->modes, RFM_RESEEK);
+
+			*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
+			SET_FLAG(sock->modes, RST_SENDFILE);
+			sock->net.file = file;
+			sock->net.file_index = index;
+			sock->length = (REBCNT)size;
+			sock->data = 0;
+			sock->actual = 0;
+
+			result = OS_Do_Device(sock, RDC_WRITE);
+			if (result < 0) Trap_Port(RE_WRITE_ERROR, port, sock->error);
+			if (result == DR_DONE) SET_NONE(OFV(port, STD_PORT_DATA));
+			break;
+		}
+		CLR_FLAG(sock->modes, RST_SENDFILE);
+		CLR_FLAG(sock->modes, RST_GATHER);
+		CLR_FLAG(sock->modes, RST_BATCH);
+
+		if (IS_BLOCK(spec) && GET_FLAG(sock->modes, RST_UDP)) {
+			// Send datagrams of the block's records at once:
+			Make_Datagram_List(port, sock, spec);
+			SET_FLAG(sock->modes, RST_BATCH);
+			result = OS_Do_Device(sock, RDC_WRITE);
+			if (result < 0) Trap_Port(RE_WRITE_ERROR, port, sock->error);
+			if (result == DR_DONE) SET_NONE(OFV(port, STD_PORT_DATA));
+			break;
+		}
+		if (IS_BLOCK(spec)) {
+			// Send strings and binaries of the block (like a header and
+			// a body) together without joining them into one series:
+			len = Make_Net_Parts(port, sock, spec);
+			SET_FLAG(sock->modes, RST_GATHER);
+		}
+		else {
+			len = VAL_LEN(spec);
+			*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
+			sock->data = VAL_BIN_DATA(spec);
+		}
+
+		// Clip /PART to size of string if needed.
 		if (refs & AM_WRITE_PART) {
 			REBCNT n = Int32s(D_ARG(ARG_WRITE_LENGTH), 0);
 			if (n <= len) len = n;
 		}
 
 		// Setup the write:
-		*OFV(port, STD_PORT_DATA) = *spec;	// keep it GC safe
 		sock->length = len;
-		sock->data = VAL_BIN_DATA(spec);
 		sock->actual = 0;
 
 		//Print("(write length %d)", len);
@@ -352,6 +594,24 @@ enum Transport_Types {
 		Ret_Query_Net(port, sock, D_RET, D_ARG(ARG_QUERY_FIELD));
 		break;
 
+	case A_MODIFY:
+		// Set a transfer option (value is D_ARG(3)):
+		spec = D_ARG(3);
+		if (IS_WORD(arg) && VAL_WORD_CANON(arg) == SYM_READ_SIZE) {
+			if (!IS_INTEGER(spec) || VAL_INT64(spec) < 0 || VAL_INT64(spec) > MAX_NET_READ)
+				Trap2(RE_INVALID_VALUE_FOR, spec, arg);
+			sock->net.read_size = VAL_INT32(spec); // zero for the default
+		}
+		else if (IS_WORD(arg) && VAL_WORD_CANON(arg) == SYM_BATCH) {
+			// Datagrams per UDP READ (zero for a binary with just one):
+			if (!GET_FLAG(sock->modes, RST_UDP)) Trap1(RE_BAD_FILE_MODE, arg);
+			if (!IS_INTEGER(spec) || VAL_INT64(spec) < 0 || VAL_INT64(spec) > MAX_NET_BATCH)
+				Trap2(RE_INVALID_VALUE_FOR, spec, arg);
+			sock->net.batch = VAL_INT32(spec);
+		}
+		else Trap1(RE_BAD_FILE_MODE, arg);
+		return R_ARG3;
+
 	case A_OPENQ:
 		// Connect for clients, bind for servers:
 		if (sock->state & ((1<<RSM_CONNECT) | (1<<RSM_BIND))) return R_TRUE;
@@ -86,7 +86,7 @@ act_blk:
 		save_port = *D_ARG(1); // save for return
 		*D_ARG(1) = *state;
 		result = T_Block(ds, action);
-		SET_FLAG(Eval_Signals, SIG_EVENT_PORT);
+		SET_SIGNAL(SIG_EVENT_PORT);
 		if (action == A_INSERT || action == A_APPEND || action == A_REMOVE) {
 			*D_RET = save_port;
 			break;
@@ -96,7 +96,7 @@ act_blk:
 	case A_CLEAR:
 		VAL_TAIL(state) = 0;
 		VAL_BLK_TERM(state);
-		CLR_FLAG(Eval_Signals, SIG_EVENT_PORT);
+		CLR_SIGNAL(SIG_EVENT_PORT);
 		break;
 
 	case A_LENGTHQ:
@@ -271,10 +271,23 @@ static void Make_CRC32_Table(void) {
 		CRC32_Table[n]=c;
 	}
 }
+#endif
 
-REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len) {
+/***********************************************************************
+**
+*/	REBCNT Update_CRC32(REBCNT crc, REBYTE *buf, REBLEN len)
+/*
+**		Continues CRC32 of previous data (use 0 for the first part).
+**		The libdeflate's version uses carry-less multiplication
+**		when the CPU has it.
+**
+***********************************************************************/
+{
+#ifdef INCLUDE_DEFLATE
+	return libdeflate_crc32(crc, buf, len);
+#else
 	u32 c = ~crc;
-	int n;
+	REBLEN n;
 
 	if(!CRC32_Table) Make_CRC32_Table();
 
@@ -282,8 +295,8 @@ REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len) {
 		c = CRC32_Table[(c^buf[n])&0xff]^(c>>8);
 
 	return ~c;
-}
 #endif
+}
 
 /***********************************************************************
 **
@@ -291,9 +304,64 @@ REBCNT Update_CRC32(u32 crc, REBYTE *buf, int len) {
 /*
 ***********************************************************************/
 {
-#ifdef INCLUDE_DEFLATE
-	return libdeflate_crc32(0, buf, len);
+	return Update_CRC32(0, buf, len);
+}
+
+
+/***********************************************************************
+**
+**  CRC32C (Castagnoli polynomial, as used by iSCSI, ext4 or SCTP)
+**
+***********************************************************************/
+
+#define CRC32C_POLY 0x82F63B78	// reflected 0x1EDC6F41
+
+static u32 CRC32C_Table[256];
+
+#ifdef CPU_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <nmmintrin.h>
+#endif
+
+TARGET_CPU("sse4.2")
+static u32 CRC32C_SSE42(u32 c, const REBYTE *buf, REBLEN len)
+{
+	for (; len > 0 && ((REBUPT)buf & 7); len--) c = _mm_crc32_u8(c, *buf++);
+#if defined(__x86_64__) || defined(_M_X64)
+	for (; len >= 8; len -= 8, buf += 8) c = (u32)_mm_crc32_u64(c, *(const u64*)buf);
 #else
-	return Update_CRC32(U32_C(0x00000000), buf, len);
+	for (; len >= 4; len -= 4, buf += 4) c = _mm_crc32_u32(c, *(const u32*)buf);
+#endif
+	for (; len > 0; len--) c = _mm_crc32_u8(c, *buf++);
+	return c;
+}
+#endif
+
+/***********************************************************************
+**
+*/	REBCNT Update_CRC32C(REBCNT crc, REBYTE *buf, REBLEN len)
+/*
+**		Continues CRC32C of previous data (use 0 for the first part).
+**		Uses the crc32 instruction of SSE4.2 when available.
+**
+***********************************************************************/
+{
+	u32 c = ~crc;
+	REBLEN n;
+
+#ifdef CPU_X86
+	if (Get_CPU_Features() & CPU_SSE42) return ~CRC32C_SSE42(c, buf, len);
 #endif
+	if (!CRC32C_Table[1]) {
+		u32 k, t;
+		for (n = 0; n < 256; n++) {
+			for (t = n, k = 0; k < 8; k++) t = (t & 1) ? (t >> 1) ^ CRC32C_POLY : t >> 1;
+			CRC32C_Table[n] = t;
+		}
+	}
+	for (n = 0; n < len; n++)
+		c = CRC32C_Table[(c ^ buf[n]) & 0xff] ^ (c >> 8);
+	return ~c;
 }
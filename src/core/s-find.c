@@ -25,11 +25,221 @@
 **  Section: strings
 **  Author:  Carl Sassenrath, Oldes
 **  Notes:
+**		Forward searches (skip 1) over longer ranges first jump to
+**		positions where the first byte (and for byte exact searches
+**		also the last byte) of the pattern may match. These are found
+**		with SSE2 or AVX2 (chosen at runtime) when available and with
+**		memchr or a plain loop otherwise. The plain loops then compare
+**		only at those positions, so results stay the same.
 **
 ***********************************************************************/
 
 #include "sys-core.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FIND_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FIND_AVX2
+#endif
+#endif
+
+#define FAST_FIND_MIN 32 // shorter ranges are just scanned by the loops
+
+typedef struct Reb_Find_Fast {
+	REBYTE first[2];	// bytes which may start a match
+	REBYTE last[2];		// bytes which may end it (when last_at > 0)
+	REBCNT last_at;		// offset of the last byte (0 = not checked)
+	REBFLG lead;		// any UTF-8 lead byte may start a match too
+} REBFF;
+
+#ifdef _MSC_VER
+#include <intrin.h>
+static REBCNT Low_Bit(REBCNT mask) {unsigned long n; _BitScanForward(&n, mask); return n;}
+#else
+#define Low_Bit(mask) ((REBCNT)__builtin_ctz(mask))
+#endif
+
+
+/***********************************************************************
+**
+*/	static REBFLG Set_Fast_Bytes(REBYTE *bytes, REBU32 c, REBFLG uncase)
+/*
+**		Set two bytes which are equal to the char c or, when uncase,
+**		all bytes which lowercase to it (c must be lowercased already).
+**		Returns FALSE when there is no such byte.
+**
+***********************************************************************/
+{
+	REBCNT n = 0;
+	REBU32 up;
+
+	if (!uncase || c >= UNICODE_CASES) {
+		if (c > 0xFF) return FALSE;
+		bytes[0] = bytes[1] = (REBYTE)c;
+		return TRUE;
+	}
+	if (c <= 0xFF && LO_CASE(c) == c) bytes[n++] = (REBYTE)c;
+	up = UP_CASE(c);
+	if (up <= 0xFF && up != c && LO_CASE(up) == c) bytes[n++] = (REBYTE)up;
+	if (n == 0) return FALSE;
+	if (n == 1) bytes[1] = bytes[0];
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Init_Fast_Find(REBFF *ff, REBU32 c, const REBYTE *pat, REBCNT last_at, REBFLG uncase, REBFLG lead)
+/*
+**		Prepare the search for positions where the char c may start
+**		a match. When last_at > 0, pat[last_at] must also match.
+**		With lead (UTF-8 series) non-ASCII chars are found by their
+**		lead bytes only, so a position is always a char boundary.
+**		Returns FALSE if there is nothing to search for.
+**
+***********************************************************************/
+{
+	ff->lead = lead;
+	ff->last_at = last_at;
+	if (!Set_Fast_Bytes(ff->first, c, uncase)) {
+		if (!lead) return FALSE;
+		ff->first[0] = ff->first[1] = 0xC0;
+	}
+	if (lead) {
+		if (ff->first[0] > 0x7F) ff->first[0] = 0xC0;
+		if (ff->first[1] > 0x7F) ff->first[1] = 0xC0;
+	}
+	if (last_at > 0) {
+		c = pat[last_at];
+		Set_Fast_Bytes(ff->last, uncase ? LO_CASE(c) : c, uncase);
+	}
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Next_Fast_Bytes(const REBYTE *data, REBCNT index, REBCNT limit, const REBFF *ff)
+/*
+**		Portable version of Next_Fast_Find.
+**
+***********************************************************************/
+{
+	const REBYTE *bp;
+	REBYTE b;
+
+	if (ff->first[0] == ff->first[1] && !ff->lead) {
+		while (index < limit) {
+			bp = memchr(data + index, ff->first[0], limit - index);
+			if (!bp) break;
+			index = (REBCNT)(bp - data);
+			if (!ff->last_at) return index;
+			b = data[index + ff->last_at];
+			if (b == ff->last[0] || b == ff->last[1]) return index;
+			index++;
+		}
+		return NOT_FOUND;
+	}
+
+	for (; index < limit; index++) {
+		b = data[index];
+		if (b == ff->first[0] || b == ff->first[1] || (ff->lead && b >= 0xC0)) {
+			if (!ff->last_at) return index;
+			b = data[index + ff->last_at];
+			if (b == ff->last[0] || b == ff->last[1]) return index;
+		}
+	}
+	return NOT_FOUND;
+}
+
+
+#ifdef FIND_SSE2
+/***********************************************************************
+**
+*/	static REBCNT Next_Fast_SSE2(const REBYTE *data, REBCNT index, REBCNT limit, const REBFF *ff)
+/*
+***********************************************************************/
+{
+	const __m128i f0 = _mm_set1_epi8((char)ff->first[0]);
+	const __m128i f1 = _mm_set1_epi8((char)ff->first[1]);
+	const __m128i l0 = _mm_set1_epi8((char)ff->last[0]);
+	const __m128i l1 = _mm_set1_epi8((char)ff->last[1]);
+	const __m128i lead = _mm_set1_epi8((char)0xC0);
+	__m128i b, m;
+	REBCNT mask;
+
+	for (; index + 16 <= limit; index += 16) {
+		b = _mm_loadu_si128((const __m128i *)(data + index));
+		m = _mm_or_si128(_mm_cmpeq_epi8(b, f0), _mm_cmpeq_epi8(b, f1));
+		if (ff->lead) m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_max_epu8(b, lead), b));
+		if (ff->last_at) {
+			b = _mm_loadu_si128((const __m128i *)(data + index + ff->last_at));
+			m = _mm_and_si128(m, _mm_or_si128(_mm_cmpeq_epi8(b, l0), _mm_cmpeq_epi8(b, l1)));
+		}
+		mask = (REBCNT)_mm_movemask_epi8(m);
+		if (mask) return index + Low_Bit(mask);
+	}
+	return Next_Fast_Bytes(data, index, limit, ff);
+}
+#endif
+
+
+#ifdef FIND_AVX2
+__attribute__((target("avx2")))
+/***********************************************************************
+**
+*/	static REBCNT Next_Fast_AVX2(const REBYTE *data, REBCNT index, REBCNT limit, const REBFF *ff)
+/*
+***********************************************************************/
+{
+	const __m256i f0 = _mm256_set1_epi8((char)ff->first[0]);
+	const __m256i f1 = _mm256_set1_epi8((char)ff->first[1]);
+	const __m256i l0 = _mm256_set1_epi8((char)ff->last[0]);
+	const __m256i l1 = _mm256_set1_epi8((char)ff->last[1]);
+	const __m256i lead = _mm256_set1_epi8((char)0xC0);
+	__m256i b, m;
+	REBCNT mask;
+
+	for (; index + 32 <= limit; index += 32) {
+		b = _mm256_loadu_si256((const __m256i *)(data + index));
+		m = _mm256_or_si256(_mm256_cmpeq_epi8(b, f0), _mm256_cmpeq_epi8(b, f1));
+		if (ff->lead) m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_max_epu8(b, lead), b));
+		if (ff->last_at) {
+			b = _mm256_loadu_si256((const __m256i *)(data + index + ff->last_at));
+			m = _mm256_and_si256(m, _mm256_or_si256(_mm256_cmpeq_epi8(b, l0), _mm256_cmpeq_epi8(b, l1)));
+		}
+		mask = (REBCNT)_mm256_movemask_epi8(m);
+		if (mask) return index + Low_Bit(mask);
+	}
+	return Next_Fast_SSE2(data, index, limit, ff);
+}
+#endif
+
+
+/***********************************************************************
+**
+*/	static REBCNT Next_Fast_Find(const REBYTE *data, REBCNT index, REBCNT limit, const REBFF *ff)
+/*
+**		Returns the first position from index (up to limit) where
+**		a match may start or NOT_FOUND. When last_at is used, the
+**		data must be valid up to limit + last_at.
+**
+***********************************************************************/
+{
+#ifdef FIND_AVX2
+	static int avx2 = -1;
+	if (avx2 < 0) avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+	if (avx2) return Next_Fast_AVX2(data, index, limit, ff);
+#endif
+#ifdef FIND_SSE2
+	return Next_Fast_SSE2(data, index, limit, ff);
+#else
+	return Next_Fast_Bytes(data, index, limit, ff);
+#endif
+}
+
 
 /***********************************************************************
 **
@@ -295,6 +505,8 @@
 	REBCNT l1;
 	REBYTE c;
 	REBCNT n;
+	REBFF ff;
+	REBFLG fast;
 
 	// The pattern empty or is longer than the target:
 	if (l2 == 0 || (l2 + index) > SERIES_TAIL(series)) return NOT_FOUND;
@@ -306,9 +518,22 @@
 
 	c = *b2; // first char
 
+	fast = !match && l1 >= FAST_FIND_MIN;
+	if (fast && !Init_Fast_Find(&ff, uncase ? (REBYTE)LO_CASE(c) : c, b2, l2 - 1, uncase, FALSE))
+		return NOT_FOUND;
+
+// Jump to the next position where the pattern may start:
+#define FAST_FIND_BYTES \
+	if (fast) { \
+		n = Next_Fast_Find(BIN_HEAD(series), (REBCNT)(b1 - BIN_HEAD(series)), (REBCNT)(e1 - BIN_HEAD(series)), &ff); \
+		if (n == NOT_FOUND) break; \
+		b1 = BIN_SKIP(series, n); \
+	}
+
 	if (!uncase) {
 
 		while (b1 != e1) {
+			FAST_FIND_BYTES
 			if (*b1 == c) { // matched first char
 				for (n = 1; n < l2; n++) {
 					if (b1[n] != b2[n]) break;
@@ -323,6 +548,7 @@
 		c = (REBYTE)LO_CASE(c); // OK! (never > 255)
 
 		while (b1 != e1) {
+			FAST_FIND_BYTES
 			if (LO_CASE(*b1) == c) { // matched first char
 				for (n = 1; n < l2; n++) {
 					if (LO_CASE(b1[n]) != LO_CASE(b2[n])) break;
@@ -333,6 +559,7 @@
 		}
 
 	}
+#undef FAST_FIND_BYTES
 
 	return NOT_FOUND;
 }
@@ -358,14 +585,49 @@
 	REBYTE *str1, *str2;
 	REBCNT n = 0;
 	const REBOOL uncase = !(flags & AM_FIND_CASE); // uncase = case insenstive
+	REBFF ff;
+	REBFLG fast;
+	REBCNT limit = tail;
 
 	c2 = GET_UTF8_CHAR(ser2, index2); // starting char
 	if (uncase && c2 < UNICODE_CASES) c2 = LO_CASE(c2);
 	str1 = BIN_HEAD(ser1);
 	str2 = BIN_HEAD(ser2);
 
+	// Skip positions where the pattern cannot start (see notes above).
+	// Byte exact searches check also the last byte, so they are used
+	// only where the whole pattern is inside the series:
+	fast = skip == 1 && !(flags & AM_FIND_MATCH) && len > 0 && index >= head
+		&& tail >= index + FAST_FIND_MIN && tail <= SERIES_TAIL(ser1);
+	if (fast) {
+		REBYTE *pat = BIN_SKIP(ser2, index2);
+		if (!IS_UTF8_SERIES(ser1))
+			fast = !IS_UTF8_SERIES(ser2) && Init_Fast_Find(&ff, c2, pat, len - 1, uncase, FALSE);
+		else if (uncase)
+			fast = Init_Fast_Find(&ff, c2, NULL, 0, TRUE, TRUE);
+		else // valid UTF-8 chars are equal only when their bytes are equal
+			fast = (IS_UTF8_SERIES(ser2) || Is_ASCII(pat, len))
+				&& Init_Fast_Find(&ff, pat[0], pat, len - 1, FALSE, FALSE);
+		if (fast && ff.last_at) {
+			if (SERIES_TAIL(ser1) < len) fast = FALSE;
+			else limit = MIN(tail, SERIES_TAIL(ser1) - ff.last_at);
+			if (limit <= index) fast = FALSE;
+		}
+	}
+
 	if (IS_UTF8_SERIES(ser1)) {
 		while (index >= head && index < tail) {
+			if (fast) {
+				n = Next_Fast_Find(str1, index, limit, &ff);
+				if (n == NOT_FOUND) {
+					fast = FALSE;
+					if (limit == tail) break;
+					// Continue from the next char boundary:
+					for (index = limit; index < tail && (str1[index] & 0xC0) == 0x80; index++);
+					if (index >= tail) break;
+				}
+				else index = n;
+			}
 			str1 = BIN_SKIP(ser1, index);
 			str2 = BIN_SKIP(ser2, index2);
 			c1 = UTF8_Get_Codepoint(str1);
@@ -398,8 +660,21 @@
 	else {
 		// ser1 is ASCII, so ser2 must also be ASCII to be found
 		if (IS_UTF8_SERIES(ser2)) return NOT_FOUND;
+
+// Jump to the next position where the pattern may start:
+#define FAST_FIND_STR \
+	if (fast) { \
+		n = Next_Fast_Find(str1, index, limit, &ff); \
+		fast = (n != NOT_FOUND); \
+		if (!fast) { \
+			index = limit; \
+			if (index >= tail) break; \
+		} \
+		else index = n; \
+	}
 		if (uncase) {
 			for (; index >= head && index < tail; index += skip) {
+				FAST_FIND_STR
 				c1 = str1[index];
 				if (c1 < UNICODE_CASES) c1 = LO_CASE(c1);
 				if (c1 == c2) {
@@ -423,6 +698,7 @@
 		}
 		else {
 			for (; index >= head && index < tail; index += skip) {
+				FAST_FIND_STR
 				c1 = str1[index];
 				if (c1 == c2) {
 					for (n = 1; n < len; n++) {
@@ -438,6 +714,7 @@
 				if (flags & AM_FIND_MATCH) break;
 			}
 		}
+#undef FAST_FIND_STR
 	}
 	return NOT_FOUND;
 }
@@ -659,11 +936,32 @@
 	REBU32 c1;
 	REBYTE *bp;
 	const REBOOL uncase = !(flags & AM_FIND_CASE); // uncase = case insenstive
+	REBFF ff;
+	REBFLG fast;
+	REBYTE lead[8];
 
 	if (uncase && c2 < UNICODE_CASES) c2 = LO_CASE(c2);
 
+	// Skip positions where the char cannot be (see notes above):
+	fast = skip == 1 && !(flags & AM_FIND_MATCH) && index >= head
+		&& tail >= index + FAST_FIND_MIN && tail <= SERIES_TAIL(ser);
+	if (fast) {
+		if (!IS_UTF8_SERIES(ser))
+			fast = Init_Fast_Find(&ff, c2, NULL, 0, uncase, FALSE);
+		else if (uncase || c2 < 0x80)
+			fast = Init_Fast_Find(&ff, c2, NULL, 0, uncase, uncase);
+		else {
+			Encode_UTF8_Char(lead, c2);
+			fast = Init_Fast_Find(&ff, lead[0], NULL, 0, FALSE, FALSE);
+		}
+	}
+
 	if (IS_UTF8_SERIES(ser)) {
 		while (index >= head && index < tail) {
+			if (fast) {
+				index = Next_Fast_Find(BIN_HEAD(ser), index, tail, &ff);
+				if (index == NOT_FOUND) break;
+			}
 			bp = BIN_SKIP(ser, index);
 			c1 = UTF8_Get_Codepoint(bp);
 			if (uncase && c1 < UNICODE_CASES) c1 = LO_CASE(c1);
@@ -681,6 +979,10 @@
 		if (c2 > 0x7F) return NOT_FOUND;
 		bp = BIN_HEAD(ser);
 		for (; index >= head && index < tail; index += skip) {
+			if (fast) {
+				index = Next_Fast_Find(bp, index, tail, &ff);
+				if (index == NOT_FOUND) break;
+			}
 			c1 = bp[index];
 			if (uncase && c1 < UNICODE_CASES) c1 = LO_CASE(c1);
 			if (c1 == c2) {
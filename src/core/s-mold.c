@@ -1723,6 +1723,9 @@ append:
 	Set_Root_Series(TASK_MOLD_LOOP, Make_Block(size/10), cb_cast("mold loop"));
 	Set_Root_Series(TASK_BUF_MOLD, Make_Binary(size), cb_cast("mold buffer"));
 
+	// Escape tables are shared by all tasks:
+	if (Char_Escapes) return;
+
 	// Create quoted char escape table:
 	Char_Escapes = cp = Make_CMem(MAX_ESC_CHAR+1); // cleared
 	for (c = '@'; c <= '_'; c++) *cp++ = c;
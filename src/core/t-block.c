@@ -288,6 +288,7 @@ static void No_Nones_Or_Logic(REBVAL *arg) {
 	REBINT ilen  = 1;  // length to be inserted
 	REBINT cnt   = 1;  // DUP count
 	REBINT size;
+	size_t pos, isize; // in bytes
 	REBFLG is_blk = FALSE; // arg is a block not a value
 
 	// Length of target (may modify index): (arg can be anything)
@@ -334,11 +335,11 @@ static void No_Nones_Or_Logic(REBVAL *arg) {
 	// For dup count:
 	VAL_INDEX(block) = (action == A_APPEND) ? 0 : size + index;
 
-	index *= SERIES_WIDE(series); // loop invariant
-	ilen *= SERIES_WIDE(series);   // loop invariant
+	pos = (size_t)index * SERIES_WIDE(series); // loop invariant
+	isize = (size_t)ilen * SERIES_WIDE(series); // loop invariant
 	for (; cnt > 0; cnt--) {
-		memcpy(series->data + index, (REBYTE *)arg, ilen);
-		index += ilen;
+		memcpy(series->data + pos, (REBYTE *)arg, isize);
+		pos += isize;
 	}
 	BLK_TERM(series);
 }
@@ -500,6 +501,127 @@ done:
 }
 
 
+typedef struct Sort_Val_Context {
+	REBLEN offset;
+	REBFLG ccase;
+	REBFLG reverse;
+} REBSVC;
+
+/***********************************************************************
+**
+*/	static int Compare_Val_Ctx(void *ctx, const void *v1, const void *v2)
+/*
+**		Same as Compare_Val, but without the data stack (used in
+**		sort threads).
+**
+***********************************************************************/
+{
+	REBSVC *svc = (REBSVC *)ctx;
+	REBINT result = Cmp_Value((REBVAL*)v1 + svc->offset, (REBVAL*)v2 + svc->offset, svc->ccase);
+	return svc->reverse ? -result : result;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Radix_Sort_Block(REBVAL *data, REBLEN len, REBCNT skip, REBLEN offset, REBFLG rev)
+/*
+**		Sorts records by keys of the same integer!, decimal!, percent!
+**		or date! type using the radix sort. Returns FALSE when keys
+**		are not of these types (or too few to be worth it).
+**
+***********************************************************************/
+{
+	REBVAL *key = data + offset;
+	REBCNT type = VAL_TYPE(key);
+	REBRDX *items;
+	REBVAL *tmp;
+	REBLEN n;
+	REBI64 t;
+
+	if (len < 64) return FALSE;
+	if (type != REB_INTEGER && type != REB_DECIMAL && type != REB_PERCENT && type != REB_DATE)
+		return FALSE;
+
+	items = Make_Mem((size_t)len * sizeof(REBRDX));
+	if (!items) return FALSE;
+
+	for (n = 0; n < len; n++, key += skip) {
+		if (VAL_TYPE(key) != type) goto not_sorted;
+		switch (type) {
+		case REB_INTEGER:
+			items[n].key = (REBU64)VAL_INT64(key) ^ ((REBU64)1 << 63);
+			break;
+		case REB_DECIMAL:
+		case REB_PERCENT:
+			// Note: decimals are ordered exactly (Cmp_Value has some tolerance)
+			items[n].key = Radix_Decimal_Key(VAL_DECIMAL(key));
+			break;
+		case REB_DATE:
+			// As Cmp_Date: the date (without a zone) and then its time
+			t = VAL_TIME(key);
+			if (t == NO_TIME) t = 0;
+			if (t < 0 || t >= ((REBI64)1 << 37)) goto not_sorted;
+			items[n].key = ((REBU64)(((VAL_YEAR(key) << 4 | VAL_MONTH(key)) << 5) | VAL_DAY(key)) << 37) | (REBU64)t;
+			break;
+		}
+		if (rev) items[n].key = ~items[n].key;
+		items[n].index = n;
+	}
+
+	tmp = Make_Mem((size_t)len * skip * sizeof(REBVAL));
+	if (!tmp || !Radix_Sort_Keys(items, len)) {
+		if (tmp) Free_Mem(tmp, (size_t)len * skip * sizeof(REBVAL));
+		goto not_sorted;
+	}
+	for (n = 0; n < len; n++)
+		COPY_MEM(tmp + n * skip, data + items[n].index * skip, skip * sizeof(REBVAL));
+	COPY_MEM(data, tmp, (size_t)len * skip * sizeof(REBVAL));
+
+	Free_Mem(tmp, (size_t)len * skip * sizeof(REBVAL));
+	Free_Mem(items, (size_t)len * sizeof(REBRDX));
+	return TRUE;
+
+not_sorted:
+	Free_Mem(items, (size_t)len * sizeof(REBRDX));
+	return FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Parallel_Sort_Block(REBVAL *data, REBLEN len, REBCNT skip, REBSVC *svc)
+/*
+**		Sorts large blocks in threads, when all keys may be compared
+**		without the interpreter (see system/options/sort-threads and
+**		sort-parallel). Returns FALSE when not sorted.
+**
+***********************************************************************/
+{
+	REBINT threads = Get_System_Int(SYS_OPTIONS, OPTIONS_SORT_THREADS, 1);
+	REBINT limit = Get_System_Int(SYS_OPTIONS, OPTIONS_SORT_PARALLEL, 100000);
+	REBVAL *key;
+	REBLEN n;
+
+	if (threads < 2 || limit < 0 || len < (REBLEN)limit) return FALSE;
+
+	for (n = 0, key = data + svc->offset; n < len; n++, key += skip) {
+		switch (VAL_TYPE(key)) {
+		case REB_NONE: case REB_LOGIC: case REB_INTEGER: case REB_DECIMAL:
+		case REB_PERCENT: case REB_MONEY: case REB_CHAR: case REB_PAIR:
+		case REB_TUPLE: case REB_TIME: case REB_DATE: case REB_DATATYPE:
+		case REB_BINARY: case REB_STRING: case REB_FILE: case REB_EMAIL:
+		case REB_URL: case REB_TAG: case REB_REF:
+		case REB_WORD: case REB_SET_WORD: case REB_GET_WORD:
+		case REB_LIT_WORD: case REB_REFINEMENT: case REB_ISSUE:
+			continue;
+		}
+		return FALSE;
+	}
+	return Parallel_Sort(data, len, skip * sizeof(REBVAL), (REBCNT)threads, Compare_Val_Ctx, svc);
+}
+
+
 /***********************************************************************
 **
 */	static int Compare_Call(const void *p1, const void *p2)
@@ -659,6 +781,19 @@ done:
 	else {
 		cmp = Compare_Val;
 	}
+
+	// Faster paths for the default comparison of the first (or given) field:
+	if (cmp == Compare_Val) {
+		REBSVC svc;
+		svc.offset  = IS_INTEGER(compv) ? AS_REBLEN(VAL_INT64(compv) - 1) : 0;
+		svc.ccase   = ccase;
+		svc.reverse = rev;
+		if (
+			Radix_Sort_Block(VAL_BLK_DATA(block), len, skip, svc.offset, rev)
+			|| Parallel_Sort_Block(VAL_BLK_DATA(block), len, skip, &svc)
+		) goto done;
+	}
+
 	if (unst) {
 		unstable_sort((void*)VAL_BLK_DATA(block), len, size, cmp);
 	}
@@ -666,6 +801,7 @@ done:
 		stable_sort((void*)VAL_BLK_DATA(block), len, size, cmp);
 	}
 
+done:
 	if (all && IS_FUNCTION(compv)) {
 		// Release temporary blocks
 		ASSERT1(IS_BLOCK(&v1) && IS_BLOCK(&v2), RP_MISC);
@@ -832,6 +968,7 @@ repick:
 		} else {
 			if (!value) Trap_Range(arg);
 			arg = D_ARG(3);
+			GC_BARRIER(ser);
 			*value = *arg;
 			*D_RET = *arg;
 		}
@@ -906,6 +1043,7 @@ zero_blk:
 		args = D_REF(ARG_PUT_CASE) ? AM_FIND_CASE : 0;
 		ret = IS_INTEGER(D_ARG(ARG_PUT_SIZE)) ? Int32s(D_ARG(ARG_PUT_SIZE), 1) : 1;
 		ret = Find_Block(ser, index, tail, arg, len, args, ret);
+		GC_BARRIER(ser);
 		if(ret != NOT_FOUND) {
 			ret++;
 			if (ret >= tail) {
@@ -1014,6 +1152,8 @@ zero_blk:
 			Trap_Arg(arg);
 		if (IS_PROTECT_SERIES(VAL_SERIES(arg))) Trap0(RE_PROTECTED);
 		if (index < tail && VAL_INDEX(arg) < VAL_TAIL(arg)) {
+			GC_BARRIER(ser);
+			GC_BARRIER(VAL_SERIES(arg));
 			val = *VAL_BLK_DATA(value);
 			*VAL_BLK_DATA(value) = *VAL_BLK_DATA(arg);
 			*VAL_BLK_DATA(arg) = val;
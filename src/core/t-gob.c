@@ -71,7 +71,7 @@ const REBCNT Gob_Flag_Words[] = {
 	GOB_H(gob) = 100;
 	GOB_ALPHA(gob) = 255;
 	USE_GOB(gob);
-	if ((GC_Ballast -= Mem_Pools[GOB_POOL].wide) <= 0) SET_SIGNAL(SIG_RECYCLE);
+	if ((GC_Ballast -= Mem_Pools[GOB_POOL].wide) <= 0) SET_TASK_SIGNAL(SIG_RECYCLE);
 	return gob;
 }
 
@@ -35,12 +35,14 @@
 	also store the value of the symbol (not just its word).
 
 	The structure of the series header for a map is the	same as other
-	series, except that the opt series field is	a pointer to a REBCNT
+	series, except that the opt series field is	a pointer to a REBHSL
 	series, the hash table.
 
-	The hash table is an array of REBCNT integers that are index values
-	into the map series. NOTE: They are one-based to avoid 0 which is an
-	empty slot.
+	The hash table is an array of slots holding index values into the
+	map series. NOTE: They are one-based to avoid 0 which is an	empty slot.
+	Each slot also keeps the hash of its key, so the probing compares
+	only keys with the same hash and the table expansion does not need
+	to compute the hashes again.
 
 	Each value in the map consists of a word followed by its value.
 
@@ -92,7 +94,7 @@
 	REBVAL* val;
 	REBCNT  idx;
 	REBSER* hser;
-	REBCNT* hashes = NULL;
+	REBHSL* hashes = NULL;
 	REBCNT  slen, tlen;
 
 	if (VAL_SERIES(sval) == VAL_SERIES(tval))
@@ -110,7 +112,7 @@
 	}
 
 	hser = VAL_SERIES(tval)->series;
-	if (hser) hashes = (REBCNT*)hser->data;
+	if (hser) hashes = HASH_SLOTS(hser);
 
 	// Traverse all keys of the left map and compare values if found in the second map
 	for (key = VAL_BLK(sval); NOT_END(key) && NOT_END(key + 1); key += 2) {
@@ -119,7 +121,7 @@
 		if (idx == NOT_FOUND) return -1; // stop if the target key is not found
 		if (hashes) {
 			// the target map has a hash table, so get the real index of the key
-			idx = ((hashes[idx] - 1) * 2);
+			idx = ((hashes[idx].index - 1) * 2);
 			// check if the target key is not removed; if so, we can end
 			if (VAL_MAP_REMOVED(VAL_BLK_SKIP(tval,idx))) return -1;
 		}
@@ -133,7 +135,7 @@
 
 /***********************************************************************
 **
-*/	static REBSER *Make_Map(REBINT size)
+*/	REBSER *Make_Map(REBINT size)
 /*
 **		Makes a MAP block (that holds both keys and values).
 **		Size is the number of key-value pairs.
@@ -155,6 +157,13 @@
 }
 
 
+// Skip a slot whose cached hash differs (its key is not compared at all):
+#ifdef DEBUG_HASH_COLLISIONS
+#define SKIP_PROBE {++ Eval_Collisions; continue;}
+#else
+#define SKIP_PROBE continue
+#endif
+
 /***********************************************************************
 **
 */	REBCNT Find_Key(REBSER *series, REBSER *hser, REBVAL *key, REBINT wide, REBCNT cased, REBYTE mode)
@@ -169,9 +178,12 @@
 **			1 - search, return hash, else return -1 if not
 **			2 - search, return hash, else append value and return -1
 **
+**		In mode 0 the hash of the key is stored in the returned slot,
+**		so the caller has to set only its index when it is a new one.
+**
 ***********************************************************************/
 {
-	REBCNT *hashes;
+	REBHSL *hashes;
 	REBCNT hash = 0;
 	REBCNT hashed = 0;
 	REBCNT len;
@@ -194,7 +206,7 @@
 
 	// Compute hash for value:
 	len = hser->tail;
-	hashes = (REBCNT*)hser->data;
+	hashes = HASH_SLOTS(hser);
 
 	if (len > 0) {
 		hashed = Hash_Value(key);
@@ -202,8 +214,9 @@
 		if (ANY_WORD(key)) {
 			for(i = 0; i < len; i++) {
 				hash = Hash_Probe(hashed, i, len);
-				n = hashes[hash];
+				n = hashes[hash].index;
 				if (!n) break;
+				if (hashes[hash].hash != hashed) SKIP_PROBE;
 				val = BLK_SKIP(series, (n - 1) * wide);
 				if (ANY_WORD(val)
 					&& (
@@ -220,8 +233,9 @@
 			cased = !(IS_BINARY(key) || cased);
 			for (i = 0; i < len; i++) {
 				hash = Hash_Probe(hashed, i, len);
-				n = hashes[hash];
+				n = hashes[hash].index;
 				if (!n) break;
+				if (hashes[hash].hash != hashed) SKIP_PROBE;
 				val = BLK_SKIP(series, (n - 1) * wide);
 				if (VAL_TYPE(val) == VAL_TYPE(key) && 0 == Compare_String_Vals(key, val, cased))
 					return hash;
@@ -233,8 +247,9 @@
 		else {
 			for (i = 0; i < len; i++) {
 				hash = Hash_Probe(hashed, i, len);
-				n = hashes[hash];
+				n = hashes[hash].index;
 				if (!n) break;
+				if (hashes[hash].hash != hashed) SKIP_PROBE;
 				val = BLK_SKIP(series, (n - 1) * wide);
 				if (VAL_TYPE(val) == VAL_TYPE(key) && 0 == Cmp_Value(key, val, cased))
 					return hash;
@@ -247,11 +262,13 @@
 
 	// Append new value the target series:
 	if (mode > 1) {
-		hashes[hash] = (SERIES_TAIL(series) / wide) +1;
-		//Debug_Num("hash:", hashes[hash]);
+		hashes[hash].index = (SERIES_TAIL(series) / wide) +1;
+		hashes[hash].hash = hashed;
+		//Debug_Num("hash:", hashes[hash].index);
 		Append_Series(series, (REBYTE*)key, wide);
 		//Dump_Series(series, "hash");
 	}
+	else if (mode == 0 && len > 0) hashes[hash].hash = hashed;
 
 	return (mode > 0) ? NOT_FOUND : hash;
 }
@@ -268,17 +285,68 @@
 	REBVAL *val;
 	REBCNT n;
 	REBCNT key;
-	REBCNT *hashes;
+	REBHSL *hashes;
 
 	if (!series->series) return;
 
-	hashes = (REBCNT*)(series->series->data);
+	hashes = HASH_SLOTS(series->series);
 
 	val = BLK_HEAD(series);
 	for (n = 0; n < series->tail; n += 2, val += 2) {
 		key = Find_Key(series, series->series, val, 2, TRUE, 0);
-		hashes[key] = n/2+1;
+		hashes[key].index = n/2+1;
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Expand_Map_Hash(REBSER *hser)
+/*
+**		Expand the hash table to the next prime size and move all
+**		its slots using their cached hashes (keys are not compared
+**		nor hashed again, because they are already unique).
+**
+***********************************************************************/
+{
+	REBSER oser;
+	REBSER *nser;
+	REBHSL *old;
+	REBHSL *hashes;
+	REBCNT len = hser->tail;
+	REBCNT size;
+	REBCNT hash;
+	REBCNT n, i;
+
+	size = Get_Hash_Prime(len + 1);
+	if (!size) Trap_Num(RE_SIZE_LIMIT, len + 1);
+
+	nser = Make_Series(size + 1, sizeof(REBHSL), FALSE);
+	LABEL_SERIES(nser, "hash series");
+	CLEAR(nser->data, SERIES_SPACE(nser));
+	nser->tail = size;
+
+	old = HASH_SLOTS(hser);
+	hashes = HASH_SLOTS(nser);
+	for (n = 0; n < len; n++) {
+		if (!old[n].index) continue;
+		for (i = 0; i < size; i++) {
+			hash = Hash_Probe(old[n].hash, i, size);
+			if (!hashes[hash].index) {
+				hashes[hash] = old[n];
+				break;
+			}
+		}
 	}
+
+	// Keep the same hash series header (as Expand_Hash does):
+	oser = *hser;
+	*hser = *nser;
+	hser->sizes = oser.sizes;
+	hser->flags = oser.flags;
+	*nser = oser;
+
+	Free_Series(nser);
 }
 
 
@@ -295,12 +363,13 @@
 ***********************************************************************/
 {
 	REBSER *hser = series->series; // can be null
-	REBCNT *hashes = NULL;
+	REBHSL *hashes = NULL;
 	REBCNT hash;
 	REBCNT n;
 	REBVAL *set;
 
 	if (IS_NONE(key)) return NOT_FOUND;
+	if (val) GC_BARRIER(series);
 
 	// We may not be large enough yet for the hash table to
 	// be worthwhile, so just do a linear search:
@@ -329,13 +398,12 @@
 	}
 	// Get hash table, expand it if needed:
 	if (series->tail > hser->tail/2) {
-		Expand_Hash(hser); // modifies size value
-		Rehash_Hash(series);
+		Expand_Map_Hash(hser); // modifies size value
 	}
 
 	hash = Find_Key(series, hser, key, 2, cased, 0);
-	hashes = (REBCNT*)hser->data;
-	n = hashes[hash];
+	hashes = HASH_SLOTS(hser);
+	n = hashes[hash].index;
 
 	// Just a GET of value:
 	if (!val) return ((n-1)*2)+1;
@@ -378,7 +446,7 @@ new_entry:
 #endif
 	// append value
 	Append_Val(series, val);  // no Copy_Series_Value(val) on strings
-	if (hashes) hashes[hash] = series->tail / 2; // Hash index is not a real index position of the value!
+	if (hashes) hashes[hash].index = series->tail / 2; // Hash index is not a real index position of the value!
 	return series->tail;      // Index of the new value.
 }
 
@@ -446,6 +514,23 @@ new_entry:
 	}
 }
 
+/***********************************************************************
+**
+*/	REBSER *Copy_Values_As_Map(REBVAL *val, REBCNT len)
+/*
+**		Makes a map from len values holding key/value pairs.
+**		Values of duplicate keys are replaced (as in MAKE MAP!).
+**
+***********************************************************************/
+{
+	REBSER *ser = Make_Map(len / 2);
+
+	for (; len > 1; val += 2, len -= 2) {
+		Find_Entry(ser, val, val+1, TRUE);
+	}
+	return ser;
+}
+
 /***********************************************************************
 **
 */	REBSER *Copy_Map(REBVAL *val, REBU64 types)
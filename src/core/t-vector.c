@@ -215,6 +215,371 @@ static void set_vect(REBCNT type, REBYTE *data, REBCNT n, REBVAL *val) {
 }
 
 
+// Expands the macro for the C type of the vector's encoding:
+#define VECT_DISPATCH(bits, M) \
+	switch (bits) { \
+	case VTSI08: M(i8);     break; \
+	case VTSI16: M(i16);    break; \
+	case VTSI32: M(i32);    break; \
+	case VTSI64: M(i64);    break; \
+	case VTUI08: M(u8);     break; \
+	case VTUI16: M(u16);    break; \
+	case VTUI32: M(u32);    break; \
+	case VTUI64: M(u64);    break; \
+	case VTSF32: M(float);  break; \
+	case VTSF64: M(double); break; \
+	}
+
+/***********************************************************************
+**
+**	SIMD kernels
+**
+**		Explicit SSE2 and AVX2 versions of the element-wise math and
+**		of the min/max and sum reductions (-O2 does not vectorize the
+**		typed loops). SSE2 is used when it is the compile target and
+**		AVX2 is chosen at runtime (see Get_CPU_Features). A kernel
+**		returns the count of values it did (a multiple of its width);
+**		the scalar loops do the rest and stay the fallback for other
+**		encodings, operations and CPUs, so results are the same.
+**
+***********************************************************************/
+
+enum {VK_ADD, VK_SUB, VK_MUL, VK_DIV, VK_AND, VK_OR, VK_XOR, VK_MIN, VK_MAX, VK_NONE};
+enum {VS_NONE, VS_SUM, VS_DEV};	// sums of values or of squared deviations
+
+// Stores the scalar operand in the vector's encoding (for Vec_Simd_Op):
+#define VEC_SET_SCALAR(type) { \
+		type v = (bits >= VTSF32) ? (type)f : (type)i; \
+		memcpy(&scalar, &v, sizeof(v)); \
+	}
+
+#if defined(CPU_X86) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VEC_SIMD
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <immintrin.h>
+#endif
+
+typedef REBLEN (*VEC_OP_FUNC)(void *out, const void *a, const void *b, REBLEN len, REBFLG scalar);
+typedef REBLEN (*VEC_EXT_FUNC)(const void *a, REBLEN len, void *lo, void *hi);
+typedef REBLEN (*VEC_SUM_FUNC)(const void *a, REBLEN len, REBDEC mean, REBFLG dev, REBDEC *s);
+
+#define X_LDI(p)	_mm_loadu_si128((const __m128i *)(p))
+#define X_STI(p, v)	_mm_storeu_si128((__m128i *)(p), v)
+#define Y_LDI(p)	_mm256_loadu_si256((const __m256i *)(p))
+#define Y_STI(p, v)	_mm256_storeu_si256((__m256i *)(p), v)
+
+// o[j] = a[j] op b[j] (or op b[0] when scalar); out may be the same as a:
+#define VEC_OP_KERNEL(name, vt, ct, LD, ST, SET1, OP) \
+	static REBLEN name(void *out, const void *a, const void *b, REBLEN len, REBFLG scalar) { \
+		ct *o = (ct *)out; \
+		const ct *p = (const ct *)a; \
+		const ct *q = (const ct *)b; \
+		const REBLEN w = sizeof(vt) / sizeof(ct); \
+		REBLEN j = 0; \
+		if (scalar) { \
+			const vt y = SET1(q[0]); \
+			for (; j + w <= len; j += w) ST(o + j, OP(LD(p + j), y)); \
+		} else { \
+			for (; j + w <= len; j += w) ST(o + j, OP(LD(p + j), LD(q + j))); \
+		} \
+		return j; \
+	}
+
+// Lowest and highest value (lo and hi are set to a[0] by the caller, either may be NULL).
+// Lanes pick as the scalar loops do: (x < lo) ? x : lo, so NaNs are passed over.
+#define VEC_EXT_KERNEL(name, vt, ct, LD, ST, SET1, MIN, MAX) \
+	static REBLEN name(const void *a, REBLEN len, void *lo, void *hi) { \
+		const ct *p = (const ct *)a; \
+		const REBLEN w = sizeof(vt) / sizeof(ct); \
+		ct l[sizeof(vt) / sizeof(ct)], h[sizeof(vt) / sizeof(ct)]; \
+		vt vl = SET1(p[0]), vh = vl, x; \
+		REBLEN j, k; \
+		for (j = 0; j + w <= len; j += w) { \
+			x = LD(p + j); \
+			vl = MIN(x, vl); \
+			vh = MAX(x, vh); \
+		} \
+		ST(l, vl); \
+		ST(h, vh); \
+		for (k = 0; k < w; k++) { \
+			if (lo && l[k] < *(ct *)lo) *(ct *)lo = l[k]; \
+			if (hi && h[k] > *(ct *)hi) *(ct *)hi = h[k]; \
+		} \
+		return j; \
+	}
+
+// Sums of values or of squared deviations into the 4 lanes of VEC_SUM_LANES
+// (lane k gets the values j+k, so the additions are in the same order):
+#define VEC_SUM_KERNEL_SSE2(name, ct, CVT_LO, CVT_HI) \
+	static REBLEN name(const void *a, REBLEN len, REBDEC mean, REBFLG dev, REBDEC *s) { \
+		const ct *p = (const ct *)a; \
+		const __m128d m = _mm_set1_pd(mean); \
+		__m128d s01 = _mm_setzero_pd(), s23 = _mm_setzero_pd(), x01, x23; \
+		REBLEN j; \
+		for (j = 0; j + 4 <= len; j += 4) { \
+			x01 = CVT_LO(p + j); \
+			x23 = CVT_HI(p + j); \
+			if (dev) { \
+				x01 = _mm_sub_pd(x01, m); x01 = _mm_mul_pd(x01, x01); \
+				x23 = _mm_sub_pd(x23, m); x23 = _mm_mul_pd(x23, x23); \
+			} \
+			s01 = _mm_add_pd(s01, x01); \
+			s23 = _mm_add_pd(s23, x23); \
+		} \
+		_mm_storeu_pd(s, s01); \
+		_mm_storeu_pd(s + 2, s23); \
+		return j; \
+	}
+
+#define VEC_SUM_KERNEL_AVX2(name, ct, CVT) \
+	static REBLEN name(const void *a, REBLEN len, REBDEC mean, REBFLG dev, REBDEC *s) { \
+		const ct *p = (const ct *)a; \
+		const __m256d m = _mm256_set1_pd(mean); \
+		__m256d acc = _mm256_setzero_pd(), x; \
+		REBLEN j; \
+		for (j = 0; j + 4 <= len; j += 4) { \
+			x = CVT(p + j); \
+			if (dev) { x = _mm256_sub_pd(x, m); x = _mm256_mul_pd(x, x); } \
+			acc = _mm256_add_pd(acc, x); \
+		} \
+		_mm256_storeu_pd(s, acc); \
+		return j; \
+	}
+
+#ifndef EXCLUDE_VECTOR_MATH
+// SSE2 (integer ops which do not depend on the sign serve both):
+VEC_OP_KERNEL(Add8_SSE2,   __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,   _mm_add_epi8)
+VEC_OP_KERNEL(Add16_SSE2,  __m128i, u16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_add_epi16)
+VEC_OP_KERNEL(Add32_SSE2,  __m128i, u32,    X_LDI, X_STI, _mm_set1_epi32,  _mm_add_epi32)
+VEC_OP_KERNEL(Add64_SSE2,  __m128i, u64,    X_LDI, X_STI, _mm_set1_epi64x, _mm_add_epi64)
+VEC_OP_KERNEL(AddF_SSE2,   __m128,  float,  _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_add_ps)
+VEC_OP_KERNEL(AddD_SSE2,   __m128d, double, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_add_pd)
+VEC_OP_KERNEL(Sub8_SSE2,   __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,   _mm_sub_epi8)
+VEC_OP_KERNEL(Sub16_SSE2,  __m128i, u16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_sub_epi16)
+VEC_OP_KERNEL(Sub32_SSE2,  __m128i, u32,    X_LDI, X_STI, _mm_set1_epi32,  _mm_sub_epi32)
+VEC_OP_KERNEL(Sub64_SSE2,  __m128i, u64,    X_LDI, X_STI, _mm_set1_epi64x, _mm_sub_epi64)
+VEC_OP_KERNEL(SubF_SSE2,   __m128,  float,  _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_sub_ps)
+VEC_OP_KERNEL(SubD_SSE2,   __m128d, double, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_sub_pd)
+VEC_OP_KERNEL(Mul16_SSE2,  __m128i, u16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_mullo_epi16)
+VEC_OP_KERNEL(MulF_SSE2,   __m128,  float,  _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_mul_ps)
+VEC_OP_KERNEL(MulD_SSE2,   __m128d, double, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_mul_pd)
+VEC_OP_KERNEL(DivF_SSE2,   __m128,  float,  _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_div_ps)
+VEC_OP_KERNEL(DivD_SSE2,   __m128d, double, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_div_pd)
+VEC_OP_KERNEL(And8_SSE2,   __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,   _mm_and_si128)
+VEC_OP_KERNEL(And16_SSE2,  __m128i, u16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_and_si128)
+VEC_OP_KERNEL(And32_SSE2,  __m128i, u32,    X_LDI, X_STI, _mm_set1_epi32,  _mm_and_si128)
+VEC_OP_KERNEL(And64_SSE2,  __m128i, u64,    X_LDI, X_STI, _mm_set1_epi64x, _mm_and_si128)
+VEC_OP_KERNEL(Or8_SSE2,    __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,   _mm_or_si128)
+VEC_OP_KERNEL(Or16_SSE2,   __m128i, u16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_or_si128)
+VEC_OP_KERNEL(Or32_SSE2,   __m128i, u32,    X_LDI, X_STI, _mm_set1_epi32,  _mm_or_si128)
+VEC_OP_KERNEL(Or64_SSE2,   __m128i, u64,    X_LDI, X_STI, _mm_set1_epi64x, _mm_or_si128)
+VEC_OP_KERNEL(Xor8_SSE2,   __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,   _mm_xor_si128)
+VEC_OP_KERNEL(Xor16_SSE2,  __m128i, u16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_xor_si128)
+VEC_OP_KERNEL(Xor32_SSE2,  __m128i, u32,    X_LDI, X_STI, _mm_set1_epi32,  _mm_xor_si128)
+VEC_OP_KERNEL(Xor64_SSE2,  __m128i, u64,    X_LDI, X_STI, _mm_set1_epi64x, _mm_xor_si128)
+VEC_OP_KERNEL(MinU8_SSE2,  __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,   _mm_min_epu8)
+VEC_OP_KERNEL(MinI16_SSE2, __m128i, i16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_min_epi16)
+VEC_OP_KERNEL(MinF_SSE2,   __m128,  float,  _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_min_ps)
+VEC_OP_KERNEL(MinD_SSE2,   __m128d, double, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_min_pd)
+VEC_OP_KERNEL(MaxU8_SSE2,  __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,   _mm_max_epu8)
+VEC_OP_KERNEL(MaxI16_SSE2, __m128i, i16,    X_LDI, X_STI, _mm_set1_epi16,  _mm_max_epi16)
+VEC_OP_KERNEL(MaxF_SSE2,   __m128,  float,  _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_max_ps)
+VEC_OP_KERNEL(MaxD_SSE2,   __m128d, double, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_max_pd)
+
+// AVX2:
+TARGET_CPU("avx2") VEC_OP_KERNEL(Add8_AVX2,   __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_add_epi8)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Add16_AVX2,  __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_add_epi16)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Add32_AVX2,  __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_add_epi32)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Add64_AVX2,  __m256i, u64,    Y_LDI, Y_STI, _mm256_set1_epi64x, _mm256_add_epi64)
+TARGET_CPU("avx2") VEC_OP_KERNEL(AddF_AVX2,   __m256,  float,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_add_ps)
+TARGET_CPU("avx2") VEC_OP_KERNEL(AddD_AVX2,   __m256d, double, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_add_pd)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Sub8_AVX2,   __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_sub_epi8)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Sub16_AVX2,  __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_sub_epi16)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Sub32_AVX2,  __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_sub_epi32)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Sub64_AVX2,  __m256i, u64,    Y_LDI, Y_STI, _mm256_set1_epi64x, _mm256_sub_epi64)
+TARGET_CPU("avx2") VEC_OP_KERNEL(SubF_AVX2,   __m256,  float,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_sub_ps)
+TARGET_CPU("avx2") VEC_OP_KERNEL(SubD_AVX2,   __m256d, double, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_sub_pd)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Mul16_AVX2,  __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_mullo_epi16)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Mul32_AVX2,  __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_mullo_epi32)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MulF_AVX2,   __m256,  float,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_mul_ps)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MulD_AVX2,   __m256d, double, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_mul_pd)
+TARGET_CPU("avx2") VEC_OP_KERNEL(DivF_AVX2,   __m256,  float,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_div_ps)
+TARGET_CPU("avx2") VEC_OP_KERNEL(DivD_AVX2,   __m256d, double, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_div_pd)
+TARGET_CPU("avx2") VEC_OP_KERNEL(And8_AVX2,   __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_and_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(And16_AVX2,  __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_and_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(And32_AVX2,  __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_and_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(And64_AVX2,  __m256i, u64,    Y_LDI, Y_STI, _mm256_set1_epi64x, _mm256_and_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Or8_AVX2,    __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_or_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Or16_AVX2,   __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_or_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Or32_AVX2,   __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_or_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Or64_AVX2,   __m256i, u64,    Y_LDI, Y_STI, _mm256_set1_epi64x, _mm256_or_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Xor8_AVX2,   __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_xor_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Xor16_AVX2,  __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_xor_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Xor32_AVX2,  __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_xor_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(Xor64_AVX2,  __m256i, u64,    Y_LDI, Y_STI, _mm256_set1_epi64x, _mm256_xor_si256)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinI8_AVX2,  __m256i, i8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_min_epi8)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinI16_AVX2, __m256i, i16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_min_epi16)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinI32_AVX2, __m256i, i32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_min_epi32)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinU8_AVX2,  __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_min_epu8)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinU16_AVX2, __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_min_epu16)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinU32_AVX2, __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_min_epu32)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinF_AVX2,   __m256,  float,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_min_ps)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MinD_AVX2,   __m256d, double, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_min_pd)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxI8_AVX2,  __m256i, i8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_max_epi8)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxI16_AVX2, __m256i, i16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_max_epi16)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxI32_AVX2, __m256i, i32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_max_epi32)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxU8_AVX2,  __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,   _mm256_max_epu8)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxU16_AVX2, __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16,  _mm256_max_epu16)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxU32_AVX2, __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32,  _mm256_max_epu32)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxF_AVX2,   __m256,  float,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_max_ps)
+TARGET_CPU("avx2") VEC_OP_KERNEL(MaxD_AVX2,   __m256d, double, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_max_pd)
+
+// Indexed by the VK_* operation and the vector encoding (VTSI08..VTSF64):
+static const VEC_OP_FUNC Vec_Ops_SSE2[VK_NONE][VT_MAX] = {
+	{Add8_SSE2, Add16_SSE2, Add32_SSE2, Add64_SSE2, Add8_SSE2, Add16_SSE2, Add32_SSE2, Add64_SSE2, 0, 0, AddF_SSE2, AddD_SSE2},
+	{Sub8_SSE2, Sub16_SSE2, Sub32_SSE2, Sub64_SSE2, Sub8_SSE2, Sub16_SSE2, Sub32_SSE2, Sub64_SSE2, 0, 0, SubF_SSE2, SubD_SSE2},
+	{0, Mul16_SSE2, 0, 0, 0, Mul16_SSE2, 0, 0, 0, 0, MulF_SSE2, MulD_SSE2},
+	{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, DivF_SSE2, DivD_SSE2},
+	{And8_SSE2, And16_SSE2, And32_SSE2, And64_SSE2, And8_SSE2, And16_SSE2, And32_SSE2, And64_SSE2, 0, 0, 0, 0},
+	{Or8_SSE2, Or16_SSE2, Or32_SSE2, Or64_SSE2, Or8_SSE2, Or16_SSE2, Or32_SSE2, Or64_SSE2, 0, 0, 0, 0},
+	{Xor8_SSE2, Xor16_SSE2, Xor32_SSE2, Xor64_SSE2, Xor8_SSE2, Xor16_SSE2, Xor32_SSE2, Xor64_SSE2, 0, 0, 0, 0},
+	{0, MinI16_SSE2, 0, 0, MinU8_SSE2, 0, 0, 0, 0, 0, MinF_SSE2, MinD_SSE2},
+	{0, MaxI16_SSE2, 0, 0, MaxU8_SSE2, 0, 0, 0, 0, 0, MaxF_SSE2, MaxD_SSE2},
+};
+
+static const VEC_OP_FUNC Vec_Ops_AVX2[VK_NONE][VT_MAX] = {
+	{Add8_AVX2, Add16_AVX2, Add32_AVX2, Add64_AVX2, Add8_AVX2, Add16_AVX2, Add32_AVX2, Add64_AVX2, 0, 0, AddF_AVX2, AddD_AVX2},
+	{Sub8_AVX2, Sub16_AVX2, Sub32_AVX2, Sub64_AVX2, Sub8_AVX2, Sub16_AVX2, Sub32_AVX2, Sub64_AVX2, 0, 0, SubF_AVX2, SubD_AVX2},
+	{0, Mul16_AVX2, Mul32_AVX2, 0, 0, Mul16_AVX2, Mul32_AVX2, 0, 0, 0, MulF_AVX2, MulD_AVX2},
+	{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, DivF_AVX2, DivD_AVX2},
+	{And8_AVX2, And16_AVX2, And32_AVX2, And64_AVX2, And8_AVX2, And16_AVX2, And32_AVX2, And64_AVX2, 0, 0, 0, 0},
+	{Or8_AVX2, Or16_AVX2, Or32_AVX2, Or64_AVX2, Or8_AVX2, Or16_AVX2, Or32_AVX2, Or64_AVX2, 0, 0, 0, 0},
+	{Xor8_AVX2, Xor16_AVX2, Xor32_AVX2, Xor64_AVX2, Xor8_AVX2, Xor16_AVX2, Xor32_AVX2, Xor64_AVX2, 0, 0, 0, 0},
+	{MinI8_AVX2, MinI16_AVX2, MinI32_AVX2, 0, MinU8_AVX2, MinU16_AVX2, MinU32_AVX2, 0, 0, 0, MinF_AVX2, MinD_AVX2},
+	{MaxI8_AVX2, MaxI16_AVX2, MaxI32_AVX2, 0, MaxU8_AVX2, MaxU16_AVX2, MaxU32_AVX2, 0, 0, 0, MaxF_AVX2, MaxD_AVX2},
+};
+#endif
+
+VEC_EXT_KERNEL(ExtI16_SSE2, __m128i, i16,    X_LDI, X_STI, _mm_set1_epi16, _mm_min_epi16, _mm_max_epi16)
+VEC_EXT_KERNEL(ExtU8_SSE2,  __m128i, u8,     X_LDI, X_STI, _mm_set1_epi8,  _mm_min_epu8,  _mm_max_epu8)
+VEC_EXT_KERNEL(ExtF_SSE2,   __m128,  float,  _mm_loadu_ps, _mm_storeu_ps, _mm_set1_ps, _mm_min_ps, _mm_max_ps)
+VEC_EXT_KERNEL(ExtD_SSE2,   __m128d, double, _mm_loadu_pd, _mm_storeu_pd, _mm_set1_pd, _mm_min_pd, _mm_max_pd)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtI8_AVX2,  __m256i, i8,     Y_LDI, Y_STI, _mm256_set1_epi8,  _mm256_min_epi8,  _mm256_max_epi8)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtI16_AVX2, __m256i, i16,    Y_LDI, Y_STI, _mm256_set1_epi16, _mm256_min_epi16, _mm256_max_epi16)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtI32_AVX2, __m256i, i32,    Y_LDI, Y_STI, _mm256_set1_epi32, _mm256_min_epi32, _mm256_max_epi32)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtU8_AVX2,  __m256i, u8,     Y_LDI, Y_STI, _mm256_set1_epi8,  _mm256_min_epu8,  _mm256_max_epu8)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtU16_AVX2, __m256i, u16,    Y_LDI, Y_STI, _mm256_set1_epi16, _mm256_min_epu16, _mm256_max_epu16)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtU32_AVX2, __m256i, u32,    Y_LDI, Y_STI, _mm256_set1_epi32, _mm256_min_epu32, _mm256_max_epu32)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtF_AVX2,   __m256,  float,  _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_min_ps, _mm256_max_ps)
+TARGET_CPU("avx2") VEC_EXT_KERNEL(ExtD_AVX2,   __m256d, double, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_min_pd, _mm256_max_pd)
+
+static const VEC_EXT_FUNC Vec_Ext_SSE2[VT_MAX] = {0, ExtI16_SSE2, 0, 0, ExtU8_SSE2, 0, 0, 0, 0, 0, ExtF_SSE2, ExtD_SSE2};
+static const VEC_EXT_FUNC Vec_Ext_AVX2[VT_MAX] = {
+	ExtI8_AVX2, ExtI16_AVX2, ExtI32_AVX2, 0, ExtU8_AVX2, ExtU16_AVX2, ExtU32_AVX2, 0, 0, 0, ExtF_AVX2, ExtD_AVX2
+};
+
+// Conversions of 2 or 4 values to doubles:
+#define X_D_LO(p)	_mm_loadu_pd(p)
+#define X_D_HI(p)	_mm_loadu_pd((p) + 2)
+#define X_F_LO(p)	_mm_cvtps_pd(_mm_loadu_ps(p))
+#define X_F_HI(p)	_mm_cvtps_pd(_mm_movehl_ps(_mm_loadu_ps(p), _mm_loadu_ps(p)))
+#define X_I32_LO(p)	_mm_cvtepi32_pd(X_LDI(p))
+#define X_I32_HI(p)	_mm_cvtepi32_pd(_mm_shuffle_epi32(X_LDI(p), 0xEE))
+#define Y_D(p)		_mm256_loadu_pd(p)
+#define Y_F(p)		_mm256_cvtps_pd(_mm_loadu_ps(p))
+#define Y_I32(p)	_mm256_cvtepi32_pd(X_LDI(p))
+#define Y_I16(p)	_mm256_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i *)(p))))
+#define Y_U16(p)	_mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(p))))
+#define Y_I8(p)		_mm256_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(*(const int *)(p))))
+#define Y_U8(p)		_mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int *)(p))))
+
+VEC_SUM_KERNEL_SSE2(SumI32_SSE2, i32,    X_I32_LO, X_I32_HI)
+VEC_SUM_KERNEL_SSE2(SumF_SSE2,   float,  X_F_LO, X_F_HI)
+VEC_SUM_KERNEL_SSE2(SumD_SSE2,   double, X_D_LO, X_D_HI)
+TARGET_CPU("avx2") VEC_SUM_KERNEL_AVX2(SumI8_AVX2,  i8,     Y_I8)
+TARGET_CPU("avx2") VEC_SUM_KERNEL_AVX2(SumI16_AVX2, i16,    Y_I16)
+TARGET_CPU("avx2") VEC_SUM_KERNEL_AVX2(SumI32_AVX2, i32,    Y_I32)
+TARGET_CPU("avx2") VEC_SUM_KERNEL_AVX2(SumU8_AVX2,  u8,     Y_U8)
+TARGET_CPU("avx2") VEC_SUM_KERNEL_AVX2(SumU16_AVX2, u16,    Y_U16)
+TARGET_CPU("avx2") VEC_SUM_KERNEL_AVX2(SumF_AVX2,   float,  Y_F)
+TARGET_CPU("avx2") VEC_SUM_KERNEL_AVX2(SumD_AVX2,   double, Y_D)
+
+static const VEC_SUM_FUNC Vec_Sum_SSE2[VT_MAX] = {0, 0, SumI32_SSE2, 0, 0, 0, 0, 0, 0, 0, SumF_SSE2, SumD_SSE2};
+static const VEC_SUM_FUNC Vec_Sum_AVX2[VT_MAX] = {
+	SumI8_AVX2, SumI16_AVX2, SumI32_AVX2, 0, SumU8_AVX2, SumU16_AVX2, 0, 0, 0, 0, SumF_AVX2, SumD_AVX2
+};
+#endif // VEC_SIMD
+
+
+#ifndef EXCLUDE_VECTOR_MATH
+/***********************************************************************
+**
+*/	static REBLEN Vec_Simd_Op(REBCNT op, REBCNT bits, void *out, const void *a, const void *b, REBLEN len, REBFLG scalar)
+/*
+**		Runs the SIMD kernel of the operation for the encoding.
+**		Returns the count of values done (0 without a kernel).
+**
+***********************************************************************/
+{
+#ifdef VEC_SIMD
+	VEC_OP_FUNC k = NULL;
+
+	if (op >= VK_NONE || bits >= VT_MAX) return 0;
+	if (Get_CPU_Features() & CPU_AVX2) k = Vec_Ops_AVX2[op][bits];
+	if (!k) k = Vec_Ops_SSE2[op][bits];
+	if (k) return k(out, a, b, len, scalar);
+#endif
+	return 0;
+}
+#endif
+
+
+/***********************************************************************
+**
+*/	static REBLEN Vec_Simd_Extremes(REBCNT bits, const void *a, REBLEN len, void *lo, void *hi)
+/*
+**		Lowers lo and raises hi (both start as a[0], either may be
+**		NULL) with the values of a SIMD kernel for the encoding.
+**		Returns the count of values done (0 without a kernel).
+**
+***********************************************************************/
+{
+#ifdef VEC_SIMD
+	VEC_EXT_FUNC k = NULL;
+
+	if (bits >= VT_MAX) return 0;
+	if (Get_CPU_Features() & CPU_AVX2) k = Vec_Ext_AVX2[bits];
+	if (!k) k = Vec_Ext_SSE2[bits];
+	if (k) return k(a, len, lo, hi);
+#endif
+	return 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBLEN Vec_Simd_Sums(REBCNT kind, REBCNT bits, const void *a, REBLEN len, REBDEC mean, REBDEC *s)
+/*
+**		Sets the 4 lane sums s of the values (VS_SUM) or of their
+**		squared deviations from the mean (VS_DEV) with a SIMD kernel.
+**		Returns the count of values done (0 without a kernel).
+**
+***********************************************************************/
+{
+#ifdef VEC_SIMD
+	VEC_SUM_FUNC k = NULL;
+
+	if (kind == VS_NONE || bits >= VT_MAX) return 0;
+	if (Get_CPU_Features() & CPU_AVX2) k = Vec_Sum_AVX2[bits];
+	if (!k) k = Vec_Sum_SSE2[bits];
+	if (k) return k(a, len, mean, kind == VS_DEV, s);
+#endif
+	return 0;
+}
+
+
 // Query functions
 typedef struct Vector_Query_Values {
 	REBLEN length;
@@ -227,36 +592,84 @@ typedef struct Vector_Query_Values {
 	REBDEC median;
 } REBVQV;
 
+// Sums in 4 lanes, so the order of additions is fixed (the SIMD kernel of
+// the VS_* kind, when there is one, fills the same lanes first):
+#define VEC_SUM_LANES(expr, kind, m) do { \
+		REBDEC s[4] = {0, 0, 0, 0}; \
+		n = Vec_Simd_Sums(kind, bits, p, len, m, s); \
+		for (; n + 4 <= len; n += 4) { \
+			s[0] += VEC_TERM(expr, n);   s[1] += VEC_TERM(expr, n+1); \
+			s[2] += VEC_TERM(expr, n+2); s[3] += VEC_TERM(expr, n+3); \
+		} \
+		for (; n < len; n++) s[0] += VEC_TERM(expr, n); \
+		acc = (s[0] + s[1]) + (s[2] + s[3]); \
+	} while (0)
+#define VEC_TERM(expr, i) expr(p[i])
+
+#define VEC_AS_DEC(x)   ((REBDEC)(x))
+#define VEC_SQ_DEV(x)   (((REBDEC)(x) - mean) * ((REBDEC)(x) - mean))
+
+// Minimum, maximum and sum in one pass (integers up to 32 bits are summed exactly):
+#define VEC_STATS_LOOP(type) { \
+		const type *RESTRICT p = (const type *)data; \
+		type lo = p[0], hi = p[0]; \
+		n = Vec_Simd_Extremes(bits, p, len, &lo, &hi); \
+		for (n = MAX(n, 1); n < len; n++) { \
+			lo = (p[n] < lo) ? p[n] : lo; \
+			hi = (p[n] > hi) ? p[n] : hi; \
+		} \
+		out->minimum = (REBDEC)lo; \
+		out->maximum = (REBDEC)hi; \
+		if (sizeof(type) < 8 && (type)-1 < 0 && (type)0.5 == 0) { \
+			REBI64 isum = 0; \
+			for (n = 0; n < len; n++) isum += (REBI64)p[n]; \
+			acc = (REBDEC)isum; \
+		} else if (sizeof(type) < 8 && (type)0.5 == 0) { \
+			REBU64 usum = 0; \
+			for (n = 0; n < len; n++) usum += (REBU64)p[n]; \
+			acc = (REBDEC)usum; \
+		} else VEC_SUM_LANES(VEC_AS_DEC, VS_SUM, 0); \
+		out->sum = acc; \
+		mean = acc / len; \
+		VEC_SUM_LANES(VEC_SQ_DEV, VS_DEV, mean); \
+	}
+
 static void Query_Vector_Statictics(REBSER* vect, REBVQV* out) {
 	REBLEN len = SERIES_TAIL(vect);
-	REBCNT type = VECT_TYPE(vect);
 	REBYTE* data = SERIES_DATA(vect);
-	REBDEC num, delta, delta2;
+	REBCNT bits = VECT_TYPE(vect);
+	REBDEC acc = 0, mean = 0;
 	REBLEN n;
 
 	CLEARS(out);
 	if (len == 0) return;
 	out->length = len;
 
-	// Seed all running stats from the first element
-	num = get_vect_decimal(type, data, 0);
-	out->minimum = out->maximum = out->sum = out->mean = num;
-
-	for (n = 1; n < len; n++) {
-		num = get_vect_decimal(type, data, n);
-		if (num < out->minimum) out->minimum = num;
-		else if (num > out->maximum) out->maximum = num;
-		out->sum += num;
-
-		// Welford's online mean/variance update (single pass, numerically stable)
-		delta = num - out->mean;        // deviation from mean *before* update
-		out->mean += delta / (n + 1);   // incremental mean update
-		delta2 = num - out->mean;       // deviation from mean *after* update
-		out->sum_of_squares += delta * delta2;  // accumulate M2 (sum of squared deviations)
-	}
+	// Typed loops without per value conversion calls. Variance is computed
+	// in a second pass from the mean (as numerically stable as Welford's).
+	VECT_DISPATCH(bits, VEC_STATS_LOOP);
+
+	out->mean = mean;
+	out->sum_of_squares = acc;              // M2 (sum of squared deviations)
 	out->variance = out->sum_of_squares / len;  // normalize M2 -> population variance
 }
 
+static REBDEC Sum_Of_Vector(REBSER *vect) {
+	REBLEN len = SERIES_TAIL(vect);
+	REBYTE *data = SERIES_DATA(vect);
+	REBCNT bits = VECT_TYPE(vect);
+	REBDEC acc = 0;
+	REBLEN n;
+
+#define VEC_SUM_LOOP(type) { \
+		const type *RESTRICT p = (const type *)data; \
+		VEC_SUM_LANES(VEC_AS_DEC, VS_SUM, 0); \
+	}
+	VECT_DISPATCH(bits, VEC_SUM_LOOP);
+#undef VEC_SUM_LOOP
+	return acc;
+}
+
 static REBDEC Query_Vector_Median(REBSER *vect) {
 	REBLEN len = SERIES_TAIL(vect);
 	REBCNT type = VECT_TYPE(vect);
@@ -320,8 +733,8 @@ void Set_Vector_Row(REBSER *ser, REBVAL *blk)
 			set_vect(bits, ser->data, n++, (REBI64)(data[idx]), f);
 		}
 #else
-		REBCNT bytes = ser->tail * SERIES_WIDE(ser); //TODO: review! Wide is max 256 bytes!!!
-		if (len > bytes) len = bytes;
+		size_t bytes = (size_t)ser->tail * SERIES_WIDE(ser);
+		if (len > bytes) len = (REBCNT)bytes;
 		COPY_MEM(ser->data, VAL_BIN_DATA(blk), len);
 #endif
 	}
@@ -339,7 +752,8 @@ void Find_Minimum_Of_Vector(REBSER *vect, REBVAL *ret) {
 #define FIND_MIN(type, set) {             \
         type *typed_data = (type *)data;     \
         type min_value = typed_data[0];      \
-        for (REBLEN i = 1; i < len; i++) {   \
+        REBLEN i = Vec_Simd_Extremes(VECT_TYPE(vect), data, len, &min_value, NULL); \
+        for (i = MAX(i, 1); i < len; i++) {  \
             min_value = (typed_data[i] < min_value) \
 			          ?  typed_data[i] : min_value; \
         }                                    \
@@ -377,7 +791,8 @@ void Find_Maximum_Of_Vector(REBSER *vect, REBVAL *ret) {
 #define FIND_MAX(type, set) {             \
         type *typed_data = (type *)data;     \
         type max_value = typed_data[0];      \
-        for (REBLEN i = 1; i < len; i++) {   \
+        REBLEN i = Vec_Simd_Extremes(VECT_TYPE(vect), data, len, NULL, &max_value); \
+        for (i = MAX(i, 1); i < len; i++) {  \
             max_value = (typed_data[i] > max_value) \
                       ?  typed_data[i] : max_value; \
         }                                    \
@@ -441,6 +856,9 @@ void Find_Maximum_Of_Vector(REBSER *vect, REBVAL *ret) {
 		if (vqv) RETURN_NUMBER(vqv->maximum);
 		Find_Maximum_Of_Vector(vect, ret);
 		break;
+	case SYM_SUM:
+		if (SERIES_TAIL(vect) == 0) RETURN_NONE();
+		RETURN_NUMBER(vqv ? vqv->sum : Sum_Of_Vector(vect));
 	default:
 		if (!vqv) {
 			REBVQV out;
@@ -448,7 +866,6 @@ void Find_Maximum_Of_Vector(REBSER *vect, REBVAL *ret) {
 			vqv = &out;
 		}
 		if (vqv->length == 0) RETURN_NONE();
-		if (field == SYM_SUM) RETURN_NUMBER(vqv->sum);
 		if (field == SYM_RANGE) RETURN_NUMBER((vqv->maximum - vqv->minimum));
 		if (field == SYM_MEAN || field == SYM_AVERAGE) RETURN_DECIMAL(vqv->mean);
 		if (field == SYM_MEDIAN) RETURN_DECIMAL(Query_Vector_Median(vect));
@@ -502,12 +919,28 @@ return_number:
 
 #ifndef EXCLUDE_VECTOR_MATH
 // Helper macro to generate per-type math code
+// (continues after the n values done by a SIMD kernel)
 #define VEC_OP_LOOP(type, op, val) \
     do { \
-        type *p = (type*)data; \
-        for (REBCNT j = n; j < len; ++j) p[j] op (type)(val); \
+        type *RESTRICT p = (type*)data; \
+        const type v = (type)(val); \
+        for (REBCNT j = n; j < len; ++j) p[j] op v; \
     } while (0)
 
+static REBCNT Vec_Kernel_Op(REBCNT action)
+{
+	switch (action) {
+	case A_ADD:      return VK_ADD;
+	case A_SUBTRACT: return VK_SUB;
+	case A_MULTIPLY: return VK_MUL;
+	case A_DIVIDE:   return VK_DIV;
+	case A_AND:      return VK_AND;
+	case A_OR:       return VK_OR;
+	case A_XOR:      return VK_XOR;
+	}
+	return VK_NONE;
+}
+
 /***********************************************************************
 **
 */	void Math_Op_Vector(REBVAL *out, REBVAL *v1, REBVAL *v2, REBCNT action)
@@ -528,6 +961,7 @@ return_number:
 	REBI64 i = 0;
 	REBDEC f = 0;
 	REBCNT n = 0;
+	REBU64 scalar = 0;
 
 	if (IS_VECTOR(v1) && IS_NUMBER(v2)) {
 		left = v1;
@@ -557,8 +991,9 @@ return_number:
 	dest->size = vect->size; // attributes
 	data = dest->data;
 	SET_VECTOR(out, dest);
-	n = 0;
 
+	VECT_DISPATCH(bits, VEC_SET_SCALAR);
+	n = Vec_Simd_Op(Vec_Kernel_Op(action), bits, data, data, &scalar, len, TRUE);
 
 	switch (action) {
 	case A_ADD:
@@ -678,21 +1113,22 @@ return_number:
 #undef VEC_OP_LOOP
 
 // Helper macro for elementwise vector ops
+// (the result is a new series, so the pointers never alias)
 #define VEC_OP_LOOP(type, op) \
     do { \
-		type *o = (type*)data; \
-        type *p = (type*)data1; \
-        type *q = (type*)data2; \
-        for (REBCNT j = n; j < len; ++j) o[j] = p[idx1 + j] op q[idx2 + j]; \
+        type *RESTRICT o = (type*)data; \
+        const type *RESTRICT p = (type*)data1 + idx1; \
+        const type *RESTRICT q = (type*)data2 + idx2; \
+        for (REBCNT j = n; j < len; ++j) o[j] = p[j] op q[j]; \
     } while (0)
+// Divisors are checked before (all of them, also those done by a kernel)
 #define VEC_OP_LOOP_NO_ZERO(type, op) \
     do { \
-		type *o = (type*)data; \
-        type *p = (type*)data1; \
-        type *q = (type*)data2; \
-        for (REBCNT j = n; j < len; ++j) {\
-			if (q[idx2 + j] == 0) Trap0(RE_ZERO_DIVIDE);\
-			o[j] = p[idx1 + j] op q[idx2 + j];} \
+        const type *RESTRICT z = (type*)data2 + idx2; \
+        REBCNT zeros = 0; \
+        for (REBCNT j = 0; j < len; ++j) zeros += (z[j] == 0); \
+        if (zeros) Trap0(RE_ZERO_DIVIDE); \
+        VEC_OP_LOOP(type, op); \
     } while (0)
 
 /***********************************************************************
@@ -725,7 +1161,8 @@ return_number:
 	data = dest->data;
 	SERIES_TAIL(dest) = len;
 	SET_VECTOR(out, dest);
-	n = 0;
+	n = Vec_Simd_Op(Vec_Kernel_Op(action), bits1, data,
+		data1 + idx1 * SERIES_WIDE(vect1), data2 + idx2 * SERIES_WIDE(vect2), len, FALSE);
 
 	switch (action) {
 	case A_ADD:
@@ -842,6 +1279,83 @@ return_number:
 }
 #undef VEC_OP_LOOP
 #undef VEC_OP_LOOP_NO_ZERO
+
+
+/***********************************************************************
+**
+*/	void Min_Max_Vector(REBVAL *out, REBVAL *v1, REBVAL *v2, REBFLG maximum)
+/*
+**		Elementwise minimum or maximum of a vector and a vector or
+**		a number. Vectors must be of the same type; the result has
+**		length of the shorter one.
+**
+***********************************************************************/
+{
+	REBVAL *left = IS_VECTOR(v1) ? v1 : v2;
+	REBVAL *right = (left == v1) ? v2 : v1;
+	REBSER *vect = VAL_SERIES(left);
+	REBINT bits = VECT_TYPE(vect);
+	REBLEN len = VAL_LEN(left);
+	REBLEN idx1 = VAL_INDEX(left);
+	REBLEN idx2 = 0;
+	REBYTE *data1 = vect->data;
+	REBYTE *data2 = NULL;
+	REBYTE *data;
+	REBSER *dest;
+	REBI64 i = 0;
+	REBDEC f = 0;
+	REBU64 scalar = 0;
+	REBLEN n;
+
+	if (IS_VECTOR(right)) {
+		if (bits != VECT_TYPE(VAL_SERIES(right))) Trap0(RE_VECTOR_NOT_COMPATIBLE);
+		len = MIN(len, VAL_LEN(right));
+		idx2 = VAL_INDEX(right);
+		data2 = VAL_SERIES(right)->data;
+	}
+	else if (IS_INTEGER(right)) f = (REBDEC)(i = VAL_INT64(right));
+	else if (IS_DECIMAL(right) || IS_PERCENT(right)) i = (REBI64)(f = VAL_DECIMAL(right));
+	else Trap_Arg(right);
+
+	dest = Make_Series(MAX(len,1), SERIES_WIDE(vect), FALSE);
+	dest->size = vect->size; // attributes
+	data = dest->data;
+	SERIES_TAIL(dest) = len;
+	SET_VECTOR(out, dest);
+
+	if (!data2) VECT_DISPATCH(bits, VEC_SET_SCALAR);
+	n = Vec_Simd_Op(maximum ? VK_MAX : VK_MIN, bits, data, data1 + idx1 * SERIES_WIDE(vect),
+		data2 ? (void *)(data2 + idx2 * SERIES_WIDE(vect)) : (void *)&scalar, len, !data2);
+
+#define VEC_PICK(a, b) (maximum ? ((a) > (b) ? (a) : (b)) : ((a) < (b) ? (a) : (b)))
+#define VEC_MIN_MAX(type, val) \
+    do { \
+        type *RESTRICT o = (type*)data; \
+        const type *RESTRICT p = (type*)data1 + idx1; \
+        if (data2) { \
+            const type *RESTRICT q = (type*)data2 + idx2; \
+            for (REBLEN j = n; j < len; ++j) o[j] = VEC_PICK(p[j], q[j]); \
+        } else { \
+            const type v = (type)(val); \
+            for (REBLEN j = n; j < len; ++j) o[j] = VEC_PICK(p[j], v); \
+        } \
+    } while (0)
+
+	switch (bits) {
+	case VTSI08: VEC_MIN_MAX(i8, i); break;
+	case VTSI16: VEC_MIN_MAX(i16, i); break;
+	case VTSI32: VEC_MIN_MAX(i32, i); break;
+	case VTSI64: VEC_MIN_MAX(i64, i); break;
+	case VTUI08: VEC_MIN_MAX(u8, i); break;
+	case VTUI16: VEC_MIN_MAX(u16, i); break;
+	case VTUI32: VEC_MIN_MAX(u32, i); break;
+	case VTUI64: VEC_MIN_MAX(u64, i); break;
+	case VTSF32: VEC_MIN_MAX(float, f); break;
+	case VTSF64: VEC_MIN_MAX(double, f); break;
+	}
+#undef VEC_MIN_MAX
+#undef VEC_PICK
+}
 #endif
 
 /***********************************************************************
@@ -940,7 +1454,10 @@ return_number:
 	REBCNT idx = VAL_INDEX(vect);
 	REBCNT skp = VECT_BYTE_SIZE(type);
 	REBYTE *data = VAL_SERIES(vect)->data + (idx * skp);
+	REBCNT kind = (type >= VTSF08) ? RADIX_FLOAT : (type >= VTUI08) ? RADIX_UNSIGNED : RADIX_SIGNED;
 	ASSERT1(type < VT_MAX, RP_ASSERTS);
+	// Radix sort needs a few passes over the data for any length:
+	if (len >= 64 && Radix_Sort(data, len, skp, kind, reversed)) return;
 	unstable_sort(data, len, skp, reversed ? compares_rev[type] : compares[type]);
 }
 
@@ -975,8 +1492,9 @@ return_number:
 
 	//printf("MAKE_VECTOR=> type: %i sign: %i dims: %i bits: %i size: %i\n", type, sign, dims, bits, size);
 
+	// The length is limited, but the data may have more than 4GB:
+	if (size < 0 || (REBU64)size * dims >= MAX_SERIES_LEN) return 0;
 	len = size * dims;
-	if (len > 0x7fffffff) return 0;
 	ser = Make_Series(len+1, bits/8, TRUE); // !!! can width help extend the len?
 	LABEL_SERIES(ser, "make vector");
 	//No need to clear the series, because Make_Series guarantees completely cleared memory.
@@ -1362,6 +1880,185 @@ static void reverse_vector(REBVAL *value, REBCNT len)
 }
 
 
+/***********************************************************************
+**
+*/	REBNATIVE(dot_product)
+/*
+//	dot-product: native [
+//		"Returns the sum of products of the vectors' values"
+//		a [vector!]
+//		b [vector!] "Vector of the same type (only the shorter length is used)"
+//	]
+***********************************************************************/
+{
+	REBVAL *a = D_ARG(1);
+	REBVAL *b = D_ARG(2);
+	REBSER *va = VAL_SERIES(a);
+	REBINT bits = VECT_TYPE(va);
+	REBLEN len = MIN(VAL_LEN(a), VAL_LEN(b));
+	REBLEN n;
+	REBU64 isum = 0;
+	REBDEC acc = 0;
+
+	if (bits != VECT_TYPE(VAL_SERIES(b))) Trap0(RE_VECTOR_NOT_COMPATIBLE);
+
+	// Integers wrap around as in other integer vector math (unsigned, so the
+	// overflow is defined), decimals are summed in 4 lanes (see VEC_SUM_LANES).
+#define VEC_DOT(type) { \
+		const type *RESTRICT p = (type*)va->data + VAL_INDEX(a); \
+		const type *RESTRICT q = (type*)VAL_SERIES(b)->data + VAL_INDEX(b); \
+		if ((type)0.5 == 0) { \
+			for (n = 0; n < len; n++) isum += (REBU64)p[n] * (REBU64)q[n]; \
+		} else VEC_SUM_LANES(VEC_AS_DEC, VS_NONE, 0); \
+	}
+#undef VEC_TERM
+#define VEC_TERM(expr, i) expr(p[i]) * (REBDEC)q[i]
+	VECT_DISPATCH(bits, VEC_DOT);
+#undef VEC_TERM
+#define VEC_TERM(expr, i) expr(p[i])
+#undef VEC_DOT
+
+	if (bits < VTSF08) SET_INTEGER(D_RET, (REBI64)isum);
+	else SET_DECIMAL(D_RET, acc);
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	static REBOOL Find_Vector_Extreme(REBVAL *vec, REBFLG maximum)
+/*
+**		Moves the vector's index to its first minimum or maximum.
+**		Returns FALSE when the vector is empty.
+**		NaN values are skipped (the head is used when all are NaN).
+**
+***********************************************************************/
+{
+	REBSER *vect = VAL_SERIES(vec);
+	REBLEN len = VAL_LEN(vec);
+	REBLEN at = 0;
+	REBLEN n;
+
+	if (len == 0) return FALSE;
+
+	// Search for the value first (vectorizable), then for its position.
+	// Comparisons with NaN are false, so only a NaN seed must be avoided:
+#define VEC_EXTREME(type) { \
+		const type *RESTRICT p = (type*)vect->data + VAL_INDEX(vec); \
+		type e; \
+		while (at < len && p[at] != p[at]) at++; \
+		if (at == len) at = 0; \
+		e = p[at]; \
+		n = at + Vec_Simd_Extremes(VECT_TYPE(vect), p + at, len - at, maximum ? NULL : &e, maximum ? &e : NULL); \
+		if (n == at) n++; \
+		if (maximum) { for (; n < len; n++) e = (p[n] > e) ? p[n] : e; } \
+		else         { for (; n < len; n++) e = (p[n] < e) ? p[n] : e; } \
+		while (at < len && p[at] != e) at++; \
+		if (at == len) at = 0; \
+	}
+	VECT_DISPATCH(VECT_TYPE(vect), VEC_EXTREME);
+#undef VEC_EXTREME
+
+	VAL_INDEX(vec) += at;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(minimum_of)
+/*
+//	minimum-of: native [
+//		"Returns the vector at its (first) minimum value or NONE if empty"
+//		vector [vector!]
+//	]
+***********************************************************************/
+{
+	return Find_Vector_Extreme(D_ARG(1), FALSE) ? R_ARG1 : R_NONE;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(maximum_of)
+/*
+//	maximum-of: native [
+//		"Returns the vector at its (first) maximum value or NONE if empty"
+//		vector [vector!]
+//	]
+***********************************************************************/
+{
+	return Find_Vector_Extreme(D_ARG(1), TRUE) ? R_ARG1 : R_NONE;
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(histogram)
+/*
+//	histogram: native [
+//		"Counts the vector's values in equal width bins. Returns int64! vector."
+//		vector [vector!]
+//		bins   [integer!] "Number of bins"
+//		/range "Specify the counted range (default is minimum and maximum)"
+//		 min [number!]
+//		 max [number!] "Values equal to max are counted in the last bin"
+//	]
+**
+**		Values outside of the range are not counted.
+**
+***********************************************************************/
+{
+	REBVAL *vec  = D_ARG(1);
+	REBVAL *arg  = D_ARG(2);
+	REBSER *vect = VAL_SERIES(vec);
+	REBLEN len   = VAL_LEN(vec);
+	REBI64 bins  = VAL_INT64(arg);
+	REBDEC lo, hi, scale;
+	REBSER *ser;
+	i64 *counts;
+	REBLEN n;
+
+	if (bins <= 0 || bins > MAX_I32) Trap_Arg(arg);
+
+	ser = Make_Vector(0, 0, 1, 64, (REBINT)bins);
+	counts = (i64*)ser->data;
+	SET_VECTOR(D_RET, ser);
+
+	if (D_REF(3)) {
+		lo = IS_INTEGER(D_ARG(4)) ? (REBDEC)VAL_INT64(D_ARG(4)) : VAL_DECIMAL(D_ARG(4));
+		hi = IS_INTEGER(D_ARG(5)) ? (REBDEC)VAL_INT64(D_ARG(5)) : VAL_DECIMAL(D_ARG(5));
+		if (!(hi >= lo)) Trap_Arg(D_ARG(5));
+	}
+	else if (len == 0) return R_RET;
+
+	// Without the range, it is found in the first pass:
+#define VEC_HISTOGRAM(type) { \
+		const type *RESTRICT p = (type*)vect->data + VAL_INDEX(vec); \
+		if (!D_REF(3)) { \
+			type mn = p[0], mx = p[0]; \
+			for (n = 1; n < len; n++) { \
+				mn = (p[n] < mn) ? p[n] : mn; \
+				mx = (p[n] > mx) ? p[n] : mx; \
+			} \
+			lo = (REBDEC)mn; hi = (REBDEC)mx; \
+		} \
+		scale = (hi > lo) ? (REBDEC)bins / (hi - lo) : 0; \
+		for (n = 0; n < len; n++) { \
+			REBDEC x = (REBDEC)p[n]; \
+			REBI64 b; \
+			if (!(x >= lo && x <= hi)) continue; \
+			b = (REBI64)((x - lo) * scale); \
+			counts[b < bins ? b : bins - 1]++; \
+		} \
+	}
+	VECT_DISPATCH(VECT_TYPE(vect), VEC_HISTOGRAM);
+#undef VEC_HISTOGRAM
+
+	return R_RET;
+}
+
+
 /***********************************************************************
 **
 */	REBTYPE(Vector)
@@ -1731,7 +2428,7 @@ bad_make:
 	for (; dups > 0; dups--) {
 		// Don't use Insert_String as we may be inserting to a binary!
 		// Destination is already expanded above.
-		COPY_MEM(BIN_SKIP(vect, index * bpv), BIN_SKIP(src_ser, src_idx), src_len * bpv);
+		COPY_MEM(BIN_SKIP(vect, (size_t)index * bpv), BIN_SKIP(src_ser, src_idx), (size_t)src_len * bpv);
 		index += src_len;
 	}
 
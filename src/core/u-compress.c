@@ -712,9 +712,20 @@ void LZ4_free(void* address) {
 */  int DecompressLz4(const REBYTE* input, REBLEN len, REBLEN limit, REBSER** output, int* error)
 /*
 **      Decompress a binary using LZ4.
+**      Input may be a raw block (as made by CompressLz4) or a frame
+**      (as written by the compress:// port or the lz4 tools).
 **
 ***********************************************************************/
 {
+	if (len >= 4 && U8TO32_LE(input) == 0x184D2204) { // LZ4 frame magic number
+		*output = Make_Binary(len * 3);
+		if (!Decompress_Lz4_Frame(input, len, *output)) return FALSE;
+		if (limit != NO_LIMIT && SERIES_TAIL(*output) > limit) {
+			SERIES_TAIL(*output) = limit;
+			TERM_SERIES(*output);
+		}
+		return TRUE;
+	}
 	*output = Make_Binary((limit != NO_LIMIT) ? limit : len * 3);
 	int result = LZ4_decompress_safe(input, BIN_HEAD(*output), len, SERIES_REST(*output));
 	if (result <= 0) return FALSE;
@@ -0,0 +1,416 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2025 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-csv.c
+**  Summary: CSV row decoder
+**  Section: utility
+**  Author:  Oldes
+**  Notes:
+**    Decodes one row at a time, so data of any size may be processed
+**    with memory for just one row (see CSV-EACH in %mezz/codec-csv.reb).
+**    Quoted values are handled as in LOAD-CSV (Excel compatible: chars
+**    after the closing quote are kept) and rows may end with CRLF, CR
+**    or LF.
+**
+***********************************************************************/
+
+#include "sys-core.h"
+#include "sys-scan.h"
+
+#define CSV_QUOTE '"'
+
+
+/***********************************************************************
+**
+*/	static const REBYTE *Scan_CSV_Field(const REBYTE *cp, const REBYTE *end, REBYTE delim, REBFLG chunk)
+/*
+**		Returns position after the field (at a delimiter, a newline or
+**		the end) or NULL when more input is needed to complete it.
+**
+***********************************************************************/
+{
+	const REBYTE *q;
+
+	if (cp < end && *cp == CSV_QUOTE) {
+		for (cp++;; cp = q + 2) {
+			q = memchr(cp, CSV_QUOTE, end - cp);
+			if (!q) return chunk ? NULL : end;
+			if (q + 1 == end) {
+				if (chunk) return NULL; // may be an escaped quote
+				return end;
+			}
+			if (q[1] != CSV_QUOTE) break;
+		}
+		cp = q + 1; // chars after the closing quote are part of the field
+	}
+	while (cp < end && *cp != delim && *cp != CR && *cp != LF) cp++;
+	return cp;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Copy_CSV_Field(REBYTE *dst, const REBYTE *cp, const REBYTE *end)
+/*
+**		Copies field's value (without quotes). The destination must
+**		have space for (end - cp) bytes. Returns the length.
+**
+***********************************************************************/
+{
+	REBYTE *dp = dst;
+	const REBYTE *q;
+
+	if (cp < end && *cp == CSV_QUOTE) {
+		for (cp++; cp < end; cp = q + 2) {
+			q = memchr(cp, CSV_QUOTE, end - cp);
+			if (!q) q = end;
+			COPY_MEM(dp, cp, q - cp);
+			dp += q - cp;
+			if (q + 1 >= end || q[1] != CSV_QUOTE) {
+				cp = q + 1;
+				break;
+			}
+			*dp++ = CSV_QUOTE;
+		}
+	}
+	if (cp < end) {
+		COPY_MEM(dp, cp, end - cp);
+		dp += end - cp;
+	}
+	return (REBCNT)(dp - dst);
+}
+
+
+/***********************************************************************
+**
+*/	static void Scan_CSV_Number(REBVAL *out, const REBYTE *cp, const REBYTE *end)
+/*
+**		Scans field's value as a number (empty value as zero).
+**
+***********************************************************************/
+{
+	REBYTE buf[MAX_NUM_LEN+1];
+	REBYTE *bp = buf;
+	REBCNT len;
+
+	if ((REBCNT)(end - cp) > MAX_NUM_LEN) goto bad;
+
+	// Scanners may look past the length, so the number is terminated:
+	len = Copy_CSV_Field(buf, cp, end);
+	while (len > 0 && IS_LEX_SPACE(*bp)) bp++, len--;
+	while (len > 0 && IS_LEX_SPACE(bp[len-1])) len--;
+	bp[len] = 0;
+
+	if (len == 0) SET_INTEGER(out, 0);
+	else if (!Scan_Integer(bp, len, out) && !Scan_Decimal(bp, len, out, TRUE)) goto bad;
+	return;
+
+bad:
+	Set_String(out, Copy_Bytes(cp, (REBLEN)(end - cp)));
+	Trap1(RE_INVALID_DATA, out);
+}
+
+
+/***********************************************************************
+**
+*/	static void Append_CSV_Columns(REBVAL *row, const REBYTE *cp, const REBYTE *ep, REBYTE delim)
+/*
+**		Appends the row's values to vectors in the row block (one per
+**		column). Missing trailing values are appended as zero, so all
+**		vectors stay aligned. The whole row is checked first, so no
+**		vector is modified when it is not valid.
+**
+***********************************************************************/
+{
+	REBCNT cols = VAL_LEN(row);
+	REBVAL *vect = VAL_BLK_DATA(row);
+	REBVAL num;
+	const REBYTE *fp;
+	const REBYTE *bp = cp;
+	REBCNT n;
+
+	for (n = 0; n < cols; n++) {
+		if (!IS_VECTOR(vect + n)) Trap_Arg(vect + n);
+		TRAP_PROTECT(VAL_SERIES(vect + n));
+	}
+	for (n = 0;; cp++, n++) {
+		fp = cp;
+		cp = Scan_CSV_Field(cp, ep, delim, FALSE);
+		if (n >= cols) Trap1(RE_INVALID_DATA, row);
+		Scan_CSV_Number(&num, fp, cp);
+		if (cp >= ep) break;
+	}
+
+	for (cp = bp, n = 0; n < cols; n++) {
+		if (cp) {
+			fp = cp;
+			cp = Scan_CSV_Field(cp, ep, delim, FALSE);
+			Scan_CSV_Number(&num, fp, cp);
+			cp = (cp < ep) ? cp + 1 : NULL;
+		}
+		else SET_INTEGER(&num, 0);
+		Modify_Vector(A_APPEND, VAL_SERIES(vect + n), 0, &num, 0, 0, 1);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(csv_row)
+/*
+//	csv-row: native [
+//		"Decodes one row of CSV data into a block. Returns the input after the row or NONE at the end."
+//		data [binary! string!] "UTF-8 encoded input"
+//		row  [block!] "Block for the row's values (cleared first)"
+//		/with "Specify field delimiter"
+//		 delimiter [char!] {Default #","}
+//		/columns "Append values to vectors in the row block instead (one per column, missing values as zero)"
+//		/chunk "Input may continue in a next chunk: returns NONE also when the row may be incomplete"
+//	]
+**
+**		The row is decoded in two passes. The first one only finds its
+**		end, so nothing is modified when the row is not complete.
+**
+***********************************************************************/
+{
+	REBVAL *data  = D_ARG(1);
+	REBVAL *row   = D_ARG(2);
+	REBFLG  cols  = D_REF(5);
+	REBFLG  chunk = D_REF(6);
+	REBCNT  delim = ',';
+	const REBYTE *bp  = VAL_BIN_DATA(data);
+	const REBYTE *end = bp + VAL_LEN(data);
+	const REBYTE *cp;
+	const REBYTE *ep;
+	const REBYTE *next;
+	REBSER *ser;
+
+	if (D_REF(3)) {
+		delim = VAL_CHAR(D_ARG(4));
+		if (delim >= 0x80 || delim == CR || delim == LF || delim == CSV_QUOTE)
+			Trap_Arg(D_ARG(4));
+	}
+
+	// Skip UTF-8 BOM at the start of the data:
+	if (VAL_INDEX(data) == 0 && end - bp >= 3 && bp[0] == 0xEF && bp[1] == 0xBB && bp[2] == 0xBF)
+		bp += 3;
+
+	if (bp >= end) return R_NONE;
+
+	// Find the row's end:
+	for (cp = bp;; cp++) {
+		cp = Scan_CSV_Field(cp, end, (REBYTE)delim, chunk);
+		if (!cp || (cp == end && chunk)) return R_NONE;
+		if (cp == end || *cp != delim) break;
+	}
+	ep = cp;
+	if (cp < end && *cp++ == CR) {
+		if (cp == end && chunk) return R_NONE; // LF may follow
+		if (cp < end && *cp == LF) cp++;
+	}
+	next = cp;
+
+	if (!cols) {
+		TRAP_PROTECT(VAL_SERIES(row));
+		RESET_TAIL(VAL_SERIES(row));
+		TERM_SERIES(VAL_SERIES(row));
+	}
+
+	if (cols) Append_CSV_Columns(row, bp, ep, (REBYTE)delim);
+	else for (cp = bp;; cp++) {
+		bp = cp;
+		cp = Scan_CSV_Field(cp, ep, (REBYTE)delim, FALSE);
+		ser = Make_Binary((REBCNT)(cp - bp));
+		SERIES_TAIL(ser) = Copy_CSV_Field(BIN_HEAD(ser), bp, cp);
+		TERM_SERIES(ser);
+		if (!Is_ASCII(BIN_HEAD(ser), SERIES_TAIL(ser))) UTF8_SERIES(ser);
+		Set_String(Append_Value(VAL_SERIES(row)), ser);
+		if (cp >= ep) break;
+	}
+
+	*D_RET = *data;
+	VAL_INDEX(D_RET) = (REBCNT)(next - VAL_BIN_HEAD(data));
+	return R_RET;
+}
+
+
+/***********************************************************************
+**
+*/	static void Append_CSV_Quoted(REBSER *out, const REBYTE *bp, REBCNT len)
+/*
+**		Appends UTF-8 text in quotes (quotes inside are doubled).
+**
+***********************************************************************/
+{
+	const REBYTE *q;
+	REBCNT n;
+
+	Append_Byte(out, CSV_QUOTE);
+	while ((q = memchr(bp, CSV_QUOTE, len))) {
+		n = (REBCNT)(q - bp) + 1; // including the quote
+		Append_UTF8(out, bp, n);
+		Append_Byte(out, CSV_QUOTE);
+		bp += n;
+		len -= n;
+	}
+	Append_UTF8(out, bp, len);
+	Append_Byte(out, CSV_QUOTE);
+}
+
+
+/***********************************************************************
+**
+*/	static void Append_CSV_Date(REBSER *out, REBVAL *value)
+/*
+**		Appends date in ISO format (Excel compatible subset), using
+**		the date's own zone: YYYY-MM-DD or YYYY-MM-DD hh:mm:ss
+**
+***********************************************************************/
+{
+	REBYTE buf[64];
+	REBYTE *bp = buf;
+	REB_TIMEF tf;
+	REBVAL val = *value;
+
+	if (VAL_TIME(&val) != NO_TIME) Adjust_Date_Zone(&val, FALSE);
+
+	bp = Form_Int_Pad(bp, (REBINT)VAL_YEAR(&val), 6, -4, '0');
+	*bp++ = '-';
+	bp = Form_Int_Pad(bp, (REBINT)VAL_MONTH(&val), 2, -2, '0');
+	*bp++ = '-';
+	bp = Form_Int_Pad(bp, (REBINT)VAL_DAY(&val), 2, -2, '0');
+
+	if (VAL_TIME(&val) != NO_TIME) {
+		Split_Time(VAL_TIME(&val), &tf);
+		*bp++ = ' ';
+		bp = Form_Int_Pad(bp, (REBINT)tf.h, 2, -2, '0');
+		*bp++ = ':';
+		bp = Form_Int_Pad(bp, (REBINT)tf.m, 2, -2, '0');
+		*bp++ = ':';
+		bp = Form_Int_Pad(bp, (REBINT)tf.s, 2, -2, '0');
+		if (tf.n > 0) {
+			// Fraction of the second without trailing zeros:
+			*bp++ = '.';
+			bp = Form_Int_Pad(bp, (REBINT)tf.n, 9, -9, '0');
+			while (bp[-1] == '0') bp--;
+		}
+	}
+	Append_Bytes_Len(out, buf, (REBCNT)(bp - buf));
+}
+
+
+/***********************************************************************
+**
+*/	static void Append_CSV_Value(REBSER *out, REBVAL *value)
+/*
+**		Appends one value as a CSV field. Strings, chars, words, paths
+**		and binaries are quoted. Other scalars are formed (money
+**		without the denomination and dates in ISO format).
+**
+***********************************************************************/
+{
+	REBYTE buf[8];
+	REBSER *ser;
+	REBYTE *bp;
+	REBCNT len;
+
+	if (IS_NONE(value)) return;
+
+	if (ANY_BINSTR(value)) {
+		Append_CSV_Quoted(out, VAL_BIN_DATA(value), (REBCNT)(VAL_BIN_TAIL(value) - VAL_BIN_DATA(value)));
+	}
+	else if (IS_CHAR(value)) {
+		len = Encode_UTF8_Char(buf, VAL_CHAR(value));
+		Append_CSV_Quoted(out, buf, len);
+	}
+	else if (ANY_WORD(value)) {
+		bp = Get_Word_Name(value);
+		Append_CSV_Quoted(out, bp, LEN_BYTES(bp));
+	}
+	else if (IS_DATE(value)) {
+		Append_CSV_Date(out, value);
+	}
+	else if (ANY_PATH(value) || (VAL_TYPE(value) >= REB_INTEGER && VAL_TYPE(value) <= REB_TIME)) {
+		// Formed into the mold buffer, so not any allocation per field:
+		ser = Form_Value(value, 0, FALSE);
+		bp = BIN_HEAD(ser);
+		len = SERIES_TAIL(ser);
+		if (ANY_PATH(value)) {
+			Append_CSV_Quoted(out, bp, len);
+			return;
+		}
+		if (IS_MONEY(value)) {
+			// Keep the sign, but not the $ (and any denomination before it):
+			if (*bp == '-') Append_Byte(out, '-');
+			while (len > 0 && *bp != '$') bp++, len--;
+			if (len > 0) bp++, len--;
+		}
+		Append_UTF8(out, bp, len);
+	}
+	else {
+		Trap_Arg(value);
+	}
+}
+
+
+/***********************************************************************
+**
+*/	REBNATIVE(csv_line)
+/*
+//	csv-line: native [
+//		"Appends a block of values to a string as one CSV formatted line (without newline). Returns the string."
+//		output    [string!] "Appended at its tail"
+//		values    [block!]
+//		delimiter [char! string!] "Field delimiter"
+//	]
+**
+**		Formats the values in place, so the line is made without any
+**		temporary strings (LOAD-CSV compatible quoting).
+**
+***********************************************************************/
+{
+	REBVAL *output = D_ARG(1);
+	REBVAL *delim  = D_ARG(3);
+	REBSER *out = VAL_SERIES(output);
+	REBVAL *val;
+	REBYTE buf[8];
+	REBYTE *dp;
+	REBCNT dlen;
+
+	TRAP_PROTECT(out);
+
+	if (IS_CHAR(delim)) {
+		dp = buf;
+		dlen = Encode_UTF8_Char(buf, VAL_CHAR(delim));
+	}
+	else {
+		dp = VAL_BIN_DATA(delim);
+		dlen = (REBCNT)(VAL_BIN_TAIL(delim) - dp);
+	}
+
+	for (val = VAL_BLK_DATA(D_ARG(2)); NOT_END(val); val++) {
+		if (val != VAL_BLK_DATA(D_ARG(2))) Append_UTF8(out, dp, dlen);
+		Append_CSV_Value(out, val);
+	}
+	TERM_SERIES(out);
+
+	return R_ARG1;
+}
@@ -0,0 +1,665 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2025 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-json.c
+**  Summary: JSON codec
+**  Section: utility
+**  Author:  Oldes
+**  Notes:
+**    Produces the same values as the JSON codec in %mezz/codec-json.reb:
+**    objects are decoded as maps (keys are words when valid, else
+**    strings), arrays as blocks and null as NONE.
+**    Values are decoded in a single pass into the emit buffer (like in
+**    the scanner) and blocks and maps are made directly from it.
+**    Encoding is done into the mold buffer. Options (DO-CODEC/AS) may be
+**    a string (indentation for pretty output) or a block with such
+**    string and/or the ASCII word (escape all chars above 127).
+**
+***********************************************************************
+**  Base-code:
+
+	if find system/codecs 'json [
+		system/codecs/json/title: "JavaScript Object Notation"
+		system/codecs/json/type: 'text
+		system/codecs/json/suffixes: [%.json]
+		append append system/catalog/file-types system/codecs/json/suffixes 'json
+	]
+
+***********************************************************************/
+
+#include "sys-core.h"
+#include "sys-scan.h"
+
+#ifdef INCLUDE_JSON_CODEC
+
+typedef struct Reb_JSON_Decoder {
+	const REBYTE *cp;	// current position
+	const REBYTE *end;
+	REBSER *buf;		// emit buffer (holds values of open arrays and objects)
+} REBJSD;
+
+typedef struct Reb_JSON_Encoder {
+	REB_MOLD *mo;
+	REBYTE *indent;		// NULL when not pretty
+	REBCNT  indent_len;
+	REBCNT  level;
+	REBFLG  ascii;
+} REBJSE;
+
+#define IS_JSON_SPACE(c) ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r')
+
+// Strings are scanned a machine word at a time (until a quote or a backslash):
+#define ONES_64  0x0101010101010101ULL
+#define HIGHS_64 0x8080808080808080ULL
+#define HAS_ZERO_BYTE(v) (((v) - ONES_64) & ~(v) & HIGHS_64)
+
+static REBFLG Decode_JSON_Value(REBJSD *jd);
+
+
+/***********************************************************************
+**
+*/	static void Skip_JSON_Space(REBJSD *jd)
+/*
+***********************************************************************/
+{
+	const REBYTE *cp = jd->cp;
+	while (cp < jd->end && IS_JSON_SPACE(*cp)) cp++;
+	jd->cp = cp;
+}
+
+
+/***********************************************************************
+**
+*/	static REBINT Hex4_Value(const REBYTE *cp)
+/*
+**		Returns value of 4 hex digits or -1.
+**
+***********************************************************************/
+{
+	REBINT n = 0;
+	REBINT i;
+	REBYTE c;
+
+	for (i = 0; i < 4; i++) {
+		c = cp[i];
+		if (c >= '0' && c <= '9') c -= '0';
+		else if (c >= 'a' && c <= 'f') c -= 'a' - 10;
+		else if (c >= 'A' && c <= 'F') c -= 'A' - 10;
+		else return -1;
+		n = (n << 4) | c;
+	}
+	return n;
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Decode_JSON_String(REBJSD *jd)
+/*
+**		Position is past the opening quote. Returns NULL on error.
+**		Escapes can only shrink the text, so the result is decoded
+**		into a series of the raw length.
+**
+***********************************************************************/
+{
+	const REBYTE *cp = jd->cp;
+	const REBYTE *end = jd->end;
+	const REBYTE *start = cp;
+	REBFLG escaped = FALSE;
+	REBSER *ser;
+	REBYTE *dp;
+	REBU64 w;
+	REBINT c, c2;
+
+	// Find the closing quote:
+	for (;;) {
+		while (cp + 8 <= end) {
+			memcpy(&w, cp, 8);
+			if (HAS_ZERO_BYTE(w ^ (ONES_64 * '"')) | HAS_ZERO_BYTE(w ^ (ONES_64 * '\\'))) break;
+			cp += 8;
+		}
+		while (cp < end && *cp != '"' && *cp != '\\') cp++;
+		if (cp >= end) return NULL;
+		if (*cp == '"') break;
+		escaped = TRUE;
+		cp += 2; // skip the escaped char (validated below)
+	}
+	jd->cp = cp + 1;
+
+	if (!escaped) {
+		for (dp = (REBYTE *)start; dp < cp; dp++) if (*dp < 0x20) return NULL;
+		return Copy_Str(start, (REBLEN)(cp - start));
+	}
+
+	ser = Make_Binary((REBCNT)(cp - start));
+	dp = BIN_HEAD(ser);
+	end = cp;
+	for (cp = start; cp < end; cp++) {
+		if (*cp < 0x20) return NULL;
+		if (*cp != '\\') {
+			*dp++ = *cp;
+			continue;
+		}
+		switch (*++cp) {
+		case '"':  *dp++ = '"';  break;
+		case '\\': *dp++ = '\\'; break;
+		case '/':  *dp++ = '/';  break;
+		case 'b':  *dp++ = '\b'; break;
+		case 'f':  *dp++ = '\f'; break;
+		case 'n':  *dp++ = '\n'; break;
+		case 'r':  *dp++ = '\r'; break;
+		case 't':  *dp++ = '\t'; break;
+		case 'u':
+			if (cp + 4 >= end || (c = Hex4_Value(cp + 1)) < 0) return NULL;
+			cp += 4;
+			// Join a valid surrogate pair, else keep the code unit as it is:
+			if (c >= 0xD800 && c <= 0xDBFF && cp + 6 < end && cp[1] == '\\' && cp[2] == 'u') {
+				c2 = Hex4_Value(cp + 3);
+				if (c2 >= 0xDC00 && c2 <= 0xDFFF) {
+					c = 0x10000 + ((c - 0xD800) << 10) + (c2 - 0xDC00);
+					cp += 6;
+				}
+			}
+			dp += Encode_UTF8_Char(dp, c);
+			break;
+		default:
+			return NULL;
+		}
+	}
+	SERIES_TAIL(ser) = (REBCNT)(dp - BIN_HEAD(ser));
+	STR_TERM(ser);
+	if (!Is_ASCII(BIN_HEAD(ser), SERIES_TAIL(ser))) UTF8_SERIES(ser);
+	return ser;
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_JSON_Key(REBVAL *out, REBSER *str)
+/*
+**		Keys are words when the text is a valid word (as TO WORD!).
+**
+***********************************************************************/
+{
+	REBYTE *bp = BIN_HEAD(str);
+	REBCNT len = SERIES_TAIL(str);
+	REBCNT sym = 0;
+
+	while (len > 0 && IS_LEX_SPACE(*bp)) bp++, len--;
+	while (len > 0 && IS_LEX_SPACE(bp[len-1])) len--;
+	if (len > 0 && len <= 255) sym = Scan_Word(bp, len);
+	if (sym) Init_Word(out, sym);
+	else Set_String(out, str);
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Decode_JSON_Number(REBJSD *jd, REBVAL *out)
+/*
+***********************************************************************/
+{
+	const REBYTE *cp = jd->cp;
+	const REBYTE *end = jd->end;
+	const REBYTE *start = cp;
+	REBFLG is_int = TRUE;
+	REBYTE buf[MAX_NUM_LEN+1];
+	REBCNT len;
+
+	if (cp < end && *cp == '-') cp++;
+	if (cp >= end || !IS_LEX_NUMBER(*cp)) return FALSE;
+	if (*cp++ != '0') {
+		while (cp < end && IS_LEX_NUMBER(*cp)) cp++;
+	}
+	if (cp < end && *cp == '.') {
+		is_int = FALSE;
+		if (++cp >= end || !IS_LEX_NUMBER(*cp)) return FALSE;
+		while (cp < end && IS_LEX_NUMBER(*cp)) cp++;
+	}
+	if (cp < end && (*cp == 'e' || *cp == 'E')) {
+		is_int = FALSE;
+		cp++;
+		if (cp < end && (*cp == '+' || *cp == '-')) cp++;
+		if (cp >= end || !IS_LEX_NUMBER(*cp)) return FALSE;
+		while (cp < end && IS_LEX_NUMBER(*cp)) cp++;
+	}
+	jd->cp = cp;
+
+	// The scanners may look past the number, so it is terminated here:
+	len = (REBCNT)(cp - start);
+	if (len > MAX_NUM_LEN) return FALSE;
+	COPY_MEM(buf, start, len);
+	buf[len] = 0;
+
+	// Integers out of range are loaded as decimals:
+	if (is_int && Scan_Integer(buf, len, out)) return TRUE;
+	return Scan_Decimal(buf, len, out, TRUE) != 0;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Match_JSON_Literal(REBJSD *jd, const char *word, REBCNT len)
+/*
+***********************************************************************/
+{
+	if ((REBCNT)(jd->end - jd->cp) < len || memcmp(jd->cp, word, len)) return FALSE;
+	jd->cp += len;
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Decode_JSON_Array(REBJSD *jd)
+/*
+**		Position is past the [ char. Elements are collected in the emit
+**		buffer and copied into a block, which replaces them.
+**
+***********************************************************************/
+{
+	REBSER *buf = jd->buf;
+	REBCNT begin = SERIES_TAIL(buf);
+	REBSER *blk;
+
+	Skip_JSON_Space(jd);
+	if (jd->cp < jd->end && *jd->cp == ']') jd->cp++;
+	else {
+		for (;;) {
+			if (!Decode_JSON_Value(jd)) return FALSE;
+			if (jd->cp >= jd->end) return FALSE;
+			if (*jd->cp == ']') {jd->cp++; break;}
+			if (*jd->cp++ != ',') return FALSE;
+		}
+	}
+	blk = Copy_Values(BLK_SKIP(buf, begin), SERIES_TAIL(buf) - begin);
+	SERIES_TAIL(buf) = begin;
+	Set_Block(Append_Value(buf), blk);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Decode_JSON_Object(REBJSD *jd)
+/*
+**		Position is past the { char. Keys and values are collected in
+**		the emit buffer and the map is made from them.
+**
+***********************************************************************/
+{
+	REBSER *buf = jd->buf;
+	REBCNT begin = SERIES_TAIL(buf);
+	REBSER *str;
+	REBSER *map;
+
+	Skip_JSON_Space(jd);
+	if (jd->cp < jd->end && *jd->cp == '}') jd->cp++;
+	else {
+		for (;;) {
+			Skip_JSON_Space(jd);
+			if (jd->cp >= jd->end || *jd->cp++ != '"') return FALSE;
+			if (!(str = Decode_JSON_String(jd))) return FALSE;
+			Set_JSON_Key(Append_Value(buf), str);
+			Skip_JSON_Space(jd);
+			if (jd->cp >= jd->end || *jd->cp++ != ':') return FALSE;
+			if (!Decode_JSON_Value(jd)) return FALSE;
+			if (jd->cp >= jd->end) return FALSE;
+			if (*jd->cp == '}') {jd->cp++; break;}
+			if (*jd->cp++ != ',') return FALSE;
+		}
+	}
+	map = Copy_Values_As_Map(BLK_SKIP(buf, begin), SERIES_TAIL(buf) - begin);
+	SERIES_TAIL(buf) = begin;
+	Set_Series(REB_MAP, Append_Value(buf), map);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Decode_JSON_Value(REBJSD *jd)
+/*
+**		Appends one value (with surrounding spaces) to the emit buffer.
+**		Returns FALSE on invalid input.
+**
+***********************************************************************/
+{
+	REBVAL *val;
+	REBSER *str;
+
+	CHECK_STACK(&val);
+
+	Skip_JSON_Space(jd);
+	if (jd->cp >= jd->end) return FALSE;
+
+	switch (*jd->cp) {
+	case '{':
+		jd->cp++;
+		if (!Decode_JSON_Object(jd)) return FALSE;
+		break;
+	case '[':
+		jd->cp++;
+		if (!Decode_JSON_Array(jd)) return FALSE;
+		break;
+	case '"':
+		jd->cp++;
+		if (!(str = Decode_JSON_String(jd))) return FALSE;
+		Set_String(Append_Value(jd->buf), str);
+		break;
+	case 't':
+		if (!Match_JSON_Literal(jd, "true", 4)) return FALSE;
+		SET_TRUE(Append_Value(jd->buf));
+		break;
+	case 'f':
+		if (!Match_JSON_Literal(jd, "false", 5)) return FALSE;
+		SET_FALSE(Append_Value(jd->buf));
+		break;
+	case 'n':
+		if (!Match_JSON_Literal(jd, "null", 4)) return FALSE;
+		SET_NONE(Append_Value(jd->buf));
+		break;
+	default:
+		val = Append_Value(jd->buf);
+		if (!Decode_JSON_Number(jd, val)) return FALSE;
+	}
+	Skip_JSON_Space(jd);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON_Hex(REBSER *ser, REBCNT c)
+/*
+***********************************************************************/
+{
+	REBYTE buf[6];
+	REBINT i;
+
+	buf[0] = '\\';
+	buf[1] = 'u';
+	for (i = 5; i > 1; i--, c >>= 4) buf[i] = Hex_Digits[c & 15];
+	Append_Bytes_Len(ser, buf, 6);
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON_String(REBJSE *je, const REBYTE *bp, REBCNT len)
+/*
+**		Emits quoted and escaped UTF-8 text. Runs of chars that need
+**		no escaping are appended at once.
+**
+***********************************************************************/
+{
+	REBSER *ser = je->mo->series;
+	const REBYTE *end = bp + len;
+	const REBYTE *run;
+	REBCNT c;
+
+	Append_Byte(ser, '"');
+	while (bp < end) {
+		run = bp;
+		while (bp < end && *bp >= 0x20 && *bp != '"' && *bp != '\\' && (*bp < 0x80 || !je->ascii)) bp++;
+		if (bp > run) Append_Bytes_Len(ser, run, (REBCNT)(bp - run));
+		if (bp >= end) break;
+		switch (c = *bp++) {
+		case '"':  Append_Bytes(ser, "\\\""); break;
+		case '\\': Append_Bytes(ser, "\\\\"); break;
+		case '\b': Append_Bytes(ser, "\\b");  break;
+		case '\f': Append_Bytes(ser, "\\f");  break;
+		case '\n': Append_Bytes(ser, "\\n");  break;
+		case '\r': Append_Bytes(ser, "\\r");  break;
+		case '\t': Append_Bytes(ser, "\\t");  break;
+		default:
+			if (c >= 0x80) {
+				// Only in the ASCII mode:
+				bp--;
+				len = UTF8_Next_Char_Size(bp, 0);
+				c = UTF8_Get_Codepoint(bp);
+				bp += len;
+				if (c > 0xFFFF) {
+					c -= 0x10000;
+					Emit_JSON_Hex(ser, 0xD800 + (c >> 10));
+					c = 0xDC00 + (c & 0x3FF);
+				}
+			}
+			Emit_JSON_Hex(ser, c);
+		}
+	}
+	Append_Byte(ser, '"');
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON_Molded(REBJSE *je, REBVAL *value, REBFLG molded)
+/*
+**		Emits a value which has no JSON form as a string.
+**
+***********************************************************************/
+{
+	REBSER *ser = je->mo->series;
+	REBCNT tail = SERIES_TAIL(ser);
+	REBSER *str;
+
+	Mold_Value(je->mo, value, molded);
+	str = Copy_Bytes(BIN_SKIP(ser, tail), SERIES_TAIL(ser) - tail);
+	SERIES_TAIL(ser) = tail;
+	Emit_JSON_String(je, BIN_HEAD(str), SERIES_TAIL(str));
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON_Line(REBJSE *je, REBINT delta)
+/*
+***********************************************************************/
+{
+	REBSER *ser = je->mo->series;
+	REBCNT n;
+
+	je->level += delta;
+	Append_Byte(ser, '\n');
+	for (n = 0; n < je->level; n++) Append_Bytes_Len(ser, je->indent, je->indent_len);
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON_Key(REBJSE *je, REBVAL *key)
+/*
+***********************************************************************/
+{
+	REBYTE *name;
+
+	if (ANY_WORD(key)) {
+		name = Get_Word_Name(key);
+		Emit_JSON_String(je, name, LEN_BYTES(name));
+	}
+	else if (IS_STRING(key)) Emit_JSON_String(je, VAL_BIN_DATA(key), VAL_LEN(key));
+	else Emit_JSON_Molded(je, key, TRUE);
+
+	if (je->indent) Append_Bytes(je->mo->series, ": ");
+	else Append_Byte(je->mo->series, ':');
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_JSON_Value(REBJSE *je, REBVAL *value)
+/*
+***********************************************************************/
+{
+	REBSER *ser = je->mo->series;
+	REBVAL *val;
+	REBVAL *key;
+	REBVAL tmp;
+	REBCNT n;
+	REBCNT count = 0;
+
+	CHECK_STACK(&n);
+
+	switch (VAL_TYPE(value)) {
+	case REB_NONE:
+		Append_Bytes(ser, "null");
+		break;
+	case REB_LOGIC:
+		Append_Bytes(ser, VAL_LOGIC(value) ? "true" : "false");
+		break;
+	case REB_INTEGER:
+	case REB_DECIMAL:
+		Mold_Value(je->mo, value, FALSE);
+		break;
+	case REB_PERCENT:
+		SET_DECIMAL(&tmp, VAL_DECIMAL(value));
+		Mold_Value(je->mo, &tmp, FALSE);
+		break;
+	case REB_STRING:
+		Emit_JSON_String(je, VAL_BIN_DATA(value), VAL_LEN(value));
+		break;
+	case REB_MAP:
+		Append_Byte(ser, '{');
+		for (val = VAL_BLK_DATA(value); NOT_END(val) && NOT_END(val+1); val += 2) {
+			if (VAL_MAP_REMOVED(val)) continue;
+			if (count++) Append_Byte(ser, ',');
+			if (je->indent) Emit_JSON_Line(je, count == 1 ? 1 : 0);
+			Emit_JSON_Key(je, val);
+			Emit_JSON_Value(je, val+1);
+		}
+		if (count && je->indent) Emit_JSON_Line(je, -1);
+		Append_Byte(ser, '}');
+		break;
+	case REB_OBJECT:
+		Append_Byte(ser, '{');
+		key = BLK_HEAD(VAL_OBJ_WORDS(value));
+		val = VAL_OBJ_VALUES(value);
+		for (n = 1; n < SERIES_TAIL(VAL_OBJ_FRAME(value)); n++) {
+			if (VAL_GET_OPT(key+n, OPTS_HIDE)) continue;
+			if (count++) Append_Byte(ser, ',');
+			if (je->indent) Emit_JSON_Line(je, count == 1 ? 1 : 0);
+			Init_Word(&tmp, VAL_WORD_SYM(key+n));
+			Emit_JSON_Key(je, &tmp);
+			Emit_JSON_Value(je, val+n);
+		}
+		if (count && je->indent) Emit_JSON_Line(je, -1);
+		Append_Byte(ser, '}');
+		break;
+	default:
+		if (ANY_BLOCK(value)) {
+			Append_Byte(ser, '[');
+			for (val = VAL_BLK_DATA(value); NOT_END(val); val++) {
+				if (count++) Append_Byte(ser, ',');
+				if (je->indent) Emit_JSON_Line(je, count == 1 ? 1 : 0);
+				Emit_JSON_Value(je, val);
+			}
+			if (count && je->indent) Emit_JSON_Line(je, -1);
+			Append_Byte(ser, ']');
+		}
+		// Other strings are formed, anything else molded:
+		else Emit_JSON_Molded(je, value, !ANY_STR(value));
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Set_JSON_Option(REBJSE *je, REBVAL *val)
+/*
+***********************************************************************/
+{
+	if (IS_STRING(val)) {
+		je->indent = VAL_BIN_DATA(val);
+		je->indent_len = VAL_LEN(val);
+	}
+	else if (IS_WORD(val) && VAL_WORD_CANON(val) == SYM_ASCII)
+		je->ascii = TRUE;
+	else if (!IS_NONE(val))
+		Trap1(RE_INVALID_ARG, val);
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Codec_JSON(REBCDI *codi)
+/*
+***********************************************************************/
+{
+	REBJSD jd;
+	REBJSE je;
+	REB_MOLD mo = {0};
+	REBVAL *opts = (REBVAL *)codi->options;
+	REBCNT begin;
+
+	codi->error = 0;
+
+	if (codi->action == CODI_IDENTIFY) {
+		codi->error = 1;   // never identified (any text could start with [ or {)
+		return CODI_CHECK; // error code is inverted result
+	}
+
+	if (codi->action == CODI_DECODE) {
+		jd.cp  = codi->data;
+		jd.end = codi->data + codi->len;
+		// Skip UTF-8 BOM (files saved by some editors):
+		if (codi->len >= 3 && jd.cp[0] == 0xEF && jd.cp[1] == 0xBB && jd.cp[2] == 0xBF) jd.cp += 3;
+		jd.buf = BUF_EMIT;
+		begin = SERIES_TAIL(jd.buf);
+		if (!Decode_JSON_Value(&jd) || jd.cp != jd.end) {
+			SERIES_TAIL(jd.buf) = begin;
+			codi->error = CODI_ERR_BAD_DATA;
+			return CODI_ERROR;
+		}
+		// The value stays in the buffer until it is copied by DO-CODEC:
+		codi->other = BLK_SKIP(jd.buf, begin);
+		SERIES_TAIL(jd.buf) = begin;
+		return CODI_VALUE;
+	}
+
+	if (codi->action == CODI_ENCODE_VALUE) {
+		CLEAR(&je, sizeof(je));
+		if (opts && IS_BLOCK(opts)) {
+			for (opts = VAL_BLK_DATA(opts); NOT_END(opts); opts++) Set_JSON_Option(&je, opts);
+		}
+		else if (opts) Set_JSON_Option(&je, opts);
+		Reset_Mold(&mo);
+		je.mo = &mo;
+		Emit_JSON_Value(&je, (REBVAL *)codi->other);
+		codi->other = Copy_Str(BIN_HEAD(mo.series), SERIES_TAIL(mo.series));
+		return CODI_STRING;
+	}
+
+	codi->error = CODI_ERR_NA;
+	return CODI_ERROR;
+}
+
+
+/***********************************************************************
+**
+*/	void Init_JSON_Codec(void)
+/*
+***********************************************************************/
+{
+	Register_Codec("json", Codec_JSON);
+}
+
+#endif //INCLUDE_JSON_CODEC
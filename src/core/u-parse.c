@@ -870,7 +870,7 @@ bad_target:
 
 		//Print_Parse_Index(parse->type, rules, series, index);
 
-		if (--Eval_Count <= 0 || Eval_Signals) Do_Signals();
+		if (--Eval_Count <= 0 || ANY_SIGNALS) Do_Signals();
 
 		//--------------------------------------------------------------------
 		// Pre-Rule Processing Section
@@ -1480,7 +1480,7 @@ do_modify:
 
 	}
 	
-	if (--Eval_Count <= 0 || Eval_Signals) Do_Signals();
+	if (--Eval_Count <= 0 || ANY_SIGNALS) Do_Signals();
 
 	return index;
 
@@ -1530,7 +1530,7 @@ bad_end:
 
 	while (index < tail) {
 
-		if (--Eval_Count <= 0 || Eval_Signals) Do_Signals();
+		if (--Eval_Count <= 0 || ANY_SIGNALS) Do_Signals();
 
 		// Skip whitespace if not /all refinement: 
 		if (skip_spaces) {
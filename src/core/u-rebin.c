@@ -0,0 +1,960 @@
+/***********************************************************************
+**
+**  REBOL [R3] Language Interpreter and Run-time Environment
+**
+**  Copyright 2012-2025 Rebol Open Source Contributors
+**  REBOL is a trademark of REBOL Technologies
+**
+**  Licensed under the Apache License, Version 2.0 (the "License");
+**  you may not use this file except in compliance with the License.
+**  You may obtain a copy of the License at
+**
+**  http://www.apache.org/licenses/LICENSE-2.0
+**
+**  Unless required by applicable law or agreed to in writing, software
+**  distributed under the License is distributed on an "AS IS" BASIS,
+**  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**  See the License for the specific language governing permissions and
+**  limitations under the License.
+**
+************************************************************************
+**
+**  Module:  u-rebin.c
+**  Summary: REBIN codec (binary Rebol values)
+**  Section: utility
+**  Author:  Oldes
+**  Notes:
+**    Compact binary serialization of Rebol values, which is decoded in
+**    one linear pass without any text scanning.
+**
+**    Format (all numbers are LEB128 varints, unless noted):
+**      "RBIN" version(byte)
+**      count of symbols, then each: length and UTF-8 name
+**      value
+**
+**    Each value starts with a tag byte (bit 7 is the new-line marker).
+**    Words are stored as indexes into the symbol table (not bound on
+**    decode). Series values are stored with their index and a ref:
+**    zero is followed by the series data (length prefixed), any other
+**    number is a reference to an already stored series (ref - 1), so
+**    shared series and cycles are kept. Objects and maps use the same
+**    refs. Vectors and images are stored as raw bytes (little-endian
+**    machines assumed, like in the rest of the code).
+**
+***********************************************************************
+**  Base-code:
+
+	if find system/codecs 'rebin [
+		system/codecs/rebin/title: "Binary Rebol values"
+		system/codecs/rebin/type: 'binary
+		system/codecs/rebin/suffixes: [%.rebin]
+		append append system/catalog/file-types system/codecs/rebin/suffixes 'rebin
+	]
+
+***********************************************************************/
+
+#include "sys-core.h"
+
+#ifdef INCLUDE_REBIN_CODEC
+
+#define REBIN_VERSION 1
+
+// Value tags (stable, not depending on the order of datatypes):
+enum {
+	RBT_UNSET = 1,
+	RBT_NONE,
+	RBT_FALSE,
+	RBT_TRUE,
+	RBT_INTEGER,
+	RBT_DECIMAL,
+	RBT_PERCENT,
+	RBT_MONEY,
+	RBT_CHAR,
+	RBT_PAIR,
+	RBT_TUPLE,
+	RBT_TIME,
+	RBT_DATE,
+	RBT_DATATYPE,
+	RBT_TYPESET,
+	RBT_BINARY,
+	RBT_STRING,		// any-string in the order of datatypes
+	RBT_FILE,
+	RBT_EMAIL,
+	RBT_REF,
+	RBT_URL,
+	RBT_TAG,
+	RBT_BITSET,
+	RBT_IMAGE,
+	RBT_VECTOR,
+	RBT_BLOCK,		// any-block in the order of datatypes
+	RBT_PAREN,
+	RBT_PATH,
+	RBT_SET_PATH,
+	RBT_GET_PATH,
+	RBT_LIT_PATH,
+	RBT_HASH,
+	RBT_MAP,
+	RBT_WORD,		// any-word in the order of datatypes
+	RBT_SET_WORD,
+	RBT_GET_WORD,
+	RBT_LIT_WORD,
+	RBT_REFINEMENT,
+	RBT_ISSUE,
+	RBT_OBJECT,
+	RBT_MAX
+};
+
+#define RBT_LINE 0x80
+
+// Vector's encoding identifier (VTSI08...) from its info:
+#define VECT_TYPE_ID(info) ((info) & 0x0F)
+
+typedef struct Reb_Rebin_Ref {
+	REBSER *series;
+	REBCNT  ref;		// ref number + 1 (zero is a free slot)
+} REBRBR;
+
+typedef struct Reb_Rebin_Encoder {
+	REBSER *out;		// encoded values
+	REBSER *names;		// encoded symbol table
+	REBSER *syms;		// word table symbol -> local symbol index + 1
+	REBCNT  sym_count;
+	REBSER *refs;		// hash of already stored series (REBRBR slots)
+	REBCNT  ref_count;
+} REBRBE;
+
+typedef struct Reb_Rebin_Decoder {
+	const REBYTE *cp;
+	const REBYTE *end;
+	REBSER *syms;		// local symbol index -> word table symbol
+	REBSER *refs;		// decoded series in the order of refs (REBRBF)
+} REBRBD;
+
+typedef struct Reb_Rebin_Decoded_Ref {
+	REBSER *series;
+	REBCNT  kind;		// RBT_* tag of the first value (one per group of types)
+} REBRBF;
+
+#define BAD_REBIN() Trap0(RE_BAD_MEDIA)
+
+static void Encode_Rebin_Value(REBRBE *re, REBVAL *val);
+static void Decode_Rebin_Value(REBRBD *rd, REBVAL *out);
+
+
+/***********************************************************************
+**
+**	Encoder
+**
+***********************************************************************/
+
+/***********************************************************************
+**
+*/	static void Emit_Rebin_Byte(REBSER *ser, REBYTE b)
+/*
+***********************************************************************/
+{
+	EXPAND_SERIES_TAIL(ser, 1);
+	BIN_HEAD(ser)[SERIES_TAIL(ser) - 1] = b;
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_Rebin_Varint(REBSER *ser, REBU64 n)
+/*
+***********************************************************************/
+{
+	REBYTE buf[10];
+	REBCNT len = 0;
+
+	while (n >= 0x80) {
+		buf[len++] = (REBYTE)(n | 0x80);
+		n >>= 7;
+	}
+	buf[len++] = (REBYTE)n;
+	Append_Series(ser, buf, len);
+}
+
+#define Emit_Rebin_Signed(s, n) Emit_Rebin_Varint(s, ((REBU64)(n) << 1) ^ (REBU64)((REBI64)(n) >> 63))
+
+
+/***********************************************************************
+**
+*/	static void Emit_Rebin_U32(REBSER *ser, REBCNT n)
+/*
+***********************************************************************/
+{
+	REBYTE buf[4];
+
+	buf[0] = (REBYTE)n;
+	buf[1] = (REBYTE)(n >> 8);
+	buf[2] = (REBYTE)(n >> 16);
+	buf[3] = (REBYTE)(n >> 24);
+	Append_Series(ser, buf, 4);
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_Rebin_U64(REBSER *ser, REBU64 n)
+/*
+***********************************************************************/
+{
+	Emit_Rebin_U32(ser, (REBCNT)n);
+	Emit_Rebin_U32(ser, (REBCNT)(n >> 32));
+}
+
+
+/***********************************************************************
+**
+*/	static void Emit_Rebin_Symbol(REBRBE *re, REBCNT sym)
+/*
+**		Symbols are added to the table when used first time.
+**
+***********************************************************************/
+{
+	REBCNT *idx = (REBCNT *)SERIES_DATA(re->syms);
+	REBYTE *name;
+	REBCNT len;
+
+	if (sym >= SERIES_TAIL(re->syms)) BAD_REBIN(); // word made while encoding?
+	if (!idx[sym]) {
+		idx[sym] = ++re->sym_count;
+		name = Get_Sym_Name(sym);
+		len = (REBCNT)LEN_BYTES(name);
+		Emit_Rebin_Varint(re->names, len);
+		Append_Series(re->names, name, len);
+	}
+	Emit_Rebin_Varint(re->out, idx[sym] - 1);
+}
+
+
+/***********************************************************************
+**
+*/	static void Rehash_Rebin_Refs(REBRBE *re)
+/*
+***********************************************************************/
+{
+	REBSER *old = re->refs;
+	REBRBR *slot = (REBRBR *)SERIES_DATA(old);
+	REBRBR *slots;
+	REBCNT size = SERIES_TAIL(old) * 2;
+	REBCNT n, h;
+
+	re->refs = Make_Series(size + 1, sizeof(REBRBR), FALSE);
+	CLEAR(SERIES_DATA(re->refs), size * sizeof(REBRBR));
+	SERIES_TAIL(re->refs) = size;
+	slots = (REBRBR *)SERIES_DATA(re->refs);
+
+	for (n = 0; n < SERIES_TAIL(old); n++, slot++) {
+		if (!slot->ref) continue;
+		for (h = (REBCNT)((REBUPT)slot->series >> 4) & (size - 1); slots[h].ref; h = (h + 1) & (size - 1));
+		slots[h] = *slot;
+	}
+	Free_Series(old);
+}
+
+
+/***********************************************************************
+**
+*/	static REBFLG Emit_Rebin_Ref(REBRBE *re, REBSER *series)
+/*
+**		Emits ref of already stored series and returns TRUE, or
+**		registers the series, emits zero and returns FALSE.
+**
+***********************************************************************/
+{
+	REBRBR *slots = (REBRBR *)SERIES_DATA(re->refs);
+	REBCNT size = SERIES_TAIL(re->refs); // power of 2
+	REBCNT h;
+
+	for (h = (REBCNT)((REBUPT)series >> 4) & (size - 1); slots[h].ref; h = (h + 1) & (size - 1)) {
+		if (slots[h].series == series) {
+			Emit_Rebin_Varint(re->out, slots[h].ref);
+			return TRUE;
+		}
+	}
+	slots[h].series = series;
+	slots[h].ref = ++re->ref_count;
+	if (re->ref_count * 2 > size) Rehash_Rebin_Refs(re);
+
+	Emit_Rebin_Byte(re->out, 0);
+	return FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	static void Encode_Rebin_Value(REBRBE *re, REBVAL *val)
+/*
+***********************************************************************/
+{
+	REBSER *out = re->out;
+	REBSER *ser;
+	REBCNT type = VAL_TYPE(val);
+	REBCNT tag = 0;
+	REBCNT n, len;
+	REBVAL *v;
+	union {REBDEC d; REBU64 u; float f; REBCNT c;} num;
+
+	CHECK_STACK(&n);
+
+	if (ANY_STR(val) || IS_BINARY(val)) tag = RBT_BINARY + (type - REB_BINARY);
+	else if (ANY_BLOCK(val)) tag = RBT_BLOCK + (type - REB_BLOCK); // including hash
+	else if (ANY_WORD(val)) tag = RBT_WORD + (type - REB_WORD);
+	else switch (type) {
+	case REB_UNSET:    tag = RBT_UNSET;    break;
+	case REB_NONE:     tag = RBT_NONE;     break;
+	case REB_LOGIC:    tag = VAL_LOGIC(val) ? RBT_TRUE : RBT_FALSE; break;
+	case REB_INTEGER:  tag = RBT_INTEGER;  break;
+	case REB_DECIMAL:  tag = RBT_DECIMAL;  break;
+	case REB_PERCENT:  tag = RBT_PERCENT;  break;
+	case REB_MONEY:    tag = RBT_MONEY;    break;
+	case REB_CHAR:     tag = RBT_CHAR;     break;
+	case REB_PAIR:     tag = RBT_PAIR;     break;
+	case REB_TUPLE:    tag = RBT_TUPLE;    break;
+	case REB_TIME:     tag = RBT_TIME;     break;
+	case REB_DATE:     tag = RBT_DATE;     break;
+	case REB_DATATYPE: tag = RBT_DATATYPE; break;
+	case REB_TYPESET:  tag = RBT_TYPESET;  break;
+	case REB_BITSET:   tag = RBT_BITSET;   break;
+	case REB_IMAGE:    tag = RBT_IMAGE;    break;
+	case REB_VECTOR:   tag = RBT_VECTOR;   break;
+	case REB_MAP:      tag = RBT_MAP;      break;
+	case REB_OBJECT:   tag = RBT_OBJECT;   break;
+	default:
+		Trap1(RE_INVALID_ARG, val); // functions, ports, handles...
+	}
+	Emit_Rebin_Byte(out, (REBYTE)(tag | (VAL_GET_LINE(val) ? RBT_LINE : 0)));
+
+	switch (tag) {
+	case RBT_INTEGER:
+		Emit_Rebin_Signed(out, VAL_INT64(val));
+		break;
+	case RBT_DECIMAL:
+	case RBT_PERCENT:
+		num.d = VAL_DECIMAL(val);
+		Emit_Rebin_U64(out, num.u);
+		break;
+	case RBT_MONEY:
+		Emit_Rebin_U32(out, VAL_DECI(val).m0);
+		Emit_Rebin_U32(out, VAL_DECI(val).m1);
+		Emit_Rebin_U32(out, VAL_DECI(val).m2 | (VAL_DECI(val).s << 23) | ((REBCNT)(VAL_DECI(val).e & 0xff) << 24));
+		break;
+	case RBT_CHAR:
+		Emit_Rebin_Varint(out, VAL_CHAR(val));
+		break;
+	case RBT_PAIR:
+		num.f = VAL_PAIR_X(val);
+		Emit_Rebin_U32(out, num.c);
+		num.f = VAL_PAIR_Y(val);
+		Emit_Rebin_U32(out, num.c);
+		break;
+	case RBT_TUPLE:
+		Emit_Rebin_Byte(out, (REBYTE)VAL_TUPLE_LEN(val));
+		Append_Series(out, VAL_TUPLE(val), VAL_TUPLE_LEN(val));
+		break;
+	case RBT_TIME:
+		Emit_Rebin_Signed(out, VAL_TIME(val));
+		break;
+	case RBT_DATE:
+		Emit_Rebin_Varint(out, VAL_YEAR(val));
+		Emit_Rebin_Byte(out, (REBYTE)VAL_MONTH(val));
+		Emit_Rebin_Byte(out, (REBYTE)VAL_DAY(val));
+		Emit_Rebin_Byte(out, (REBYTE)VAL_ZONE(val));
+		Emit_Rebin_Signed(out, VAL_TIME(val));
+		break;
+	case RBT_DATATYPE:
+		Emit_Rebin_Symbol(re, Get_Type_Sym(VAL_DATATYPE(val)));
+		break;
+	case RBT_TYPESET:
+		Emit_Rebin_U64(out, VAL_TYPESET(val));
+		break;
+
+	case RBT_BINARY:
+	case RBT_STRING:
+	case RBT_FILE:
+	case RBT_EMAIL:
+	case RBT_REF:
+	case RBT_URL:
+	case RBT_TAG:
+		ser = VAL_SERIES(val);
+		if (!BYTE_SIZE(ser)) Trap1(RE_INVALID_ARG, val);
+		// An index past the tail (series was cleared) is stored as the tail:
+		Emit_Rebin_Varint(out, MIN(VAL_INDEX(val), SERIES_TAIL(ser)));
+		if (Emit_Rebin_Ref(re, ser)) break;
+		// Length with the UTF-8 flag, so it is not checked again on decode:
+		Emit_Rebin_Varint(out, ((REBU64)SERIES_TAIL(ser) << 1) | (IS_UTF8_SERIES(ser) ? 1 : 0));
+		Append_Series(out, BIN_HEAD(ser), SERIES_TAIL(ser));
+		break;
+
+	case RBT_BITSET:
+		ser = VAL_SERIES(val);
+		if (Emit_Rebin_Ref(re, ser)) break;
+		Emit_Rebin_Varint(out, ((REBU64)SERIES_TAIL(ser) << 1) | (BITS_NOT(ser) ? 1 : 0));
+		Append_Series(out, BIN_HEAD(ser), SERIES_TAIL(ser));
+		break;
+
+	case RBT_IMAGE:
+		ser = VAL_SERIES(val);
+		Emit_Rebin_Varint(out, MIN(VAL_INDEX(val), SERIES_TAIL(ser)));
+		if (Emit_Rebin_Ref(re, ser)) break;
+		Emit_Rebin_Varint(out, IMG_WIDE(ser));
+		Emit_Rebin_Varint(out, IMG_HIGH(ser));
+		Append_Series(out, IMG_DATA(ser), IMG_WIDE(ser) * IMG_HIGH(ser) * 4);
+		break;
+
+	case RBT_VECTOR:
+		ser = VAL_SERIES(val);
+		Emit_Rebin_Varint(out, MIN(VAL_INDEX(val), SERIES_TAIL(ser)));
+		if (Emit_Rebin_Ref(re, ser)) break;
+		Emit_Rebin_Varint(out, ser->size); // dims, type, sign and bits
+		Emit_Rebin_Varint(out, SERIES_TAIL(ser));
+		Append_Series(out, SERIES_DATA(ser), Series_Byte_Len(ser, SERIES_TAIL(ser)));
+		break;
+
+	case RBT_BLOCK:
+	case RBT_PAREN:
+	case RBT_PATH:
+	case RBT_SET_PATH:
+	case RBT_GET_PATH:
+	case RBT_LIT_PATH:
+	case RBT_HASH:
+		ser = VAL_SERIES(val);
+		Emit_Rebin_Varint(out, MIN(VAL_INDEX(val), SERIES_TAIL(ser)));
+		if (Emit_Rebin_Ref(re, ser)) break;
+		Emit_Rebin_Varint(out, SERIES_TAIL(ser));
+		for (n = 0; n < SERIES_TAIL(ser); n++) Encode_Rebin_Value(re, BLK_SKIP(ser, n));
+		break;
+
+	case RBT_MAP:
+		ser = VAL_SERIES(val);
+		if (Emit_Rebin_Ref(re, ser)) break;
+		len = 0;
+		for (v = BLK_HEAD(ser); NOT_END(v) && NOT_END(v+1); v += 2) {
+			if (!VAL_MAP_REMOVED(v)) len++;
+		}
+		Emit_Rebin_Varint(out, len);
+		for (n = 0; n + 1 < SERIES_TAIL(ser); n += 2) {
+			v = BLK_SKIP(ser, n);
+			if (VAL_MAP_REMOVED(v)) continue;
+			Encode_Rebin_Value(re, v);
+			Encode_Rebin_Value(re, BLK_SKIP(ser, n + 1));
+		}
+		break;
+
+	case RBT_OBJECT:
+		ser = VAL_OBJ_FRAME(val);
+		if (Emit_Rebin_Ref(re, ser)) break;
+		Emit_Rebin_Varint(out, SERIES_TAIL(ser) - 1);
+		for (n = 1; n < SERIES_TAIL(ser); n++) {
+			Emit_Rebin_Symbol(re, FRM_WORD_SYM(ser, n));
+			Encode_Rebin_Value(re, FRM_VALUE(ser, n));
+		}
+		break;
+
+	default:
+		if (tag >= RBT_WORD && tag <= RBT_ISSUE) Emit_Rebin_Symbol(re, VAL_WORD_SYM(val));
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Encode_Rebin(REBVAL *val)
+/*
+***********************************************************************/
+{
+	REBRBE re;
+	REBSER *ser;
+	REBCNT words = SERIES_TAIL(PG_Word_Table.series);
+
+	CLEAR(&re, sizeof(re));
+	re.out   = Make_Binary(4000);
+	re.names = Make_Binary(1000);
+	re.syms  = Make_Series(words + 1, sizeof(REBCNT), FALSE);
+	CLEAR(SERIES_DATA(re.syms), words * sizeof(REBCNT));
+	SERIES_TAIL(re.syms) = words;
+	re.refs  = Make_Series(64 + 1, sizeof(REBRBR), FALSE);
+	CLEAR(SERIES_DATA(re.refs), 64 * sizeof(REBRBR));
+	SERIES_TAIL(re.refs) = 64;
+
+	Encode_Rebin_Value(&re, val);
+
+	ser = Make_Binary(SERIES_TAIL(re.names) + SERIES_TAIL(re.out) + 15);
+	Append_Series(ser, cb_cast("RBIN"), 4);
+	Emit_Rebin_Byte(ser, REBIN_VERSION);
+	Emit_Rebin_Varint(ser, re.sym_count);
+	Append_Series(ser, BIN_HEAD(re.names), SERIES_TAIL(re.names));
+	Append_Series(ser, BIN_HEAD(re.out), SERIES_TAIL(re.out));
+
+	Free_Series(re.out);
+	Free_Series(re.names);
+	Free_Series(re.syms);
+	Free_Series(re.refs);
+	return ser;
+}
+
+
+/***********************************************************************
+**
+**	Decoder
+**
+***********************************************************************/
+
+/***********************************************************************
+**
+*/	static REBU64 Read_Rebin_Varint(REBRBD *rd)
+/*
+***********************************************************************/
+{
+	const REBYTE *cp = rd->cp;
+	REBU64 n = 0;
+	REBCNT shift = 0;
+
+	do {
+		if (cp >= rd->end || shift > 63) BAD_REBIN();
+		n |= (REBU64)(*cp & 0x7F) << shift;
+		shift += 7;
+	} while (*cp++ & 0x80);
+
+	rd->cp = cp;
+	return n;
+}
+
+#define Read_Rebin_Signed(rd, n) (n = Read_Rebin_Varint(rd), (REBI64)((n) >> 1) ^ -(REBI64)((n) & 1))
+
+
+/***********************************************************************
+**
+*/	static REBCNT Read_Rebin_Length(REBRBD *rd, REBCNT unit)
+/*
+**		Reads length of data which must fit in the rest of input.
+**
+***********************************************************************/
+{
+	REBU64 len = Read_Rebin_Varint(rd);
+	if (unit && len > (REBU64)(rd->end - rd->cp) / unit) BAD_REBIN();
+	return (REBCNT)len;
+}
+
+
+/***********************************************************************
+**
+*/	static const REBYTE *Read_Rebin_Bytes(REBRBD *rd, REBCNT len)
+/*
+***********************************************************************/
+{
+	const REBYTE *cp = rd->cp;
+	if (len > (REBCNT)(rd->end - cp)) BAD_REBIN();
+	rd->cp += len;
+	return cp;
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Read_Rebin_U32(REBRBD *rd)
+/*
+***********************************************************************/
+{
+	const REBYTE *cp = Read_Rebin_Bytes(rd, 4);
+	return cp[0] | (cp[1] << 8) | (cp[2] << 16) | ((REBCNT)cp[3] << 24);
+}
+
+
+/***********************************************************************
+**
+*/	static REBU64 Read_Rebin_U64(REBRBD *rd)
+/*
+***********************************************************************/
+{
+	REBU64 n = Read_Rebin_U32(rd);
+	return n | ((REBU64)Read_Rebin_U32(rd) << 32);
+}
+
+
+/***********************************************************************
+**
+*/	static REBCNT Read_Rebin_Symbol(REBRBD *rd)
+/*
+***********************************************************************/
+{
+	REBU64 n = Read_Rebin_Varint(rd);
+	if (n >= SERIES_TAIL(rd->syms)) BAD_REBIN();
+	return ((REBCNT *)SERIES_DATA(rd->syms))[n];
+}
+
+
+/***********************************************************************
+**
+*/	static REBSER *Read_Rebin_Ref(REBRBD *rd, REBCNT kind)
+/*
+**		Returns already decoded series or NULL, when it follows.
+**		The series must be of the same kind as the referring value,
+**		else the data are invalid (and may be a malicious input).
+**
+***********************************************************************/
+{
+	REBU64 ref = Read_Rebin_Varint(rd);
+	REBRBF *slot;
+
+	if (ref == 0) return NULL;
+	if (ref > SERIES_TAIL(rd->refs)) BAD_REBIN();
+	slot = (REBRBF *)SERIES_DATA(rd->refs) + (ref - 1);
+	if (slot->kind != kind) BAD_REBIN();
+	return slot->series;
+}
+
+
+/***********************************************************************
+**
+*/	static void Add_Rebin_Ref(REBRBD *rd, REBSER *series, REBCNT kind)
+/*
+***********************************************************************/
+{
+	REBRBF *slot;
+
+	EXPAND_SERIES_TAIL(rd->refs, 1);
+	slot = (REBRBF *)SERIES_DATA(rd->refs) + (SERIES_TAIL(rd->refs) - 1);
+	slot->series = series;
+	slot->kind = kind;
+}
+
+
+/***********************************************************************
+**
+*/	static void Decode_Rebin_Value(REBRBD *rd, REBVAL *out)
+/*
+**		Series are registered before their content is decoded, so the
+**		content may refer to them.
+**
+***********************************************************************/
+{
+	REBSER *ser;
+	REBCNT tag, type, n, len, w, h;
+	REBU64 u;
+	const REBYTE *bp;
+	REBVAL key, val;
+	union {REBDEC d; REBU64 u; float f; REBCNT c;} num;
+
+	CHECK_STACK(&n);
+
+	bp = Read_Rebin_Bytes(rd, 1);
+	tag = *bp & ~RBT_LINE;
+
+	CLEARS(out);
+
+	switch (tag) {
+	case RBT_UNSET:
+		SET_UNSET(out);
+		break;
+	case RBT_NONE:
+		SET_NONE(out);
+		break;
+	case RBT_FALSE:
+	case RBT_TRUE:
+		SET_LOGIC(out, tag == RBT_TRUE);
+		break;
+	case RBT_INTEGER:
+		SET_INTEGER(out, Read_Rebin_Signed(rd, u));
+		break;
+	case RBT_DECIMAL:
+	case RBT_PERCENT:
+		num.u = Read_Rebin_U64(rd);
+		VAL_SET(out, tag == RBT_DECIMAL ? REB_DECIMAL : REB_PERCENT);
+		VAL_DECIMAL(out) = num.d;
+		break;
+	case RBT_MONEY:
+		VAL_SET(out, REB_MONEY);
+		VAL_DECI(out).m0 = Read_Rebin_U32(rd);
+		VAL_DECI(out).m1 = Read_Rebin_U32(rd);
+		n = Read_Rebin_U32(rd);
+		VAL_DECI(out).m2 = n & 0x7FFFFF;
+		VAL_DECI(out).s = (n >> 23) & 1;
+		VAL_DECI(out).e = (signed char)(n >> 24);
+		break;
+	case RBT_CHAR:
+		u = Read_Rebin_Varint(rd);
+		if (u > MAX_CHAR) BAD_REBIN();
+		SET_CHAR(out, (REBCNT)u);
+		break;
+	case RBT_PAIR:
+		VAL_SET(out, REB_PAIR);
+		num.c = Read_Rebin_U32(rd);
+		VAL_PAIR_X(out) = num.f;
+		num.c = Read_Rebin_U32(rd);
+		VAL_PAIR_Y(out) = num.f;
+		break;
+	case RBT_TUPLE:
+		len = *Read_Rebin_Bytes(rd, 1);
+		if (len > MAX_TUPLE) BAD_REBIN();
+		VAL_SET(out, REB_TUPLE);
+		VAL_TUPLE_LEN(out) = len;
+		COPY_MEM(VAL_TUPLE(out), Read_Rebin_Bytes(rd, len), len);
+		break;
+	case RBT_TIME:
+		VAL_SET(out, REB_TIME);
+		VAL_TIME(out) = Read_Rebin_Signed(rd, u);
+		break;
+	case RBT_DATE:
+		VAL_SET(out, REB_DATE);
+		u = Read_Rebin_Varint(rd);
+		bp = Read_Rebin_Bytes(rd, 3);
+		// date code indexes tables by month, so all fields are checked:
+		if (u > MAX_YEAR || bp[0] < 1 || bp[0] > 12 || bp[1] < 1
+			|| bp[1] > Month_Lengths[bp[0] - 1]
+			|| (signed char)bp[2] < -MAX_ZONE || (signed char)bp[2] > MAX_ZONE
+		) BAD_REBIN();
+		VAL_YEAR(out)  = (REBCNT)u;
+		VAL_MONTH(out) = bp[0];
+		VAL_DAY(out)   = bp[1];
+		VAL_ZONE(out)  = (signed char)bp[2];
+		VAL_TIME(out)  = Read_Rebin_Signed(rd, u);
+		if (VAL_TIME(out) != NO_TIME && (VAL_TIME(out) < 0 || VAL_TIME(out) >= TIME_IN_DAY))
+			BAD_REBIN();
+		break;
+	case RBT_DATATYPE:
+		type = SYMBOL_TO_CANON(Read_Rebin_Symbol(rd));
+		if (type == 0 || type > REB_MAX) BAD_REBIN();
+		*out = *Get_Type(type - 1);
+		break;
+	case RBT_TYPESET:
+		VAL_SET(out, REB_TYPESET);
+		VAL_TYPESET(out) = Read_Rebin_U64(rd);
+		break;
+
+	case RBT_BINARY:
+	case RBT_STRING:
+	case RBT_FILE:
+	case RBT_EMAIL:
+	case RBT_REF:
+	case RBT_URL:
+	case RBT_TAG:
+		n = (REBCNT)Read_Rebin_Varint(rd);
+		if (!(ser = Read_Rebin_Ref(rd, RBT_BINARY))) {
+			u = Read_Rebin_Varint(rd);
+			if ((u >> 1) > (REBU64)(rd->end - rd->cp)) BAD_REBIN();
+			len = (REBCNT)(u >> 1);
+			ser = Make_Binary(len);
+			COPY_MEM(BIN_HEAD(ser), Read_Rebin_Bytes(rd, len), len);
+			SERIES_TAIL(ser) = len;
+			TERM_SERIES(ser);
+			if (u & 1) UTF8_SERIES(ser);
+			Add_Rebin_Ref(rd, ser, RBT_BINARY);
+		}
+		if (n > SERIES_TAIL(ser)) BAD_REBIN();
+		SET_STR_TYPE(REB_BINARY + (tag - RBT_BINARY), out, ser);
+		VAL_INDEX(out) = n;
+		break;
+
+	case RBT_BITSET:
+		if (!(ser = Read_Rebin_Ref(rd, RBT_BITSET))) {
+			u = Read_Rebin_Varint(rd);
+			if ((u >> 1) > (REBU64)(rd->end - rd->cp)) BAD_REBIN();
+			len = (REBCNT)(u >> 1);
+			ser = Make_Bitset(len * 8);
+			COPY_MEM(BIN_HEAD(ser), Read_Rebin_Bytes(rd, len), len);
+			BITS_NOT(ser) = (REBCNT)(u & 1);
+			Add_Rebin_Ref(rd, ser, RBT_BITSET);
+		}
+		VAL_SET(out, REB_BITSET);
+		VAL_SERIES(out) = ser;
+		break;
+
+	case RBT_IMAGE:
+		n = (REBCNT)Read_Rebin_Varint(rd);
+		if (!(ser = Read_Rebin_Ref(rd, RBT_IMAGE))) {
+			w = (REBCNT)Read_Rebin_Varint(rd);
+			h = (REBCNT)Read_Rebin_Varint(rd);
+			if (w > 0xFFFF || h > 0xFFFF || (REBU64)w * h * 4 > (REBU64)(rd->end - rd->cp)) BAD_REBIN();
+			bp = Read_Rebin_Bytes(rd, w * h * 4);
+			ser = Make_Image(w, h, FALSE);
+			COPY_MEM(IMG_DATA(ser), bp, w * h * 4);
+			Add_Rebin_Ref(rd, ser, RBT_IMAGE);
+		}
+		if (n > SERIES_TAIL(ser)) BAD_REBIN();
+		SET_IMAGE(out, ser);
+		VAL_INDEX(out) = n;
+		break;
+
+	case RBT_VECTOR:
+		n = (REBCNT)Read_Rebin_Varint(rd);
+		if (!(ser = Read_Rebin_Ref(rd, RBT_VECTOR))) {
+			u = Read_Rebin_Varint(rd);
+			// only the type bits and one dimension are valid (see Make_Vector):
+			if ((u & ~(REBU64)0x0F) != (1 << 8)) BAD_REBIN();
+			type = (REBCNT)u;
+			if (VECT_TYPE_ID(type) >= VT_MAX || VECT_TYPE_ID(type) == VTSF08 || VECT_TYPE_ID(type) == VTSF16) BAD_REBIN();
+			w = VECT_BYTE_SIZE(type);
+			len = Read_Rebin_Length(rd, w);
+			ser = Make_Series(len + 1, w, FALSE);
+			COPY_MEM(SERIES_DATA(ser), Read_Rebin_Bytes(rd, len * w), len * w);
+			SERIES_TAIL(ser) = len;
+			ser->size = type;
+			Add_Rebin_Ref(rd, ser, RBT_VECTOR);
+		}
+		if (n > SERIES_TAIL(ser)) BAD_REBIN();
+		SET_VECTOR(out, ser);
+		VAL_INDEX(out) = n;
+		break;
+
+	case RBT_BLOCK:
+	case RBT_PAREN:
+	case RBT_PATH:
+	case RBT_SET_PATH:
+	case RBT_GET_PATH:
+	case RBT_LIT_PATH:
+	case RBT_HASH:
+		n = (REBCNT)Read_Rebin_Varint(rd);
+		if (!(ser = Read_Rebin_Ref(rd, RBT_BLOCK))) {
+			len = Read_Rebin_Length(rd, 1); // each value takes at least 1 byte
+			ser = Make_Block(len);
+			// The tail is final before the values are decoded, so the
+			// index of a reference to this block can be checked:
+			for (w = 0; w < len; w++) SET_NONE(BLK_SKIP(ser, w));
+			SERIES_TAIL(ser) = len;
+			BLK_TERM(ser);
+			Add_Rebin_Ref(rd, ser, RBT_BLOCK);
+			for (w = 0; w < len; w++) {
+				Decode_Rebin_Value(rd, &val);
+				*BLK_SKIP(ser, w) = val;
+			}
+		}
+		if (n > SERIES_TAIL(ser)) BAD_REBIN();
+		VAL_SET(out, REB_BLOCK + (tag - RBT_BLOCK));
+		VAL_SERIES(out) = ser;
+		VAL_INDEX(out) = n;
+		break;
+
+	case RBT_MAP:
+		if (!(ser = Read_Rebin_Ref(rd, RBT_MAP))) {
+			len = Read_Rebin_Length(rd, 2);
+			ser = Make_Map(len);
+			Add_Rebin_Ref(rd, ser, RBT_MAP);
+			for (n = 0; n < len; n++) {
+				Decode_Rebin_Value(rd, &key);
+				Decode_Rebin_Value(rd, &val);
+				Find_Entry(ser, &key, &val, TRUE);
+			}
+		}
+		VAL_SET(out, REB_MAP);
+		VAL_SERIES(out) = ser;
+		break;
+
+	case RBT_OBJECT:
+		if (!(ser = Read_Rebin_Ref(rd, RBT_OBJECT))) {
+			len = Read_Rebin_Length(rd, 2);
+			ser = Make_Frame(len);
+			Add_Rebin_Ref(rd, ser, RBT_OBJECT);
+			for (n = 0; n < len; n++) {
+				w = Read_Rebin_Symbol(rd);
+				Decode_Rebin_Value(rd, &val);
+				*Append_Frame(ser, 0, w) = val;
+			}
+		}
+		Init_Obj_Value(out, ser);
+		break;
+
+	default:
+		if (tag < RBT_WORD || tag > RBT_ISSUE) BAD_REBIN();
+		Init_Word(out, Read_Rebin_Symbol(rd));
+		VAL_SET(out, REB_WORD + (tag - RBT_WORD));
+	}
+
+	if (*bp & RBT_LINE) VAL_SET_LINE(out);
+}
+
+
+/***********************************************************************
+**
+*/	static void Decode_Rebin(const REBYTE *data, REBCNT len, REBVAL *out)
+/*
+***********************************************************************/
+{
+	REBRBD rd;
+	REBCNT count, n, sym;
+	const REBYTE *name;
+
+	rd.cp  = data + 5;
+	rd.end = data + len;
+
+	count = Read_Rebin_Length(&rd, 1);
+	rd.syms = Make_Series(count + 1, sizeof(REBCNT), FALSE);
+	for (n = 0; n < count; n++) {
+		sym = Read_Rebin_Length(&rd, 1);
+		name = Read_Rebin_Bytes(&rd, sym);
+		if (sym == 0) BAD_REBIN();
+		((REBCNT *)SERIES_DATA(rd.syms))[n] = Make_Word(name, sym);
+	}
+	SERIES_TAIL(rd.syms) = count;
+	rd.refs = Make_Series(64, sizeof(REBRBF), FALSE);
+
+	Decode_Rebin_Value(&rd, out);
+	if (rd.cp != rd.end) BAD_REBIN();
+
+	Free_Series(rd.syms);
+	Free_Series(rd.refs);
+}
+
+
+/***********************************************************************
+**
+*/	REBINT Codec_REBIN(REBCDI *codi)
+/*
+***********************************************************************/
+{
+	REBSER *buf = BUF_EMIT;
+	REBVAL *val;
+	REBVAL out;
+	REBSER *img;
+
+	codi->error = 0;
+
+	if (codi->action == CODI_IDENTIFY) {
+		if (codi->len < 5 || memcmp(codi->data, "RBIN", 4) || codi->data[4] != REBIN_VERSION)
+			codi->error = CODI_ERR_SIGNATURE;
+		return CODI_CHECK;
+	}
+
+	if (codi->action == CODI_DECODE) {
+		if (codi->len < 5 || memcmp(codi->data, "RBIN", 4) || codi->data[4] != REBIN_VERSION) {
+			codi->error = CODI_ERR_SIGNATURE;
+			return CODI_ERROR;
+		}
+		Decode_Rebin(codi->data, codi->len, &out);
+	}
+	else if (codi->action == CODI_ENCODE_VALUE) {
+		Set_Binary(&out, Encode_Rebin((REBVAL *)codi->other));
+	}
+	else if (codi->action == CODI_ENCODE) {
+		// Images are passed only as bits:
+		img = Make_Image(codi->w, codi->h, TRUE);
+		COPY_MEM(IMG_DATA(img), codi->bits, codi->w * codi->h * 4);
+		SET_IMAGE(&out, img);
+		Set_Binary(&out, Encode_Rebin(&out));
+	}
+	else {
+		codi->error = CODI_ERR_NA;
+		return CODI_ERROR;
+	}
+
+	// The value stays in the buffer until it is copied by DO-CODEC:
+	val = Append_Value(buf);
+	*val = out;
+	codi->other = val;
+	SERIES_TAIL(buf)--;
+	return CODI_VALUE;
+}
+
+
+/***********************************************************************
+**
+*/	void Init_REBIN_Codec(void)
+/*
+***********************************************************************/
+{
+	Register_Codec("rebin", Codec_REBIN);
+}
+
+#endif //INCLUDE_REBIN_CODEC
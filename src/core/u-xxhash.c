@@ -42,8 +42,35 @@
 #define XXH_STATIC_LINKING_ONLY /* access advanced declarations */
 #define XXH_IMPLEMENTATION      /* access definitions */
 
+#ifdef CPU_X86
+/* AVX2 versions of the XXH3 long input loop are compiled too and used,
+ * when the CPU has them (XXH3 itself selects SSE2 on x86 by default) */
+#define XXH_DISPATCH_AVX2 1
+#define XXH_TARGET_AVX2   TARGET_CPU("avx2")
+#define XXH_ACC_ALIGN     32
+#include <immintrin.h>
+#endif
+
 #include "sys-xxhash.h"
 
+#ifdef CPU_X86
+#define USE_XXH3_AVX2(n) ((n) > XXH3_MIDSIZE_MAX && (Get_CPU_Features() & CPU_AVX2))
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH64_hash_t
+XXH3_hashLong_64b_avx2(const void* XXH_RESTRICT input, size_t len)
+{
+	return XXH3_hashLong_64b_internal(input, len, XXH3_kSecret, sizeof(XXH3_kSecret),
+	                                  XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2);
+}
+
+XXH_NO_INLINE XXH_TARGET_AVX2 XXH128_hash_t
+XXH3_hashLong_128b_avx2(const void* XXH_RESTRICT input, size_t len)
+{
+	return XXH3_hashLong_128b_internal(input, len, XXH3_kSecret, sizeof(XXH3_kSecret),
+	                                   XXH3_accumulate_avx2, XXH3_scrambleAcc_avx2);
+}
+#endif
+
 /***********************************************************************
 **
 */	REBYTE *HashXXH3(REBYTE *d, REBCNT n, REBYTE *md)
@@ -51,7 +78,12 @@
 ***********************************************************************/
 {
 	// d is data, n is length
-    XXH64_hash_t const hash = XXH3_64bits(d, n);
+    XXH64_hash_t hash;
+#ifdef CPU_X86
+	if (USE_XXH3_AVX2(n)) hash = XXH3_hashLong_64b_avx2(d, n);
+	else
+#endif
+	hash = XXH3_64bits(d, n);
 	XXH64_canonicalFromHash((XXH64_canonical_t *)md, hash);
     return md;
 }
@@ -83,7 +115,12 @@
 ***********************************************************************/
 {
 	// d is data, n is length
-	XXH128_hash_t const hash = XXH128(d, n, 0);
+	XXH128_hash_t hash;
+#ifdef CPU_X86
+	if (USE_XXH3_AVX2(n)) hash = XXH3_hashLong_128b_avx2(d, n);
+	else
+#endif
+	hash = XXH128(d, n, 0);
 	XXH128_canonicalFromHash((XXH128_canonical_t *)md, hash);
 	return md;
 }
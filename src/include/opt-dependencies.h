@@ -56,6 +56,7 @@
 	#define MBEDTLS_SHA1_C
 	#define MBEDTLS_SHA224_C
 	#define MBEDTLS_SHA256_C
+	#define MBEDTLS_SHA256_USE_X86_SHA_NI_IF_PRESENT // Rebol's addition (see sha256.c)
 	#define MBEDTLS_SHA512_C
 
 	#if defined(INCLUDE_MD4)
@@ -48,6 +48,13 @@
 // the REBNATIVE(do_codec) in n-system.c
 // so the deallocation is left to GC
 //
+// If your codec routine returns CODI_VALUE, the ->other field points
+// to a value which is copied by REBNATIVE(do_codec) right away
+// (so it may be kept in a buffer which is reused later).
+//
+// CODI_ENCODE_VALUE passes any value (not just an image) in the
+// ->other field. Optional value given to DO-CODEC/AS is in ->options.
+//
 struct reb_codec_image {
 	int action;
 	int w;
@@ -63,6 +70,7 @@ struct reb_codec_image {
 		void *other;
 	};
 	int error;
+	void *options;
 };
 
 typedef struct reb_codec_image REBCDI;
@@ -79,6 +87,7 @@ enum {
 	CODI_SOUND,
 	CODI_BLOCK,
 	CODI_STRING,			// result is in codi->other as a series (no need to copy).
+	CODI_VALUE,				// result is in codi->other as a value (is copied).
 };
 
 // Codec commands:
@@ -86,6 +95,7 @@ enum {
 	CODI_IDENTIFY,
 	CODI_DECODE,
 	CODI_ENCODE,
+	CODI_ENCODE_VALUE,		// any value (in codi->other)
 };
 
 // Codec errors:
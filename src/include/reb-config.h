@@ -179,10 +179,14 @@ Special internal defines used by RT, not Host-Kit developers:
 #ifdef TO_LINUX
 #undef INCLUDE_MIDI_DEVICE      // Not implemented!
 #define USE_SETENV 
+#define HAS_EPOLL				// readiness driven WAIT (host-device.c)
+#define HAS_SENDFILE			// file to socket without copies (dev-net.c)
+#define HAS_MMSG				// more datagrams per recv/send call (dev-net.c)
 #endif
 
 #ifdef TO_MACOS					// macOS
 #define USE_SETENV 
+#define HAS_SENDFILE
 #endif
 
 #ifdef TO_OSX					// OSX/PPC
@@ -198,6 +202,7 @@ Special internal defines used by RT, not Host-Kit developers:
 #ifdef TO_FREEBSD				// FreeBSD
 #undef INCLUDE_MIDI_DEVICE      // Not implemented!
 #define USE_SETENV 
+#define HAS_SENDFILE
 #endif
 
 #ifdef TO_NETBSD				// NetBSD
@@ -219,6 +224,10 @@ Special internal defines used by RT, not Host-Kit developers:
 
 //* Defaults ***********************************************************
 
+#if !defined(THREAD) && defined(INCLUDE_TASK) && defined(__GNUC__)
+#define THREAD __thread			// tasks need own copies of thread globals
+#endif
+
 #ifndef THREAD
 #define THREAD
 #endif
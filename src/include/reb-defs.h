@@ -85,6 +85,18 @@ void   stable_sort(void* a, size_t n, size_t es, cmp_t* cmp);
 #define SORT_FLAG_ALL     4
 #define SORT_FLAG_BINARY  5 // used with the custom sort function
 
+// Radix sort (f-radix-sort.c):
+#define RADIX_UNSIGNED 0
+#define RADIX_SIGNED   1
+#define RADIX_FLOAT    2
+typedef struct rebol_radix_item {
+	REBU64 key;
+	REBLEN index;
+} REBRDX;
+
+// Parallel merge sort (f-parallel-sort.c), comparator with a context:
+typedef int	cmp_ctx_t(void *ctx, const void *, const void *);
+
 
 // Encoding_opts was originally in sys-core.h, but I moved it here so it can
 // be used also while makking external extensions. (oldes)
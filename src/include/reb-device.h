@@ -107,6 +107,15 @@ enum {
 	RRF_WIDE,		// Wide char IO
 	RRF_ACTIVE,		// Port is active, even no new events yet
 	RRF_ERROR,      // WRITE to std_err
+	RRF_WATCHED,	// Request's descriptor is registered in the wait set
+	RRF_WAITING,	// Waiting for readiness from the wait set (not polled)
+};
+
+// Wait set readiness modes (see Watch_Request in host-device.c):
+enum {
+	RWS_READ  = 1,	// wake when readable (or on hangup)
+	RWS_WRITE = 2,	// wake when writable
+	RWS_LEVEL = 4,	// keep armed after wake (no one-shot)
 };
 
 // REBOL Device Errors:
@@ -230,6 +239,11 @@ struct rebol_devreq {
 			u32  remote_ip;			// remote address
 			u32  remote_port;		// remote port
 			void *host_info;		// for DNS usage
+			REBREQ *file;			// open file to send (RST_SENDFILE)
+			i64  file_index;		// where to start sending it
+			u32  transfer;			// send/recv size limit (grows with the traffic)
+			u32  read_size;			// buffer extension for READ (zero = adaptive)
+			u32  batch;				// datagrams per UDP READ (zero = one as binary)
 		} net;
 		struct {
 			u32  buffer_rows;
@@ -275,4 +289,9 @@ struct rebol_devreq {
 #define SET_CLOSED(r)	CLR_FLAG(((REBREQ*)(r))->flags, RRF_OPEN)
 #define IS_OPEN(r)		GET_FLAG(((REBREQ*)(r))->flags, RRF_OPEN)
 
+// Host wait set (readiness driven WAIT), implemented in host-device.c:
+extern int  Watch_Request(REBREQ *req, int fd, int modes);
+extern void Unwatch_Request(REBREQ *req, int fd);
+extern int  Wait_Requests(u32 millisec);
+
 #endif //DEVICE_H
@@ -37,6 +37,7 @@ enum {
 	RFM_READONLY,
 	RFM_TRUNCATE,
 	RFM_RESEEK,			// file index has moved, reseek
+	RFM_MMAP,			// read maps the file into memory (read/mmap)
 //	RFM_NAME_MEM,		// converted name allocated in mem
 	RFM_DIR = 16,
 	RFM_DRIVES,         // used only on Windows to get logical drives letters (read %/)
@@ -55,6 +56,7 @@ enum {
 	RFE_BAD_WRITE,		// Write failed (general)
 	RFE_DISK_FULL,		// No space on target volume
 	RFE_RESIZE_SERIES,  // Used on Posix to report, that the target series must be resized
+	RFE_NO_MMAP,        // File cannot be mapped into memory (read it instead)
 };
 
 #define MAX_FILE_NAME 1022
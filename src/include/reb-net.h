@@ -29,10 +29,30 @@
 // REBOL Socket types:
 enum socket_types {
 	RST_UDP,					// TCP or UDP
+	RST_SENDFILE,				// WRITE sends a part of the net.file
+	RST_GATHER,					// WRITE sends a list of REBIOV parts
+	RST_BATCH,					// UDP READ/WRITE of a REBDGM list
 	RST_LISTEN = 8,				// LISTEN
 	RST_REVERSE,				// DNS reverse
 };
 
+// A part of data sent by one WRITE (RST_GATHER). The list ends with NULL data:
+typedef struct rebol_net_part {
+	const REBYTE *data;
+	u32 length;
+} REBIOV;
+
+// A datagram of batched UDP READ or WRITE (RST_BATCH). The request's
+// length and actual are then counts of datagrams, not bytes:
+typedef struct rebol_net_datagram {
+	REBYTE *data;
+	u32 length;					// buffer size for READ, then received size
+	u32 remote_ip;
+	u32 remote_port;
+} REBDGM;
+
+#define MAX_NET_BATCH 64		// max datagrams received by one READ
+
 // REBOL Socket Modes (state flags)
 enum {
 	RSM_OPEN = 0,				// socket is allocated
@@ -45,4 +65,10 @@ enum {
 	RSM_ACCEPT,					// an inbound connection
 };
 
+// DNS modify modes (seconds for which lookups are cached):
+enum {
+	RDM_DNS_TTL = 1,			// found addresses
+	RDM_DNS_NEGATIVE_TTL,		// failed lookups
+};
+
 #define IPA(a,b,c,d) (a<<24 | b<<16 | c<<8 | d)
@@ -47,6 +47,7 @@
 #define MAX_COMMON 100000		// max size of common buffer (shrink trigger)
 #define	MAX_NUM_LEN 64			// As many numeric digits we will accept on input
 #define MAX_SAFE_SERIES 5		// quanitity of most recent series to not GC.
+#define MAX_MINOR_RECYCLES 8	// minor recycles done between full ones (generational GC)
 #define MAX_EXPAND_LIST 5		// number of series-1 in Prior_Expand list
 #define USE_UNICODE 1			// scanner uses unicode
 #define UNICODE_CASES 0x2E00	// size of unicode folding table
@@ -265,9 +266,11 @@ enum Insert_Arg_Nums {
 };
 
 enum rebol_signals {
-	SIG_RECYCLE,
+	SIG_RECYCLE,	// in Task_Signals (the task's own memory)
 	SIG_ESCAPE,
 	SIG_EVENT_PORT,
+	SIG_SAMPLE,		// sampler timer tick (d-profile.c)
+	SIG_STOP_TASKS,	// sub-tasks must halt (the program quits)
 };
 
 // Security flags:
@@ -285,6 +288,25 @@ enum {
 	POL_EXEC,
 };
 
+// CPU features detected at runtime (see Get_CPU_Features):
+enum {
+	CPU_SSE42 = 1 << 0,		// crc32 instruction
+	CPU_AVX2  = 1 << 1,		// also enabled by the OS
+	CPU_SHA   = 1 << 2,		// SHA extensions
+	CPU_KNOWN = 1 << 31
+};
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CPU_X86
+#if defined(_MSC_VER)
+#define TARGET_CPU(features)	// intrinsics are always available
+#elif defined(__GNUC__) || defined(__clang__)
+#define TARGET_CPU(features) __attribute__((target(features)))
+#else
+#undef CPU_X86	// no way to compile code for other than the default target
+#endif
+#endif
+
 /***********************************************************************
 **
 **	Macros
@@ -337,9 +359,27 @@ enum {
 #define IS_WHITE(c) ((c) <= 32 && (White_Chars[c]&1) != 0)
 #define IS_SPACE(c) ((c) <= 32 && (White_Chars[c]&2) != 0)
 
+// Signals are shared by all tasks (and set by the host's signal handlers),
+// so with tasks they must be changed atomically:
+#if defined(INCLUDE_TASK) && defined(__GNUC__)
+#define SET_SIGNAL(f) __sync_fetch_and_or(&Eval_Signals, FLAGIT(f))
+#define CLR_SIGNAL(f) __sync_fetch_and_and(&Eval_Signals, ~FLAGIT(f))
+#elif defined(INCLUDE_TASK) && defined(_MSC_VER)
+#include <intrin.h>
+#define SET_SIGNAL(f) _InterlockedOr((volatile long *)&Eval_Signals, FLAGIT(f))
+#define CLR_SIGNAL(f) _InterlockedAnd((volatile long *)&Eval_Signals, ~FLAGIT(f))
+#else
 #define SET_SIGNAL(f) SET_FLAG(Eval_Signals, f)
-#define GET_SIGNAL(f) GET_FLAG(Eval_Signals, f)
 #define CLR_SIGNAL(f) CLR_FLAG(Eval_Signals, f)
+#endif
+#define GET_SIGNAL(f) GET_FLAG(Eval_Signals, f)
+
+// Signals of the current task only:
+#define SET_TASK_SIGNAL(f) SET_FLAG(Task_Signals, f)
+#define CLR_TASK_SIGNAL(f) CLR_FLAG(Task_Signals, f)
+
+// Used by evaluation loops to decide when Do_Signals is needed:
+#define ANY_SIGNALS (Eval_Signals | Task_Signals)
 
 #define	DECIDE(cond) if (cond) goto is_true; else goto is_false
 #define REM2(a, b) ((b)!=-1 ? (a) % (b) : 0)
@@ -415,9 +455,12 @@ typedef struct rebol_stats {
 	REBCNT	Series_Freed;
 	REBCNT	Series_Expanded;
 	REBCNT	Recycle_Counter;
+	REBCNT	Recycle_Minor_Counter;
 	REBCNT	Recycle_Series_Total;
 	REBCNT	Recycle_Series;
 	REBI64  Recycle_Prior_Eval;
+	REBI64  Recycle_Time;		// total pause time of full recycles (microseconds)
+	REBI64  Recycle_Minor_Time;	// total pause time of minor recycles (microseconds)
 	REBCNT	Mark_Count;
 	REBCNT	Free_List_Checked;
 	REBCNT	Blocks;
@@ -57,6 +57,11 @@ PVAR REBUNI *Lower_Cases;
 
 // Other:
 PVAR REBYTE *PG_Pool_Map;	// Memory pool size map (created on boot)
+PVAR REBSPR *PG_Pool_Spares; // Empty pool segments shared by tasks
+PVAR void   *PG_Pool_Lock;	// Guards PG_Pool_Spares
+PVAR void   *PG_Task_Lock;	// Guards word table changes and task heap ids
+PVAR REBCNT  PG_Task_Count;	// Number of running sub-tasks
+PVAR REBYTE  PG_Task_Heaps[MAX_TASK_HEAPS]; // Heap ids in use
 PVAR REBSER *PG_Root_Words;	// Root object word table (reused by threads)
 PVAR REBHSP *PG_Handles;    // Holds handle related contexts/specs
 
@@ -64,10 +69,9 @@ PVAR REBI64 PG_Boot_Time;	// Counter when boot started
 PVAR REBINT Current_Year;
 PVAR REB_OPTS *Reb_Opts;
 
-PVAR jmp_buf *Halt_State;	// Pointer to saved CPU state for HALT/QUIT handlers
 
-// This signal word should be thread-local, but it will not work
-// when implemented that way. Needs research!!!!
+// Signal flags are shared by tasks (host's signal handlers may run in
+// any thread), so use SET_SIGNAL and CLR_SIGNAL to change them:
 PVAR REBCNT	Eval_Signals;	// Signal flags
 
 
@@ -87,6 +91,7 @@ TVAR REBSER *Task_Series;	// Series that holds Task_Context
 
 //-- Memory and GC:
 TVAR REBPOL *Mem_Pools;		// Memory pool array
+TVAR REBCNT Task_Heap;		// Heap id stored in headers of series made by this task
 TVAR REBCNT	GC_Disabled;	// GC disabled counter for critical sections.
 TVAR REBINT	GC_Ballast;		// Bytes allocated to force automatic GC
 TVAR REBOOL	GC_Active;		// TRUE when recycle is enabled (set by RECYCLE func)
@@ -96,6 +101,9 @@ TVAR REBSER *GC_Mark_Queue; // An array of series to be marked (to avoid deep re
 TVAR REBSER	**GC_Infants;	// A small list of last N series created (nursery)
 TVAR REBINT	GC_Last_Infant;	// Index to last infant above (circular)
 TVAR REBFLG GC_Stay_Dirty;  // Do not free memory, fill it with 0xBB
+TVAR REBSER *GC_Remembered; // Old blocks modified since last recycle (write barrier)
+TVAR REBFLG GC_Minor;		// TRUE while doing a minor (young generation) recycle
+TVAR REBCNT GC_Minor_Count;	// Minor recycles done since the last full recycle
 TVAR REBSER **Prior_Expand;	// Track prior series expansions (acceleration)
 
 TVAR REBUPT Stack_Limit;	// Limit address for CPU stack.
@@ -107,6 +115,7 @@ TVAR REBINT	DSP;			// Data stack pointer
 TVAR REBINT	DSF;			// Data stack frame (function base)
 
 TVAR jmp_buf *Saved_State;	// Pointer to saved CPU state for error handlers.
+TVAR jmp_buf *Halt_State;	// Pointer to saved CPU state for HALT/QUIT handlers
 
 //-- Evaluation variables:
 TVAR REBI64	Eval_Cycles;	// Total evaluation counter (upward)
@@ -114,6 +123,7 @@ TVAR REBI64	Eval_Limit;		// Evaluation limit (set by secure)
 TVAR REBINT	Eval_Count;		// Evaluation counter (downward)
 TVAR REBINT	Eval_Dose;		// Evaluation counter reset value
 TVAR REBCNT	Eval_Sigmask;	// Masking out signal flags
+TVAR REBCNT	Task_Signals;	// Signal flags of this task only (recycle)
 
 TVAR REBCNT	Trace_Flags;	// Trace flag
 TVAR REBINT	Trace_Level;	// Trace depth desired
@@ -124,6 +134,8 @@ TVAR REBSER *Trace_Buffer;	// Holds backtrace lines
 TVAR REBI64 Eval_Natives;
 TVAR REBI64 Eval_Functions;
 
+TVAR struct Reb_Sampler *Sampler; // Call stack samples (SAMPLER native)
+
 #ifdef DEBUG_HASH_COLLISIONS
 TVAR REBI64 Eval_Collisions; // Hash collisions
 #endif
@@ -83,6 +83,20 @@ typedef void *REBNOD;			// Just used for linking free nodes
 } REBPOL;
 
 
+/***********************************************************************
+**
+*/	typedef struct rebol_mem_spares
+/*
+**		Empty segments handed back by ended tasks. Shared by all
+**		tasks (guarded by PG_Pool_Lock) and reused by Fill_Pool.
+**
+***********************************************************************/
+{
+	REBSEG	*segs;				// first spare segment
+	REBCNT	count;				// number of spare segments
+} REBSPR;
+
+
 /***********************************************************************
 **
 */	enum Mem_Pool_Specs
@@ -114,6 +128,8 @@ typedef void *REBNOD;			// Just used for linking free nodes
 #endif
 
 #define MEM_BALLAST 3000000
+#define MAX_SPARE_SEGS 16	// spare segments kept per pool (rest is freed)
+#define MAX_TASK_HEAPS 256	// heap ids fit the series header (0 = main task)
 
 // Disable GC - Only necessary if DO_NEXT with non-referenced series.
 #define DISABLE_GC		GC_Disabled++
@@ -92,5 +92,7 @@ typedef struct hostent HOSTENT;
 typedef struct sockaddr_in SOCKAI; // Internet extensions
 
 #define BAD_SOCKET (~0)
-#define MAX_TRANSFER 32000		// Max send/recv buffer size
+#define MAX_TRANSFER 32000		// Initial send/recv size limit
+#define MAX_NET_TRANSFER (4*1024*1024)	// Max send/recv size limit
+#define MAX_GATHER 64			// Max parts sent by one call
 #define MAX_HOST_NAME 256		// Max length of host name
@@ -80,6 +80,14 @@
 #define DSF_ARGS(d,n)	(&DS_Base[(d)+DSF_SIZE+(n)])
 #define PRIOR_DSF(d)	VAL_BACK(DSF_BACK(d))
 
+// A running closure keeps a block in the RETURN slot with its frame object
+// (or NONE) followed by the body's series and their copies for the call.
+// The args are moved to the object when any of its words escape from the
+// call (see Do_Closure):
+#define DSF_CLOSURE_FRAME(d) ((IS_CLOSURE(DSF_FUNC(d)) && IS_BLOCK(DSF_RETURN(d)) \
+							&& IS_OBJECT(VAL_BLK(DSF_RETURN(d)))) ? VAL_OBJ_FRAME(VAL_BLK(DSF_RETURN(d))) : 0)
+#define DSF_VARS(d)		(DSF_CLOSURE_FRAME(d) ? FRM_VALUES(DSF_CLOSURE_FRAME(d)) : DSF_ARGS(d,0))
+
 // Reference from ds that points to current return value:
 #define	D_RET			(ds)
 #define D_ARG(n)		(ds+(DSF_SIZE+n))
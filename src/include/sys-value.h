@@ -103,6 +103,16 @@ enum {
 // When key is removed from map, it has OPTS_HIDE flag
 #define VAL_MAP_REMOVED(val) (VAL_GET_OPT(val, OPTS_HIDE)) 
 
+// Slot of the map's hash table (also used to hash blocks in SET operations).
+// The hash of the key is cached, so the probe can skip other keys without
+// comparing values and the table can be expanded without rehashing keys.
+typedef struct Reb_Hash_Slot {
+	REBCNT index;	// one-based record index (zero is an empty slot)
+	REBCNT hash;	// Hash_Value of the key
+} REBHSL;
+
+#define HASH_SLOTS(hser) ((REBHSL *)((hser)->data))
+
 
 /***********************************************************************
 **
@@ -394,7 +404,7 @@ static REBCNT byte_sizes[4] = { 1, 2, 4, 8 };
 	REBYTE	*data;		// series data head
 	REBLEN	tail;		// one past end of useful data
 	REBLEN	rest;		// total number of units from bias to end
-	REBINT  sizes;      // 16 bits bias, 8 bits reserved, 8 bits wide!
+	REBINT  sizes;      // 16 bits bias, 8 bits heap, 8 bits wide!
 	REBCNT  flags;
 	union {
 		REBCNT size;	// used for vectors and bitsets
@@ -416,8 +426,9 @@ static REBCNT byte_sizes[4] = { 1, 2, 4, 8 };
 #define	SERIES_SIZES(s)  ((s)->sizes)
 #define	SERIES_FLAGS(s)	 ((s)->flags)
 #define	SERIES_WIDE(s)	 (((s)->sizes) & 0xff)
+#define	SERIES_HEAP(s)	 ((((s)->sizes) >> 8) & 0xff) // owner task (0 = main)
 #define SERIES_DATA(s)   ((s)->data)
-#define	SERIES_SKIP(s,i) (SERIES_DATA(s) + (SERIES_WIDE(s) * (i)))
+#define	SERIES_SKIP(s,i) (SERIES_DATA(s) + ((size_t)SERIES_WIDE(s) * (i)))
 
 #define END_FLAG 0x80000000  // Indicates end of block as an index (from DO_NEXT)
 
@@ -440,11 +451,19 @@ static REBCNT byte_sizes[4] = { 1, 2, 4, 8 };
 #define SERIES_SUB_BIAS(s,b) (SERIES_SIZES(s) -= (b << 16))
 
 // Size in bytes of memory allocated (including bias area):
-#define SERIES_TOTAL(s) ((SERIES_REST(s) + SERIES_BIAS(s)) * (REBCNT)SERIES_WIDE(s))
+#define SERIES_TOTAL(s) ((size_t)(SERIES_REST(s) + SERIES_BIAS(s)) * SERIES_WIDE(s))
 // Size in bytes of series (not including bias area):
-#define	SERIES_SPACE(s) (SERIES_REST(s) * (REBCNT)SERIES_WIDE(s))
+#define	SERIES_SPACE(s) ((size_t)SERIES_REST(s) * SERIES_WIDE(s))
 // Size in bytes being used, including terminator:
-#define SERIES_USED(s) (SERIES_LEN(s) * SERIES_WIDE(s))
+#define SERIES_USED(s) ((size_t)SERIES_LEN(s) * SERIES_WIDE(s))
+
+// Length of a series is limited by 32-bit indexes (in units), but its
+// data may have more than 4GB on 64-bit systems (vectors of wide values).
+// Lengths over this limit are trapped as too-long. Wider lengths need
+// 64-bit tail/rest and VAL_INDEX, and 64-bit lengths in the copy, find,
+// checksum, compress and device (file I/O) paths.
+#define MAX_SERIES_LEN  ((REBCNT)MAX_I32)
+#define MAX_SERIES_SIZE ((REBU64)(((size_t)-1) >> 1))
 
 // Optimized expand when at tail (but, does not reterminate)
 #define EXPAND_SERIES_TAIL(s,l) if (SERIES_FITS(s, l)) s->tail += l; else Expand_Series(s, AT_TAIL, l)
@@ -482,6 +501,10 @@ enum {
 	SER_MON  = 1<<7,	// Monitoring
 	SER_INT  = 1<<8,	// Series data is internal (loop frames) and should not be accessed by users
 	SER_UTF8 = 1<<9,	// Series contains not only ASCII characters
+	SER_OLD  = 1<<10,	// Series survived a recycle (old generation)
+	SER_REMB = 1<<11,	// Old block is in the remembered set (may link young series)
+	SER_MMAP = 1<<12,	// Series data is a memory mapped file (EXT, unmapped on free)
+	SER_REL  = 1<<13,	// Block of a shared closure body (its series are copied per call)
 };
 
 #define SERIES_SET_FLAG(s, f) (SERIES_FLAGS(s) |=  (f))
@@ -495,6 +518,7 @@ enum {
 #define KEEP_SERIES(s,l)  do {SERIES_SET_FLAG(s, SER_KEEP); LABEL_SERIES(s,l);} while(0)
 #define EXT_SERIES(s)     SERIES_SET_FLAG(s, SER_EXT)
 #define IS_EXT_SERIES(s)  SERIES_GET_FLAG(s, SER_EXT)
+#define IS_MMAP_SERIES(s) SERIES_GET_FLAG(s, SER_MMAP)
 #define INT_SERIES(s)     SERIES_SET_FLAG(s, SER_INT)
 #define IS_INT_SERIES(s)  SERIES_GET_FLAG(s, SER_INT)
 #define LOCK_SERIES(s)    SERIES_SET_FLAG(s, SER_LOCK)
@@ -504,12 +528,23 @@ enum {
 #define PROTECT_SERIES(s) SERIES_SET_FLAG(s, SER_PROT)
 #define UNPROTECT_SERIES(s)  SERIES_CLR_FLAG(s, SER_PROT)
 #define IS_PROTECT_SERIES(s) SERIES_GET_FLAG(s, SER_PROT)
+#define IS_OLD_SERIES(s)     SERIES_GET_FLAG(s, SER_OLD)
 #define UTF8_SERIES(s)       SERIES_SET_FLAG(s, SER_UTF8)
 #define IS_UTF8_SERIES(s)    SERIES_GET_FLAG(s, SER_UTF8)
 #define IS_UTF8_STRING(v)    SERIES_GET_FLAG(VAL_SERIES(v), SER_UTF8)
 
 #define TRAP_PROTECT(s) if (IS_PROTECT_SERIES(s)) Trap0(RE_PROTECTED)
 
+// Write barrier for the generational GC. Use it when values are stored
+// into an existing block (or frame) series, so a minor recycle finds
+// young series linked only from the old generation (see m-gc.c):
+#ifdef USE_GENERATIONAL_GC
+#define GC_BARRIER(s) \
+		if (SERIES_GET_FLAG(s, SER_OLD|SER_REMB) == SER_OLD) Remember_Series(s)
+#else
+#define GC_BARRIER(s)
+#endif
+
 #ifdef SERIES_LABELS
 #define LABEL_SERIES(s,l) s->label = (l)
 #else
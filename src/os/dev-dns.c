@@ -24,6 +24,9 @@
 **  Purpose: Calls local DNS services for domain name lookup.
 **  Notes:
 **      See MS WSAAsyncGetHost* details regarding multiple requests.
+**      Other systems resolve names in a small pool of threads (using
+**      getaddrinfo), so a slow lookup does not block the interpreter.
+**      Their results are cached for a time (see RDM_DNS_TTL).
 **
 ************************************************************************
 **
@@ -51,6 +54,323 @@ extern DEVICE_CMD Quit_Net(REBREQ *);
 #ifdef HAS_ASYNC_DNS
 // Async DNS requires a window handle to signal completion (WSAASync)
 extern HWND Event_Handle;
+#else
+
+#include <time.h>
+
+#define DNS_THREADS 4			// max resolver threads
+#define DNS_CACHE_SIZE 64		// lookups remembered
+
+enum {
+	DNS_QUEUED,					// waiting for (or in) a thread
+	DNS_DONE,					// result is ready
+	DNS_CANCELED,				// nobody waits, thread frees it
+	DNS_CACHED,					// result is from the cache
+};
+
+typedef struct rebol_dns_job {
+	struct rebol_dns_job *next;	// queue link
+	int  state;
+	int  error;					// zero when no error
+	u32  ip;					// address to resolve or the result
+	char name[MAX_HOST_NAME];	// name to resolve or the result (reverse)
+} REBDNS;
+
+typedef struct rebol_dns_cache {
+	time_t expires;				// zero when not used
+	int  error;
+	u32  ip;
+	int  reverse;
+	char name[MAX_HOST_NAME];
+} REBDNC;
+
+static void   *Dns_Lock;		// guards the queue and job states
+static REBDNS *Dns_Queue;		// jobs waiting for a thread
+static int     Dns_Threads;		// started threads
+static int     Dns_Idle;		// threads waiting for a job
+static int     Dns_Wake[2] = {-1, -1};	// written when a job is done
+static REBREQ  Dns_Watch;		// wait set token of the wake pipe
+static int     Dns_Active;		// jobs not collected yet (main thread only)
+static REBDNC  Dns_Cache[DNS_CACHE_SIZE];	// main thread only
+static u32     Dns_TTL = 60;	// seconds to remember found addresses
+static u32     Dns_Negative_TTL = 5; // seconds to remember failures
+
+
+/***********************************************************************
+**
+*/	static void Resolve_Job(REBDNS *job, int reverse)
+/*
+**		Blocking lookup (called in a resolver thread).
+**
+***********************************************************************/
+{
+	struct addrinfo hints, *info = NULL;
+	SOCKAI sa;
+
+	if (reverse) {
+		memset(&sa, 0, sizeof(sa));
+		sa.sin_family = AF_INET;
+		sa.sin_addr.s_addr = job->ip;
+		job->error = getnameinfo((struct sockaddr*)&sa, sizeof(sa), job->name, MAX_HOST_NAME, NULL, 0, NI_NAMEREQD);
+		return;
+	}
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	job->error = getaddrinfo(job->name, NULL, &hints, &info);
+	if (!job->error) {
+		if (info && info->ai_addr) job->ip = ((SOCKAI*)info->ai_addr)->sin_addr.s_addr;
+		else job->error = EAI_NONAME;
+	}
+	if (info) freeaddrinfo(info);
+}
+
+
+/***********************************************************************
+**
+*/	static void Resolver_Thread(void *unused)
+/*
+**		Takes jobs from the queue until the process ends. Finished
+**		jobs are announced by a byte written to the wake pipe.
+**
+***********************************************************************/
+{
+	REBDNS *job;
+	int reverse;
+
+	OS_Task_Ready(0);
+	OS_Lock(Dns_Lock);
+	for (;;) {
+		while (!Dns_Queue) {
+			Dns_Idle++;
+			OS_Wait_Lock(Dns_Lock, -1);
+			Dns_Idle--;
+		}
+		job = Dns_Queue;
+		Dns_Queue = job->next;
+		reverse = job->name[0] == 0;
+		OS_Unlock(Dns_Lock);
+
+		Resolve_Job(job, reverse);
+
+		OS_Lock(Dns_Lock);
+		if (job->state == DNS_CANCELED) OS_Free(job);
+		else job->state = DNS_DONE;
+		if (write(Dns_Wake[1], "", 1) < 0) {} // full pipe is already readable
+	}
+}
+
+
+/***********************************************************************
+**
+*/	static void Resolver_Rearm(void)
+/*
+**		Empties the wake pipe and watches it again (one-shot), while
+**		there are jobs to collect. Must be called before jobs are
+**		checked, so no wake up is lost.
+**
+***********************************************************************/
+{
+	char buf[64];
+
+	if (Dns_Wake[0] < 0) return;
+	while (read(Dns_Wake[0], buf, sizeof(buf)) > 0);
+	if (Dns_Active > 0) Watch_Request(&Dns_Watch, Dns_Wake[0], RWS_READ);
+}
+
+
+/***********************************************************************
+**
+*/	static REBDNC *Cached_Lookup(const char *name, u32 ip, int reverse)
+/*
+***********************************************************************/
+{
+	time_t now = time(NULL);
+	REBDNC *entry;
+
+	for (entry = Dns_Cache; entry < Dns_Cache + DNS_CACHE_SIZE; entry++) {
+		if (entry->expires <= now || entry->reverse != reverse) continue;
+		if (reverse ? entry->ip == ip : !strcasecmp(entry->name, name)) return entry;
+	}
+	return NULL;
+}
+
+
+/***********************************************************************
+**
+*/	static void Cache_Lookup(REBDNS *job, int reverse)
+/*
+**		Remembers result of the job (replacing the oldest entry).
+**
+***********************************************************************/
+{
+	u32 ttl = job->error ? Dns_Negative_TTL : Dns_TTL;
+	REBDNC *entry, *oldest = Dns_Cache;
+
+	if (ttl == 0) return;
+	for (entry = Dns_Cache; entry < Dns_Cache + DNS_CACHE_SIZE; entry++) {
+		if (entry->expires < oldest->expires) oldest = entry;
+	}
+	oldest->expires = time(NULL) + ttl;
+	oldest->error = job->error;
+	oldest->ip = job->ip;
+	oldest->reverse = reverse;
+	strncpy(oldest->name, job->name, MAX_HOST_NAME - 1);
+	oldest->name[MAX_HOST_NAME - 1] = 0;
+}
+
+
+/***********************************************************************
+**
+*/	void *Resolve_Start(const char *name, u32 ip)
+/*
+**		Starts lookup of the host name (or reverse lookup of the ip
+**		when the name is NULL). Returns the job for Resolve_Done or
+**		NULL when it cannot be started.
+**
+***********************************************************************/
+{
+	REBDNS *job;
+	REBDNC *entry;
+	int reverse = (name == NULL);
+
+	if (!reverse && strlen(name) >= MAX_HOST_NAME) return NULL;
+	if (!(job = OS_Make(sizeof(REBDNS)))) return NULL;
+	CLEARS(job);
+	job->ip = ip;
+	if (!reverse) strcpy(job->name, name);
+
+	if ((entry = Cached_Lookup(name, ip, reverse))) {
+		job->state = DNS_CACHED;
+		job->error = entry->error;
+		job->ip = entry->ip;
+		strcpy(job->name, entry->name);
+		return job;
+	}
+
+	if (!Dns_Lock) {
+		if (!(Dns_Lock = OS_Make_Lock())) goto fail;
+		if (pipe(Dns_Wake) < 0) {
+			Dns_Wake[0] = Dns_Wake[1] = -1;
+			goto fail;
+		}
+		fcntl(Dns_Wake[0], F_SETFL, O_NONBLOCK);
+		fcntl(Dns_Wake[1], F_SETFL, O_NONBLOCK);
+		fcntl(Dns_Wake[0], F_SETFD, FD_CLOEXEC);
+		fcntl(Dns_Wake[1], F_SETFD, FD_CLOEXEC);
+	}
+	if (Dns_Wake[0] < 0) goto fail;
+
+	OS_Lock(Dns_Lock);
+	job->state = DNS_QUEUED;
+	job->next = Dns_Queue;
+	Dns_Queue = job;
+	if (Dns_Idle == 0 && Dns_Threads < DNS_THREADS) {
+		if (OS_Create_Thread((CFUNC)Resolver_Thread, 0, 0) >= 0) Dns_Threads++;
+	}
+	if (Dns_Threads == 0) {
+		// No thread can run it:
+		Dns_Queue = job->next;
+		OS_Unlock(Dns_Lock);
+		goto fail;
+	}
+	OS_Signal_Lock(Dns_Lock);
+	OS_Unlock(Dns_Lock);
+
+	Dns_Active++;
+	Resolver_Rearm();
+	return job;
+
+fail:
+	OS_Free(job);
+	return NULL;
+}
+
+
+/***********************************************************************
+**
+*/	REBOOL Resolve_Done(void *handle, int *error, u32 *ip, char *name, int size)
+/*
+**		Returns FALSE while the job is pending. Else the job is freed,
+**		its result stored (the ip or the name) and its error code set
+**		(zero on success).
+**
+***********************************************************************/
+{
+	REBDNS *job = (REBDNS*)handle;
+
+	if (job->state != DNS_CACHED) {
+		Resolver_Rearm();
+		OS_Lock(Dns_Lock);
+		if (job->state == DNS_QUEUED) {
+			OS_Unlock(Dns_Lock);
+			return FALSE;
+		}
+		OS_Unlock(Dns_Lock);
+		Dns_Active--;
+		Resolver_Rearm();
+		Cache_Lookup(job, name != NULL); // only reverse lookups want a name
+	}
+	*error = job->error;
+	if (!job->error) {
+		if (ip) *ip = job->ip;
+		if (name) {
+			strncpy(name, job->name, size - 1);
+			name[size - 1] = 0;
+		}
+	}
+	OS_Free(job);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	static REBOOL Collect_DNS(REBREQ *sock)
+/*
+**		Stores result of the request's lookup and marks it as done.
+**		Returns FALSE while it is pending.
+**
+***********************************************************************/
+{
+	int error;
+
+	if (GET_FLAG(sock->modes, RST_REVERSE)) {
+		if (!Resolve_Done(sock->handle, &error, NULL, sock->net.host_info, MAXGETHOSTSTRUCT)) return FALSE;
+		if (!error) sock->data = sock->net.host_info;
+	}
+	else if (!Resolve_Done(sock->handle, &error, &sock->net.remote_ip, NULL, 0)) return FALSE;
+
+	sock->handle = 0;
+	sock->error = error;
+	SET_FLAG(sock->flags, RRF_DONE);
+	return TRUE;
+}
+
+
+/***********************************************************************
+**
+*/	void Resolve_Cancel(void *handle)
+/*
+**		Nobody waits for the job anymore.
+**
+***********************************************************************/
+{
+	REBDNS *job = (REBDNS*)handle;
+
+	if (job->state != DNS_CACHED) {
+		OS_Lock(Dns_Lock);
+		if (job->state == DNS_QUEUED) {
+			job->state = DNS_CANCELED; // freed by its thread
+			job = NULL;
+		}
+		OS_Unlock(Dns_Lock);
+		Dns_Active--;
+		Resolver_Rearm();
+	}
+	if (job) OS_Free(job);
+}
+
 #endif
 
 /***********************************************************************
@@ -78,6 +398,8 @@ extern HWND Event_Handle;
 		CLR_FLAG(sock->flags, RRF_PENDING);
 		if (sock->handle) WSACancelAsyncRequest(sock->handle);
 	}
+#else
+	if (sock->handle) Resolve_Cancel(sock->handle);
 #endif
 	if (sock->net.host_info) OS_Free(sock->net.host_info);
 	sock->net.host_info = 0;
@@ -99,8 +421,6 @@ extern HWND Event_Handle;
 	void *host;
 #ifdef HAS_ASYNC_DNS
 	HANDLE handle;
-#else
-	HOSTENT *he;
 #endif
 
 	host = OS_Make(MAXGETHOSTSTRUCT); // be sure to free it
@@ -130,17 +450,8 @@ extern HWND Event_Handle;
 		return DR_PEND; // keep it on pending list
 	}
 #else
-	// POSIX version
-	// Use old-style blocking DNS (mainly for testing purposes):
-	if (GET_FLAG(sock->modes, RST_REVERSE)) {
-		he = gethostbyaddr((char*)&sock->net.remote_ip, 4, AF_INET);
-		if (he) {
-			sock->cdata = cb_cast(he->h_name);
-			SET_FLAG(sock->flags, RRF_DONE);
-			return DR_DONE;
-		}
-	}
-	else if (sock->data == NULL) {
+	// POSIX version (lookups are done by resolver threads)
+	if (!GET_FLAG(sock->modes, RST_REVERSE) && sock->data == NULL) {
 		if(0 == gethostname(host, MAXGETHOSTSTRUCT)) {
 			sock->data = host;
 			SET_FLAG(sock->modes, RST_REVERSE);
@@ -149,12 +460,11 @@ extern HWND Event_Handle;
 		}
 	}
 	else {
-		he = gethostbyname(cs_cast(sock->data));
-		if (he) {
-			COPY_MEM((char*)&(sock->net.remote_ip), (char *)(*he->h_addr_list), 4); //he->h_length);
-			SET_FLAG(sock->flags, RRF_DONE);
-			return DR_DONE;
-		}
+		CLR_FLAG(sock->flags, RRF_DONE);
+		sock->handle = Resolve_Start(GET_FLAG(sock->modes, RST_REVERSE) ? NULL : cs_cast(sock->data), sock->net.remote_ip);
+		if (!sock->handle) goto error;
+		if (!Collect_DNS(sock)) return DR_PEND; // keep it on pending list
+		return DR_DONE; // from the cache (sock->error is set on failure)
 	}
 #endif
 error:
@@ -182,11 +492,16 @@ error:
 	REBREQ **prior = &dev->pending;
 	REBREQ *req;
 	REBOOL change = FALSE;
+#ifdef HAS_ASYNC_DNS
 	HOSTENT *host;
+#endif
 
 	// Scan the pending request list:
 	for (req = *prior; req; req = *prior) {
 
+#ifndef HAS_ASYNC_DNS
+		if (!GET_FLAG(req->flags, RRF_DONE) && req->handle) Collect_DNS(req);
+#endif
 		// If done or error, remove command from list:
 		if (GET_FLAG(req->flags, RRF_DONE)) { // req->error may be set
 			*prior = req->next;
@@ -194,11 +509,13 @@ error:
 			CLR_FLAG(req->flags, RRF_PENDING);
 
 			if (!req->error) { // success!
+#ifdef HAS_ASYNC_DNS
 				host = (HOSTENT*)req->net.host_info;
 				if (GET_FLAG(req->modes, RST_REVERSE))
 					req->data = (REBYTE*)host->h_name;
 				else
 					COPY_MEM((char*)&(req->net.remote_ip), (char *)(*host->h_addr_list), 4); //he->h_length);
+#endif
 				OS_Signal_Device(req, EVT_READ);
 			}
 			else
@@ -212,6 +529,29 @@ error:
 }
 
 
+/***********************************************************************
+**
+*/	DEVICE_CMD Modify_DNS(REBREQ *sock)
+/*
+**		Sets seconds for which lookup results are cached (zero to
+**		not cache them). The cache is cleared.
+**
+***********************************************************************/
+{
+#ifndef HAS_ASYNC_DNS
+	switch (sock->modify.mode) {
+	case RDM_DNS_TTL:          Dns_TTL = sock->modify.value; break;
+	case RDM_DNS_NEGATIVE_TTL: Dns_Negative_TTL = sock->modify.value; break;
+	default:
+		sock->error = -1;
+		return DR_ERROR;
+	}
+	CLEAR(Dns_Cache, sizeof(Dns_Cache));
+#endif
+	return DR_DONE;
+}
+
+
 /***********************************************************************
 **
 **	Command Dispatch Table (RDC_ enum order)
@@ -227,6 +567,9 @@ static DEVICE_CMD_FUNC Dev_Cmds[RDC_MAX] =
 	Read_DNS,
 	0,	// write
 	Poll_DNS,
+	0,	// connect
+	0,	// query
+	Modify_DNS,
 };
 
 DEFINE_DEV(Dev_DNS, "DNS", 1, Dev_Cmds, RDC_MAX, 0);
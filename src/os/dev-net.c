@@ -36,6 +36,10 @@
 **
 ***********************************************************************/
 
+#if defined(TO_LINUX) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE				// recvmmsg and sendmmsg
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -44,6 +48,17 @@
 #include "host-lib.h"
 #include "sys-net.h"
 
+#ifdef HAS_SENDFILE
+#ifdef TO_LINUX
+#include <sys/sendfile.h>
+#include <signal.h>
+#include <pthread.h>
+#else
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+#endif
+
 #if (0)
 #define WATCH1(s,a) printf(s, a)
 #define WATCH2(s,a,b) printf(s, a, b)
@@ -56,6 +71,13 @@
 
 DEVICE_CMD Listen_Socket(REBREQ *sock);
 
+#ifndef HAS_ASYNC_DNS
+// Resolver threads (see dev-dns.c):
+extern void  *Resolve_Start(const char *name, u32 ip);
+extern REBOOL Resolve_Done(void *handle, int *error, u32 *ip, char *name, int size);
+extern void   Resolve_Cancel(void *handle);
+#endif
+
 #ifdef TO_WINDOWS
 typedef int socklen_t;
 extern HWND Event_Handle; // For WSAAsync API
@@ -92,6 +114,208 @@ static void Get_Local_IP(REBREQ *sock)
 	sock->net.local_port = ntohs(sa.sin_port);
 }
 
+static long Send_File(REBREQ *sock, long len)
+{
+	// Send a part of the open file (RST_SENDFILE) without copying it
+	// to a series. Returns bytes sent or -1 (error is in GET_ERROR).
+	REBREQ *file = sock->net.file;
+	i64 index = sock->net.file_index + sock->actual;
+#if defined(HAS_SENDFILE) && defined(TO_LINUX)
+	// There is no MSG_NOSIGNAL for sendfile, so SIGPIPE is blocked
+	// and a pending one (from a closed connection) is consumed:
+	off_t offset = (off_t)index;
+	sigset_t pipe, old;
+	long result;
+	sigemptyset(&pipe);
+	sigaddset(&pipe, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &pipe, &old);
+	result = (long)sendfile(sock->socket, file->id, &offset, len);
+	if (result < 0 && errno == EPIPE) {
+		struct timespec zero = {0, 0};
+		sigtimedwait(&pipe, NULL, &zero);
+		errno = EPIPE;
+	}
+	pthread_sigmask(SIG_SETMASK, &old, NULL);
+	return result;
+#elif defined(HAS_SENDFILE) && defined(TO_MACOS)
+	off_t sent = len;
+	if (sendfile(file->id, sock->socket, (off_t)index, &sent, NULL, 0) < 0 && sent == 0) return -1;
+	return (long)sent;
+#elif defined(HAS_SENDFILE) && defined(TO_FREEBSD)
+	off_t sent = 0;
+	if (sendfile(file->id, sock->socket, (off_t)index, len, NULL, &sent, 0) < 0 && sent == 0) return -1;
+	return (long)sent;
+#else
+	// No sendfile, so the file is read in MAX_TRANSFER parts.
+	// Only sent bytes are counted, the rest is read again later.
+	char buf[MAX_TRANSFER];
+	int flags = 0;
+#ifdef TO_WINDOWS
+	DWORD got = 0;
+	OVERLAPPED ov;
+#endif
+	len = MIN(len, MAX_TRANSFER);
+#ifdef TO_WINDOWS
+	memset(&ov, 0, sizeof(ov));
+	ov.Offset = (DWORD)index;
+	ov.OffsetHigh = (DWORD)(index >> 32);
+	if (!ReadFile((HANDLE)file->handle, buf, (DWORD)len, &got, &ov)) {
+		WSASetLastError(GetLastError());
+		return -1;
+	}
+	len = (long)got;
+#else
+	len = (long)pread(file->id, buf, len, (off_t)index);
+	if (len < 0) return -1;
+#endif
+	if (len == 0) return 0;
+#ifdef MSG_NOSIGNAL
+	flags |= MSG_NOSIGNAL;
+#endif
+	return send(sock->socket, buf, len, flags);
+#endif
+}
+
+static long Send_Gather(REBREQ *sock, long len, int flags)
+{
+	// Send the parts of the REBIOV list (RST_GATHER) from the actual
+	// position by one call, so they do not have to be joined first.
+	// Returns bytes sent or -1 (error is in GET_ERROR).
+	REBIOV *part = (REBIOV*)sock->data;
+	u32 skip = sock->actual;
+	u32 size;
+#ifdef TO_WINDOWS
+	// Winsock 1 has no gather send, so just the current part is sent:
+	while (part->data && skip >= part->length) skip -= (part++)->length;
+	if (!part->data) return 0;
+	size = MIN(part->length - skip, (u32)len);
+	return send(sock->socket, (const char*)part->data + skip, size, flags);
+#else
+	struct iovec bufs[MAX_GATHER];
+	struct msghdr msg;
+	int n = 0;
+
+	while (part->data && skip >= part->length) skip -= (part++)->length;
+	for (; part->data && n < MAX_GATHER && len > 0; part++, skip = 0) {
+		size = MIN(part->length - skip, (u32)len);
+		if (size == 0) continue;
+		bufs[n].iov_base = (void*)(part->data + skip);
+		bufs[n].iov_len = size;
+		len -= size;
+		n++;
+	}
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = bufs;
+	msg.msg_iovlen = n;
+	return (long)sendmsg(sock->socket, &msg, flags);
+#endif
+}
+
+static void Grow_Transfer(REBREQ *sock, int mode)
+{
+	// A whole transfer was done at once, so the next one may be larger.
+	// The limit is doubled up to the size of the socket's buffer.
+	int size = 0;
+	socklen_t len = sizeof(size);
+
+	if (sock->net.transfer >= MAX_NET_TRANSFER) return;
+	if (getsockopt(sock->socket, SOL_SOCKET, mode == RSM_SEND ? SO_SNDBUF : SO_RCVBUF,
+			(char*)&size, &len) || (u32)size <= sock->net.transfer) return;
+	sock->net.transfer = MIN(sock->net.transfer * 2, MIN((u32)size, MAX_NET_TRANSFER));
+}
+
+static long Recv_Batch(REBREQ *sock)
+{
+	// Receive available datagrams into the REBDGM list (RST_BATCH).
+	// Returns count of them or -1 (error is in GET_ERROR).
+	REBDGM *dgm = (REBDGM*)sock->data;
+	u32 cnt = MIN(sock->length, MAX_NET_BATCH);
+	u32 n;
+#ifdef HAS_MMSG
+	struct mmsghdr msgs[MAX_NET_BATCH];
+	struct iovec bufs[MAX_NET_BATCH];
+	SOCKAI addrs[MAX_NET_BATCH];
+	int result;
+
+	memset(msgs, 0, cnt * sizeof(msgs[0]));
+	for (n = 0; n < cnt; n++) {
+		bufs[n].iov_base = dgm[n].data;
+		bufs[n].iov_len = dgm[n].length;
+		msgs[n].msg_hdr.msg_iov = &bufs[n];
+		msgs[n].msg_hdr.msg_iovlen = 1;
+		msgs[n].msg_hdr.msg_name = &addrs[n];
+		msgs[n].msg_hdr.msg_namelen = sizeof(addrs[n]);
+	}
+	result = recvmmsg(sock->socket, msgs, cnt, 0, NULL);
+	if (result < 0) return -1;
+	for (n = 0; n < (u32)result; n++) {
+		dgm[n].length = msgs[n].msg_len;
+		dgm[n].remote_ip = addrs[n].sin_addr.s_addr;
+		dgm[n].remote_port = ntohs(addrs[n].sin_port);
+	}
+	return result;
+#else
+	// One call per datagram, but still just one event for all of them:
+	SOCKAI addr;
+	socklen_t addr_len;
+	long result;
+
+	for (n = 0; n < cnt; n++) {
+		addr_len = sizeof(addr);
+		result = recvfrom(sock->socket, (char*)dgm[n].data, dgm[n].length, 0,
+						  (struct sockaddr*)&addr, &addr_len);
+		if (result < 0) {
+			if (n > 0) break; // the error is reported by a next READ
+			return -1;
+		}
+		dgm[n].length = (u32)result;
+		dgm[n].remote_ip = addr.sin_addr.s_addr;
+		dgm[n].remote_port = ntohs(addr.sin_port);
+	}
+	return n;
+#endif
+}
+
+static long Send_Batch(REBREQ *sock, int flags)
+{
+	// Send the REBDGM list (RST_BATCH) from the actual datagram.
+	// Returns count of sent datagrams or -1 (error is in GET_ERROR).
+	REBDGM *dgm = (REBDGM*)sock->data + sock->actual;
+	u32 cnt = MIN(sock->length - sock->actual, MAX_NET_BATCH);
+	u32 n;
+#ifdef HAS_MMSG
+	struct mmsghdr msgs[MAX_NET_BATCH];
+	struct iovec bufs[MAX_NET_BATCH];
+	SOCKAI addrs[MAX_NET_BATCH];
+
+	memset(msgs, 0, cnt * sizeof(msgs[0]));
+	for (n = 0; n < cnt; n++) {
+		Set_Addr(&addrs[n], dgm[n].remote_ip, dgm[n].remote_port);
+		bufs[n].iov_base = dgm[n].data;
+		bufs[n].iov_len = dgm[n].length;
+		msgs[n].msg_hdr.msg_iov = &bufs[n];
+		msgs[n].msg_hdr.msg_iovlen = 1;
+		msgs[n].msg_hdr.msg_name = &addrs[n];
+		msgs[n].msg_hdr.msg_namelen = sizeof(addrs[n]);
+	}
+	return (long)sendmmsg(sock->socket, msgs, cnt, flags);
+#else
+	SOCKAI addr;
+	long result;
+
+	for (n = 0; n < cnt; n++) {
+		Set_Addr(&addr, dgm[n].remote_ip, dgm[n].remote_port);
+		result = sendto(sock->socket, (const char*)dgm[n].data, dgm[n].length, flags,
+						(struct sockaddr*)&addr, sizeof(addr));
+		if (result < 0) {
+			if (n > 0) break; // the error is reported by a next call
+			return -1;
+		}
+	}
+	return n;
+#endif
+}
+
 static REBOOL Nonblocking_Mode(SOCKET sock)
 {
 	// Set non-blocking mode. Return TRUE if no error.
@@ -261,12 +485,16 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		if (sock->net.host_info) {  // indicates DNS phase active
 #ifdef HAS_ASYNC_DNS
 			if (sock->handle) WSACancelAsyncRequest(sock->handle);
-#endif
 			OS_Free(sock->net.host_info);
-			sock->net.host_info = NULL;
 			sock->socket = sock->length; // Restore TCP socket (see Lookup)
+#else
+			Resolve_Cancel(sock->net.host_info);
+#endif
+			sock->net.host_info = NULL;
 		}
 
+		Unwatch_Request(sock, sock->socket);
+
 		if (CLOSE_SOCKET(sock->socket)) {
 			sock->error = GET_ERROR;
 			OS_Signal_Device(sock, EVT_ERROR);
@@ -289,12 +517,17 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 **		Note we use the sock->handle for the DNS handle. During use,
 **		we store the TCP socket in the length field.
 **
+**		Without WSAAsync, the lookup is done by resolver threads
+**		and the net.host_info holds the job until it is collected.
+**
 ***********************************************************************/
 {
-#ifdef TO_WINDOWS
+#ifdef HAS_ASYNC_DNS
 	HANDLE handle;
-#endif
 	HOSTENT *host;
+#else
+	int error;
+#endif
 
 #ifdef HAS_ASYNC_DNS
 	// Check if we are polling for completion:
@@ -326,14 +559,21 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	}
 	OS_Free(host);
 #else
-	// Use old-style blocking DNS (mainly for testing purposes):
-	host = gethostbyname((const char*)sock->data);
-	sock->net.host_info = 0; // no allocated data
-
-	if (host) {
-		COPY_MEM((char*)&(sock->net.remote_ip), (char *)(*host->h_addr_list), 4); //he->h_length);
-		CLR_FLAG(sock->flags, RRF_DONE);
-		OS_Signal_Device(sock, EVT_LOOKUP);
+	// Make the lookup request (result may be cached), or check if we
+	// are polling for completion:
+	if (!sock->net.host_info)
+		sock->net.host_info = Resolve_Start((const char*)sock->data, 0);
+	if (sock->net.host_info) {
+		if (!Resolve_Done(sock->net.host_info, &error, &sock->net.remote_ip, NULL, 0))
+			return DR_PEND; // still waiting
+		sock->net.host_info = 0;
+		if (!error) {
+			CLR_FLAG(sock->flags, RRF_DONE);
+			OS_Signal_Device(sock, EVT_LOOKUP);
+			return DR_DONE;
+		}
+		sock->error = error;
+		OS_Signal_Device(sock, EVT_ERROR);
 		return DR_DONE;
 	}
 #endif
@@ -405,8 +645,9 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	case NE_WOULDBLOCK:
 	case NE_INPROGRESS:
 	case NE_ALREADY:
-		// Still trying:
+		// Still trying (socket becomes writable when connected):
 		SET_FLAG(sock->state, RSM_ATTEMPT);
+		Watch_Request(sock, sock->socket, RWS_WRITE);
 		return DR_PEND;
 
 	default:
@@ -460,10 +701,58 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 
 	SET_FLAG(sock->state, mode);
 
-	// Limit size of transfer:
-	len = MIN(sock->length - sock->actual, MAX_TRANSFER);
+	if (GET_FLAG(sock->modes, RST_BATCH)) {
+		// Batched UDP, so the length and actual are counts of datagrams:
+		len = 0;
+		if (mode == RSM_SEND) {
+			result = (sock->actual < sock->length) ? Send_Batch(sock, 0) : 0;
+			if (result >= 0) {
+				sock->actual += result;
+				if (sock->actual >= sock->length) {
+					OS_Signal_Device(sock, EVT_WROTE);
+					return DR_DONE;
+				}
+				SET_FLAG(sock->flags, RRF_ACTIVE); /* notify OS_WAIT of activity */
+				return DR_PEND;
+			}
+		}
+		else {
+			result = Recv_Batch(sock);
+			if (result >= 0) {
+				sock->actual = (u32)result;
+				OS_Signal_Device(sock, EVT_READ);
+				return DR_DONE;
+			}
+		}
+		goto check_error;
+	}
 
-	if (mode == RSM_SEND) {
+	// Limit size of transfer (TCP limit grows while whole transfers pass):
+	if (!sock->net.transfer || GET_FLAG(sock->modes, RST_UDP))
+		sock->net.transfer = MAX_TRANSFER;
+	len = MIN(sock->length - sock->actual, sock->net.transfer);
+
+	if (mode == RSM_SEND && GET_FLAG(sock->modes, RST_SENDFILE)) {
+		// Not limited, the kernel sends as much as the socket takes:
+		len = sock->length - sock->actual;
+		result = Send_File(sock, len);
+		if (result == 0 && len > 0) {
+			// The file is shorter than expected (truncated meanwhile):
+			sock->error = -19;
+			OS_Signal_Device(sock, EVT_ERROR);
+			return DR_ERROR;
+		}
+		if (result >= 0) {
+			sock->actual += result;
+			if (sock->actual >= sock->length) {
+				OS_Signal_Device(sock, EVT_WROTE);
+				return DR_DONE;
+			}
+			SET_FLAG(sock->flags, RRF_ACTIVE); /* notify OS_WAIT of activity */
+			return DR_PEND;
+		}
+	}
+	else if (mode == RSM_SEND) {
 		// If host is no longer connected:
 		int flags = 0;
 #ifdef MSG_NOSIGNAL
@@ -478,6 +767,9 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 			result = sendto(sock->socket, (const char*)sock->data, len, flags,
 				(struct sockaddr*)&remote_addr, addr_len);
 		}
+		else if (GET_FLAG(sock->modes, RST_GATHER)) {
+			result = Send_Gather(sock, len, flags);
+		}
 		else {
 			// Expects that the socket is already connected and
 			// there is no need to specify the remote address again
@@ -488,8 +780,10 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 		//WATCH2("send() len: %d actual: %d\n", len, result);
 
 		if (result >= 0) {
-			sock->data += result;
+			if (!GET_FLAG(sock->modes, RST_GATHER)) sock->data += result;
 			sock->actual += result;
+			if (result == len && len == (long)sock->net.transfer && !GET_FLAG(sock->modes, RST_UDP))
+				Grow_Transfer(sock, mode);
 			if (sock->actual >= sock->length) {
 				OS_Signal_Device(sock, EVT_WROTE);
 				return DR_DONE;
@@ -509,6 +803,8 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 				sock->net.remote_ip = remote_addr.sin_addr.s_addr;
 				sock->net.remote_port = ntohs(remote_addr.sin_port);
 			}
+			else if (result == len && len == (long)sock->net.transfer)
+				Grow_Transfer(sock, mode);
 			sock->actual = (u32)result;
 			OS_Signal_Device(sock, EVT_READ);
 			return DR_DONE;
@@ -523,10 +819,12 @@ static REBOOL Nonblocking_Mode(SOCKET sock)
 	}
 
 	// Check error code:
+check_error:
 	result = GET_ERROR;
 	//WATCH2("get error: %d %s\n", result, strerror(result));
 	if (result == NE_WOULDBLOCK) {
 		//printf("timeout: %d\n", sock->timeout);
+		Watch_Request(sock, sock->socket, mode == RSM_SEND ? RWS_WRITE : RWS_READ);
 		return DR_PEND; // still waiting
 	}
 	WATCH4("ERROR: recv(%d %x) len: %d error: %d\n", sock->socket, sock->data, len, result);
@@ -583,6 +881,10 @@ lserr:
 	Get_Local_IP(sock);
 	sock->command = RDC_CREATE;	// the command done on wakeup
 
+	// Wake when there is an inbound TCP connection:
+	if (GET_FLAG(sock->state, RSM_LISTEN))
+		Watch_Request(sock, sock->socket, RWS_READ);
+
 	return DR_PEND;
 }
 
@@ -616,7 +918,10 @@ lserr:
 
 	if (result == BAD_SOCKET) {
 		result = GET_ERROR;
-		if (result == NE_WOULDBLOCK) return DR_PEND;
+		if (result == NE_WOULDBLOCK) {
+			Watch_Request(sock, sock->socket, RWS_READ);
+			return DR_PEND;
+		}
 		sock->error = result;
 		OS_Signal_Device(sock, EVT_ERROR);
 		return DR_ERROR;
@@ -639,6 +944,7 @@ lserr:
 	news->socket = result;
 	news->net.remote_ip   = sa.sin_addr.s_addr; //htonl(ip); NOTE: REBOL stays in network byte order
 	news->net.remote_port = ntohs(sa.sin_port);
+	news->net.read_size   = sock->net.read_size; // as set for the listen port
 	Get_Local_IP(news);
 
 	Nonblocking_Mode(news->socket);
@@ -647,7 +953,8 @@ lserr:
 	OS_Signal_Device(sock, EVT_ACCEPT);
 
 	// Even though we signalled, we keep the listen pending to
-	// accept additional connections.
+	// accept additional connections (not waiting, as there may be
+	// more of them in the listen queue already).
 	return DR_PEND;
 }
 
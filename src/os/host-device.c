@@ -56,6 +56,17 @@
 #include "reb-host.h"
 #include "host-lib.h"
 
+#ifdef HAS_EPOLL
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#define MAX_READY_EVENTS 256	// events taken from the wait set at once
+
+static int Wait_Set = -1;		// epoll instance (created on first watch)
+static int Watch_Count = 0;		// number of registered descriptors
+#endif
+
 
 /***********************************************************************
 **
@@ -136,6 +147,13 @@ static int Poll_Default(REBDEV *dev)
 
 	for (req = *prior; req; req = *prior) {
 
+		// Requests waiting in the wait set are dispatched only when
+		// their descriptor is reported ready (see Wait_Requests):
+		if (GET_FLAG(req->flags, RRF_WAITING)) {
+			prior = &req->next;
+			continue;
+		}
+
 		// Call command again:
 		if (req->command < RDC_MAX) {
 			CLR_FLAG(req->flags, RRF_ACTIVE);
@@ -351,8 +369,9 @@ static int Poll_Default(REBDEV *dev)
 		return -1;
 	}
 
-	// Do the command:
+	// Do the command (a new command is not waiting for prior readiness):
 	req->command = command;
+	CLR_FLAG(req->flags, RRF_WAITING);
 	result = dev->commands[command](req);
 
 	// If request is pending, attach it to device for polling:
@@ -415,6 +434,120 @@ static int Poll_Default(REBDEV *dev)
 }
 
 
+/***********************************************************************
+**
+*/	int Watch_Request(REBREQ *req, int fd, int modes)
+/*
+**		Register (or re-arm) the request's descriptor in the wait set
+**		and mark the request as waiting. While waiting, the request is
+**		skipped by the device polling, so idle descriptors cost nothing
+**		per WAIT cycle. Unless RWS_LEVEL is used, the registration is
+**		one-shot and the driver re-arms it when it pends again.
+**
+**		RWS_LEVEL registrations only wake the WAIT and never mark the
+**		request as waiting (used for devices polled as a whole).
+**
+**		Returns TRUE if watched. On FALSE (no wait set support, or the
+**		descriptor cannot be watched) the request is polled as before.
+**
+***********************************************************************/
+{
+#ifdef HAS_EPOLL
+	struct epoll_event ev;
+	int op;
+
+	if (fd < 0) return FALSE;
+
+	if (Wait_Set < 0) {
+		Wait_Set = epoll_create1(EPOLL_CLOEXEC);
+		if (Wait_Set < 0) return FALSE;
+	}
+
+	CLEARS(&ev);
+	if (modes & RWS_READ)  ev.events |= EPOLLIN | EPOLLRDHUP;
+	if (modes & RWS_WRITE) ev.events |= EPOLLOUT;
+	if (!(modes & RWS_LEVEL)) ev.events |= EPOLLONESHOT;
+	ev.data.ptr = req;
+
+	op = GET_FLAG(req->flags, RRF_WATCHED) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+	if (epoll_ctl(Wait_Set, op, fd, &ev) < 0) {
+		// The descriptor may have been closed and reused meanwhile:
+		if (op == EPOLL_CTL_MOD && errno == ENOENT) op = EPOLL_CTL_ADD;
+		else if (op == EPOLL_CTL_ADD && errno == EEXIST) op = EPOLL_CTL_MOD;
+		else return FALSE; // for example EPERM for regular files
+		if (epoll_ctl(Wait_Set, op, fd, &ev) < 0) return FALSE;
+	}
+	if (op == EPOLL_CTL_ADD) {
+		if (!GET_FLAG(req->flags, RRF_WATCHED)) Watch_Count++;
+		SET_FLAG(req->flags, RRF_WATCHED);
+	}
+	if (!(modes & RWS_LEVEL)) SET_FLAG(req->flags, RRF_WAITING);
+	return TRUE;
+#else
+	return FALSE;
+#endif
+}
+
+
+/***********************************************************************
+**
+*/	void Unwatch_Request(REBREQ *req, int fd)
+/*
+**		Remove the request's descriptor from the wait set.
+**		Must be called before the descriptor is closed.
+**		If it is not in the wait set, then no harm done.
+**
+***********************************************************************/
+{
+#ifdef HAS_EPOLL
+	if (GET_FLAG(req->flags, RRF_WATCHED)) {
+		if (Wait_Set >= 0 && fd >= 0) epoll_ctl(Wait_Set, EPOLL_CTL_DEL, fd, NULL);
+		CLR_FLAG(req->flags, RRF_WATCHED);
+		Watch_Count--;
+	}
+#endif
+	CLR_FLAG(req->flags, RRF_WAITING);
+}
+
+
+/***********************************************************************
+**
+*/	int Wait_Requests(u32 millisec)
+/*
+**		Block until any watched descriptor is ready, or the timeout
+**		(in milliseconds) expires. Requests of ready descriptors are
+**		released from waiting, so the next OS_Poll_Devices dispatches
+**		only them.
+**
+**		Returns count of ready requests (0 on timeout or signal),
+**		-1 when nothing is watched (caller should sleep itself),
+**		or -2 when the wait failed (errno holds the reason).
+**
+***********************************************************************/
+{
+#ifdef HAS_EPOLL
+	struct epoll_event events[MAX_READY_EVENTS];
+	REBREQ *req;
+	int n, i;
+
+	if (Wait_Set < 0 || Watch_Count <= 0) return -1;
+
+	n = epoll_wait(Wait_Set, events, MAX_READY_EVENTS, (int)millisec);
+	if (n < 0) {
+		if (errno == EINTR) return 0; // Ctrl-C interrupts a timer on a WAIT
+		return -2; // caller reports it as a device error
+	}
+	for (i = 0; i < n; i++) {
+		req = (REBREQ*)events[i].data.ptr;
+		if (req) CLR_FLAG(req->flags, RRF_WAITING);
+	}
+	return n;
+#else
+	return -1;
+#endif
+}
+
+
 /***********************************************************************
 **
 */	OS_API int OS_Poll_Devices(void)
@@ -482,6 +615,14 @@ static int Poll_Default(REBDEV *dev)
 		}
 	}
 
+#ifdef HAS_EPOLL
+	if (Wait_Set >= 0) {
+		close(Wait_Set);
+		Wait_Set = -1;
+		Watch_Count = 0;
+	}
+#endif
+
 	return 0;
 }
 
@@ -491,8 +632,9 @@ static int Poll_Default(REBDEV *dev)
 */	OS_API REBINT OS_Wait(REBCNT millisec, REBCNT res)
 /*
 **		Check if devices need attention, and if not, then wait.
-**		The wait can be interrupted by a GUI event, otherwise
-**		the timeout will wake it.
+**		The wait can be interrupted by a GUI event or by a ready
+**		descriptor from the wait set, otherwise the timeout will
+**		wake it.
 **
 **		Res specifies resolution. (No wait if less than this.)
 **
@@ -109,14 +109,25 @@ void Done_Device(int handle, int error);
 **		req->length. The latter is used by WAIT as the main timing
 **		method.
 **
+**		When there are requests in the host wait set, the wait ends
+**		as soon as any of their descriptors is ready.
+**
 ***********************************************************************/
 {
 	struct timeval tv = {0,0};
+	int n;
 
 #ifdef REB_VIEW
 	//TODO: process GUI events!!!
 #endif
 
+	n = Wait_Requests(req->length);
+	if (n >= 0) return DR_DONE;
+	if (n == -2) {
+		req->error = errno; // report the error code
+		return DR_ERROR;
+	}
+
 	tv.tv_usec = req->length * 1000; // converts ms to us
 	if (select(0, 0, 0, 0, &tv) < 0) {
 		if (errno == EINTR) return DR_DONE; // Ctrl-C interrupts a timer on a WAIT
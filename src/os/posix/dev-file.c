@@ -47,6 +47,11 @@
 #include <dirent.h>
 #include <errno.h>
 #include <glob.h>
+#include <sys/mman.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
 
 #include "reb-host.h"
 #include "host-lib.h"
@@ -541,6 +546,54 @@ static size_t get_virtual_file_size(const char *filepath) {
 	}
 	return size;
 }
+/***********************************************************************
+**
+*/	static int Map_File(REBREQ *file)
+/*
+**		Map file->length bytes from the file index into memory
+**		(copy on write, so the file is never modified).
+**		The data is followed by a zero byte used as a series
+**		terminator, so it is first placed over an anonymous mapping
+**		that is one byte longer (for data at the end of the file).
+**		Otherwise the byte after the data is from the file and it is
+**		cleared (in the private copy).
+**		Release it using OS_Unmap_File with file->length + 1.
+**
+***********************************************************************/
+{
+	long page = sysconf(_SC_PAGESIZE);
+	i64 index = file->file.index;
+	size_t bias = (size_t)(index % page);
+	size_t size = bias + file->length;
+	REBYTE *base;
+
+	// Only whole regular files; reading past the end of a mapped file
+	// would crash instead of returning less data:
+	if (file->length == 0 || index < 0 || index + file->length > file->file.size) {
+		file->error = -RFE_NO_MMAP;
+		return DR_ERROR;
+	}
+
+	base = mmap(NULL, size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED) {
+		file->error = -RFE_NO_MMAP;
+		return DR_ERROR;
+	}
+	if (mmap(base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file->id, index - bias) == MAP_FAILED) {
+		munmap(base, size + 1);
+		file->error = -RFE_NO_MMAP;
+		return DR_ERROR;
+	}
+	base[size] = 0; // terminator (not at EOF with /part or /seek)
+
+	file->data = base + bias;
+	file->actual = file->length;
+	file->file.index += file->actual;
+	lseek(file->id, file->file.index, SEEK_SET);
+	return DR_DONE;
+}
+
+
 /***********************************************************************
 **
 */	DEVICE_CMD Read_File(REBREQ *file)
@@ -571,6 +624,8 @@ init_pattern:
 		if (!Seek_File_64(file)) return DR_ERROR;
 	}
 
+	if (GET_FLAG(file->modes, RFM_MMAP)) return Map_File(file);
+
 	// virtual files on Posix report its size as 0, so try to resolve the real one
 	// but only in case, when user did not set /part
 	if (file->file.size == 0 && file->length == 0) {
@@ -222,6 +222,7 @@ static REBOOL Set_Serial_Settings(int ttyfd, REBREQ *req)
 ***********************************************************************/
 {
 	if (req->id) {
+		Unwatch_Request(req, req->id);
 		//Warning: should free req->serial.prior_attr termios struct?
 		tcsetattr(req->id, TCSANOW, req->serial.prior_attr);
 		close(req->id);
@@ -248,10 +249,15 @@ static REBOOL Set_Serial_Settings(int ttyfd, REBREQ *req)
 	printf("read %d ret: %d\n", req->length, result);
 #endif
 	if (result < 0) {
+		if (errno == EAGAIN) {
+			Watch_Request(req, req->id, RWS_READ);
+			return DR_PEND;
+		}
 		req->error = -RFE_BAD_READ;
 		OS_Signal_Device(req, EVT_ERROR);
 		return DR_ERROR;
 	} else if (result == 0) {
+		Watch_Request(req, req->id, RWS_READ);
 		return DR_PEND;
 	} else {
 		req->actual = result;
@@ -283,6 +289,7 @@ static REBOOL Set_Serial_Settings(int ttyfd, REBREQ *req)
 #endif
 	if (result < 0) {
 		if (errno == EAGAIN) {
+			Watch_Request(req, req->id, RWS_WRITE);
 			return DR_PEND;
 		}
 		req->error = -RFE_BAD_WRITE;
@@ -84,6 +84,7 @@ extern void Close_StdIO(void);
 static struct termios settings_original;
 static struct termios settings_raw;
 struct pollfd poller;
+static REBREQ Stdin_Watch;	// wait set token used while auto polling
 
 //#define DEBUG_STDIO
 #ifdef DEBUG_STDIO
@@ -858,6 +859,9 @@ static int Read_Key_Event(REBEVT *evt) {
 			// Turn autopolling on when not in the line mode (required for async key reading).
 			ASSIGN_FLAG(req->modes, RRF_PENDING, !value);
 			ASSIGN_FLAG(dev->flags, RDO_AUTO_POLL, !value);
+			// and let a key press end the WAIT immediately:
+			if (value) Unwatch_Request(&Stdin_Watch, Std_Inp);
+			else Watch_Request(&Stdin_Watch, Std_Inp, RWS_READ | RWS_LEVEL);
 			break;
 		case MODE_CONSOLE_ERROR:
 			Std_Out = value ? STDERR_FILENO : STDOUT_FILENO;
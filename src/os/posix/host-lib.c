@@ -59,10 +59,12 @@
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <time.h>
 #include <string.h>
 #include <errno.h>
 #include <signal.h>  //for kill
+#include <pthread.h>
 
 #ifndef timeval // for older systems
 #include <sys/time.h>
@@ -75,8 +77,19 @@
 #include <dlfcn.h>
 #endif
 
-// Semaphore lock to sync sub-task launch:
-static void *Task_Ready;
+// Used to sync sub-task launch:
+static pthread_mutex_t Task_Launch = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  Task_Ready  = PTHREAD_COND_INITIALIZER;
+static int Task_Started;
+
+// Called on each tick of the sampling timer (see OS_Start_Sampler):
+static CFUNC Sampler_Tick;
+
+// Lock with a condition (see OS_Make_Lock):
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t  cond;
+} REBLCK;
 
 #ifndef PATH_MAX
 #define PATH_MAX 4096  // generally lacking in Posix
@@ -731,6 +744,22 @@ RL_LIB *RL; // Link back to reb-lib from embedded extensions (like for now: host
 }
 
 
+/***********************************************************************
+**
+*/	OS_API void OS_Unmap_File(void *data, REBCNT size)
+/*
+**		Release file data mapped by the file device (read/mmap).
+**		Size is the mapped length including the terminator.
+**
+***********************************************************************/
+{
+	long page = sysconf(_SC_PAGESIZE);
+	size_t bias = (size_t)((REBUPT)data % page);
+
+	munmap((REBYTE*)data - bias, bias + size);
+}
+
+
 /***********************************************************************
 **
 */	OS_API void *OS_Open_Library(REBCHR *path, REBCNT *error)
@@ -783,31 +812,65 @@ RL_LIB *RL; // Link back to reb-lib from embedded extensions (like for now: host
 }
 
 
+/***********************************************************************
+**
+*/	static void *Start_Thread(void *arg)
+/*
+**		Thread entry used by OS_Create_Thread.
+**
+***********************************************************************/
+{
+	CFUNC init = ((CFUNC *)arg)[0];
+	void *data = ((void **)arg)[1];
+
+	OS_Free(arg);
+	init(data);
+	return NULL;
+}
+
+
 /***********************************************************************
 **
 */	OS_API REBINT OS_Create_Thread(CFUNC init, void *arg, REBCNT stack_size)
 /*
 **		Creates a new thread for a REBOL task datatype.
 **
-**	NOTE:
-**		For this to work, the multithreaded library option is
-**		needed in the C/C++ code generation settings.
-**
 **		The Task_Ready stops return until the new task has been
 **		initialized (to avoid unknown new thread state).
 **
 ***********************************************************************/
 {
-/*
-	REBINT thread;
-	Task_Ready = CreateEvent(NULL, TRUE, FALSE, "REBOL_Task_Launch");
-	if (!Task_Ready) return -1;
-
-	thread = _beginthread(init, stack_size, arg);
+	pthread_t thread;
+	pthread_attr_t attr;
+	void **start;
+	struct timespec ts;
+	int err;
+
+	start = OS_Make(2 * sizeof(void *));
+	if (!start) return -1;
+	((CFUNC *)start)[0] = init;
+	start[1] = arg;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	if (stack_size) pthread_attr_setstacksize(&attr, stack_size);
+
+	pthread_mutex_lock(&Task_Launch);
+	Task_Started = 0;
+	err = pthread_create(&thread, &attr, Start_Thread, start);
+	pthread_attr_destroy(&attr);
+	if (err) {
+		pthread_mutex_unlock(&Task_Launch);
+		OS_Free(start);
+		return -1;
+	}
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec += 2;
+	while (!Task_Started) {
+		if (pthread_cond_timedwait(&Task_Ready, &Task_Launch, &ts) == ETIMEDOUT) break;
+	}
+	pthread_mutex_unlock(&Task_Launch);
 
-	if (thread) WaitForSingleObject(Task_Ready, 2000);
-	CloseHandle(Task_Ready);
-*/
 	return 1;
 }
 
@@ -820,7 +883,7 @@ RL_LIB *RL; // Link back to reb-lib from embedded extensions (like for now: host
 **
 ***********************************************************************/
 {
-	//_endthread();
+	pthread_exit(NULL);
 }
 
 
@@ -833,7 +896,166 @@ RL_LIB *RL; // Link back to reb-lib from embedded extensions (like for now: host
 **
 ***********************************************************************/
 {
-	//SetEvent(Task_Ready);
+	pthread_mutex_lock(&Task_Launch);
+	Task_Started = 1;
+	pthread_cond_signal(&Task_Ready);
+	pthread_mutex_unlock(&Task_Launch);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void *OS_Make_Lock(void)
+/*
+**		Allocate a lock (mutex) to guard data shared by tasks.
+**		The lock has also a condition used by OS_Wait_Lock.
+**		Returns zero on failure.
+**
+***********************************************************************/
+{
+	REBLCK *lock = OS_Make(sizeof(REBLCK));
+	if (!lock) return 0;
+	if (pthread_mutex_init(&lock->mutex, NULL)) {
+		OS_Free(lock);
+		return 0;
+	}
+	if (pthread_cond_init(&lock->cond, NULL)) {
+		pthread_mutex_destroy(&lock->mutex);
+		OS_Free(lock);
+		return 0;
+	}
+	return lock;
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Free_Lock(void *lock)
+/*
+***********************************************************************/
+{
+	if (!lock) return;
+	pthread_cond_destroy(&((REBLCK *)lock)->cond);
+	pthread_mutex_destroy(&((REBLCK *)lock)->mutex);
+	OS_Free(lock);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Lock(void *lock)
+/*
+**		Wait until the lock is owned by the calling thread.
+**
+***********************************************************************/
+{
+	if (lock) pthread_mutex_lock(&((REBLCK *)lock)->mutex);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Unlock(void *lock)
+/*
+***********************************************************************/
+{
+	if (lock) pthread_mutex_unlock(&((REBLCK *)lock)->mutex);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API REBOOL OS_Wait_Lock(void *lock, REBINT msec)
+/*
+**		Release the owned lock and wait until it is signaled
+**		(or until msec elapses, when not negative). The lock is
+**		owned again on return. Returns FALSE on timeout.
+**		Callers must check their condition again after the wait.
+**
+***********************************************************************/
+{
+	REBLCK *lck = (REBLCK *)lock;
+	struct timespec ts;
+
+	if (!lock) return FALSE;
+	if (msec < 0) return !pthread_cond_wait(&lck->cond, &lck->mutex);
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec  += msec / 1000;
+	ts.tv_nsec += (msec % 1000) * 1000000;
+	if (ts.tv_nsec >= 1000000000) {
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000;
+	}
+	return pthread_cond_timedwait(&lck->cond, &lck->mutex, &ts) != ETIMEDOUT;
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Signal_Lock(void *lock)
+/*
+**		Wake up all threads waiting in OS_Wait_Lock.
+**
+***********************************************************************/
+{
+	if (lock) pthread_cond_broadcast(&((REBLCK *)lock)->cond);
+}
+
+
+/***********************************************************************
+**
+*/	static void Handle_Sampler(int sig)
+/*
+**		SIGPROF handler. Stays installed after the timer is stopped,
+**		because the default action of a late signal is to terminate.
+**
+***********************************************************************/
+{
+	CFUNC tick = Sampler_Tick;
+	if (tick) tick(0);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API REBOOL OS_Start_Sampler(CFUNC tick, REBINT msec)
+/*
+**		Call tick every msec of CPU time used by the process.
+**		It is called from a signal handler, so it may only set
+**		a flag. Returns FALSE if the timer cannot be started.
+**
+***********************************************************************/
+{
+	struct sigaction sa;
+	struct itimerval it;
+
+	Sampler_Tick = tick;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = Handle_Sampler;
+	sa.sa_flags = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	if (sigaction(SIGPROF, &sa, NULL)) return FALSE;
+
+	it.it_interval.tv_sec  = msec / 1000;
+	it.it_interval.tv_usec = (msec % 1000) * 1000;
+	it.it_value = it.it_interval;
+	return !setitimer(ITIMER_PROF, &it, NULL);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Stop_Sampler(void)
+/*
+***********************************************************************/
+{
+	struct itimerval it;
+
+	memset(&it, 0, sizeof(it));
+	setitimer(ITIMER_PROF, &it, NULL);
+	Sampler_Tick = 0;
 }
 
 //Helper function for OS_Create_Process:
@@ -321,6 +321,60 @@ fail:
 }
 
 
+/***********************************************************************
+**
+*/	static int Map_File(REBREQ *file)
+/*
+**		Map file->length bytes from the file index into memory
+**		(copy on write, so the file is never modified).
+**		The byte after the data is cleared and used as a series
+**		terminator, so data ending exactly at a page boundary is
+**		not mapped.
+**		Release it using OS_Unmap_File.
+**
+***********************************************************************/
+{
+	SYSTEM_INFO info;
+	HANDLE map;
+	REBYTE *base;
+	i64 index = file->file.index;
+	i64 offset;
+	SIZE_T size;
+
+	GetSystemInfo(&info);
+	offset = index - (index % info.dwAllocationGranularity);
+	size = (SIZE_T)(index - offset) + file->length;
+
+	if (
+		file->length == 0 || index < 0
+		|| index + file->length > file->file.size
+		|| (size % info.dwPageSize) == 0 // no room for the terminator
+	) {
+		file->error = -RFE_NO_MMAP;
+		return DR_ERROR;
+	}
+
+	map = CreateFileMapping(file->handle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	if (!map) {
+		file->error = -RFE_NO_MMAP;
+		return DR_ERROR;
+	}
+	base = MapViewOfFile(map, FILE_MAP_COPY, (DWORD)(offset >> 32), (DWORD)offset, size);
+	CloseHandle(map); // the view keeps the mapping alive
+	if (!base) {
+		file->error = -RFE_NO_MMAP;
+		return DR_ERROR;
+	}
+
+	base[size] = 0; // terminator (copy on write, the file is not modified)
+	file->data = base + (index - offset);
+	file->actual = file->length;
+	file->file.index += file->actual;
+	Seek_File_64(file);
+	return DR_DONE;
+}
+
+
 /***********************************************************************
 **
 */	DEVICE_CMD Read_File(REBREQ *file)
@@ -344,6 +398,8 @@ fail:
 		if (!Seek_File_64(file)) return DR_ERROR;
 	}
 
+	if (GET_FLAG(file->modes, RFM_MMAP)) return Map_File(file);
+
 	if (!ReadFile(file->handle, file->data, file->length, (LPDWORD)&file->actual, 0)) {
 		file->error = -RFE_BAD_READ;
 		return DR_ERROR;
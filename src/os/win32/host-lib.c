@@ -74,6 +74,17 @@ RL_LIB *RL; // Link back to reb-lib from embedded extensions (like for now: host
 
 // Semaphore lock to sync sub-task launch:
 static void *Task_Ready;
+
+// Sampling timer (see OS_Start_Sampler):
+static HANDLE Sampler_Timer;
+static CFUNC  Sampler_Tick;
+
+// Lock with a condition (see OS_Make_Lock):
+typedef struct {
+	CRITICAL_SECTION   section;
+	CONDITION_VARIABLE cond;
+} REBLCK;
+
 static void *Temp_Buffer;
 static size_t Temp_Buffer_Size = 0;
 
@@ -745,6 +756,22 @@ X*/	REBOOL As_OS_Str(REBSER *series, REBCHR **string)
 }
 
 
+/***********************************************************************
+**
+*/	OS_API void OS_Unmap_File(void *data, REBCNT size)
+/*
+**		Release file data mapped by the file device (read/mmap).
+**		Size is the mapped length including the terminator.
+**
+***********************************************************************/
+{
+	SYSTEM_INFO info;
+
+	GetSystemInfo(&info);
+	UnmapViewOfFile((REBYTE*)data - ((REBUPT)data % info.dwAllocationGranularity));
+}
+
+
 /***********************************************************************
 **
 */	OS_API void *OS_Open_Library(REBCHR *path, REBCNT *error)
@@ -810,10 +837,10 @@ X*/	REBOOL As_OS_Str(REBSER *series, REBCHR **string)
 
 	thread = _beginthread(init, stack_size, arg);
 
-	if (thread) WaitForSingleObject(Task_Ready, 2000);
+	if (thread != -1) WaitForSingleObject(Task_Ready, 2000);
 	CloseHandle(Task_Ready);
 
-	return 1;
+	return (thread != -1) ? 1 : -1;
 }
 
 
@@ -842,6 +869,135 @@ X*/	REBOOL As_OS_Str(REBSER *series, REBCHR **string)
 }
 
 
+/***********************************************************************
+**
+*/	OS_API void *OS_Make_Lock(void)
+/*
+**		Allocate a lock (critical section) to guard data shared
+**		by tasks. The lock has also a condition used by
+**		OS_Wait_Lock. Returns zero on failure.
+**
+***********************************************************************/
+{
+	REBLCK *lock = OS_Make(sizeof(REBLCK));
+	if (lock) {
+		InitializeCriticalSection(&lock->section);
+		InitializeConditionVariable(&lock->cond);
+	}
+	return lock;
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Free_Lock(void *lock)
+/*
+***********************************************************************/
+{
+	if (!lock) return;
+	DeleteCriticalSection(&((REBLCK *)lock)->section);
+	OS_Free(lock);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Lock(void *lock)
+/*
+**		Wait until the lock is owned by the calling thread.
+**
+***********************************************************************/
+{
+	if (lock) EnterCriticalSection(&((REBLCK *)lock)->section);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Unlock(void *lock)
+/*
+***********************************************************************/
+{
+	if (lock) LeaveCriticalSection(&((REBLCK *)lock)->section);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API REBOOL OS_Wait_Lock(void *lock, REBINT msec)
+/*
+**		Release the owned lock and wait until it is signaled
+**		(or until msec elapses, when not negative). The lock is
+**		owned again on return. Returns FALSE on timeout.
+**		Callers must check their condition again after the wait.
+**
+***********************************************************************/
+{
+	REBLCK *lck = (REBLCK *)lock;
+
+	if (!lock) return FALSE;
+	return SleepConditionVariableCS(&lck->cond, &lck->section, (msec < 0) ? INFINITE : (DWORD)msec) != 0;
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Signal_Lock(void *lock)
+/*
+**		Wake up all threads waiting in OS_Wait_Lock.
+**
+***********************************************************************/
+{
+	if (lock) WakeAllConditionVariable(&((REBLCK *)lock)->cond);
+}
+
+
+/***********************************************************************
+**
+*/	static VOID CALLBACK Sampler_Callback(PVOID arg, BOOLEAN fired)
+/*
+***********************************************************************/
+{
+	CFUNC tick = Sampler_Tick;
+	if (tick) tick(arg);
+}
+
+
+/***********************************************************************
+**
+*/	OS_API REBOOL OS_Start_Sampler(CFUNC tick, REBINT msec)
+/*
+**		Call tick every msec (from the timer queue thread), so it
+**		may only set a flag. Returns FALSE if the timer cannot
+**		be started.
+**
+***********************************************************************/
+{
+	OS_Stop_Sampler();
+	Sampler_Tick = tick;
+	if (CreateTimerQueueTimer(&Sampler_Timer, NULL, Sampler_Callback, NULL, msec, msec, WT_EXECUTEINTIMERTHREAD))
+		return TRUE;
+	Sampler_Timer = 0;
+	Sampler_Tick = 0;
+	return FALSE;
+}
+
+
+/***********************************************************************
+**
+*/	OS_API void OS_Stop_Sampler(void)
+/*
+***********************************************************************/
+{
+	if (Sampler_Timer) {
+		// Waits for a running callback to finish:
+		DeleteTimerQueueTimer(NULL, Sampler_Timer, INVALID_HANDLE_VALUE);
+		Sampler_Timer = 0;
+	}
+	Sampler_Tick = 0;
+}
+
+
 /***********************************************************************
 **
 */	OS_API int OS_Create_Process(REBCHR *call, int argc, REBCHR* argv[], u32 flags, u64 *pid, int *exit_code, u32 input_type, void *input, u32 input_len, u32 output_type, void **output, u32 *output_len, u32 err_type, void **err, u32 *err_len)